@@ -405,6 +405,11 @@ class BatteryUnitBlock : public UnitBlock
 
  void deserialize( const netCDF::NcGroup & group ) override;
 
+/*--------------------------------------------------------------------------*/
+ /// returns a copy of the BatteryUnitBlock, see UnitBlock::clone()
+
+ UnitBlock * clone( Block * father = nullptr ) const override;
+
 /*--------------------------------------------------------------------------*/
  /// generate the abstract variables of the BatteryUnitBlock
  /** This function generates the static variables of The BatteryUnitBlock,
@@ -1102,6 +1107,45 @@ class BatteryUnitBlock : public UnitBlock
   return( conv_design );
  }
 
+/*--------------------------------------------------------------------------*/
+ /// returns the number of design variables
+ /** There is one design variable for the battery if f_BattInvestmentCost
+  * != 0 and one for the converter if f_ConvInvestmentCost != 0; if both
+  * exist, the battery one comes first. */
+
+ Index get_number_design_variables( void ) const override {
+  return( ( f_BattInvestmentCost != 0 ? 1 : 0 ) +
+          ( f_ConvInvestmentCost != 0 ? 1 : 0 ) );
+ }
+
+/*--------------------------------------------------------------------------*/
+ /// returns the i-th design variable, if any
+
+ ColVariable * get_design_variable( Index i = 0 ) override {
+  if( f_BattInvestmentCost != 0 ) {
+   if( i == 0 )
+    return( & batt_design );
+   --i;
+  }
+  if( ( i == 0 ) && ( f_ConvInvestmentCost != 0 ) )
+   return( & conv_design );
+  return( nullptr );
+ }
+
+/*--------------------------------------------------------------------------*/
+ /// returns the number of storages: the battery has one
+
+ Index get_number_storages( void ) const override { return( 1 ); }
+
+/*--------------------------------------------------------------------------*/
+ /// returns the storage level variables, if any
+
+ ColVariable * get_storage( Index i = 0 ) override {
+  if( ( i > 0 ) || v_storage_level.empty() )
+   return( nullptr );
+  return( v_storage_level.data() );
+ }
+
 /*--------------------------------------------------------------------------*/
  /// returns the intake/outtake binary variables
 
@@ -1110,6 +1154,20 @@ class BatteryUnitBlock : public UnitBlock
   return( v_battery_binary );
   }
 
+/*--------------------------------------------------------------------------*/
+ /// returns the bounds on the active power
+ /** When no reserve variable enters the minimum and maximum power output
+  * constraints (no reserve demand in the UCBlock, or no reserve produced by
+  * the battery), they only involve the active power, and they are
+  * generated as one BoxConstraint per time instant, returned by this
+  * method, rather than as two rows; get_min_power_constraints() and
+  * get_max_power_constraints() then return nullptr. The vector is empty
+  * otherwise, as well as in the design case. */
+
+ const std::vector< BoxConstraint > & get_active_power_bounds( void ) const {
+  return( active_power_box_Const );
+ }
+
 /*--------------------------------------------------------------------------*/
  /// returns the minimum power output constraints
 
@@ -1264,6 +1322,9 @@ class BatteryUnitBlock : public UnitBlock
 
  void serialize( netCDF::NcGroup & group ) const override;
 
+ /// returns the memory held by the BatteryUnitBlock, see UnitBlock
+ MemoryUsage get_memory_usage( void ) const override;
+
 /** @} ---------------------------------------------------------------------*/
 /*--------------- METHODS FOR INITIALIZING THE BatteryUnitBlock ------------*/
 /*--------------------------------------------------------------------------*/
@@ -1535,6 +1596,9 @@ class BatteryUnitBlock : public UnitBlock
  /// the active power bounds constraints
  boost::multi_array< FRowConstraint , 2 > active_power_bounds_Const;
 
+ /// the active power bounds, when no reserve variable enters them
+ std::vector< BoxConstraint > active_power_box_Const;
+
  /// the active power bounds design constraints
  boost::multi_array< FRowConstraint , 2 > active_power_bounds_design_Const;
 
@@ -1591,7 +1655,13 @@ class BatteryUnitBlock : public UnitBlock
 /*-------------------- PRIVATE FIELDS OF THE CLASS -------------------------*/
 /*--------------------------------------------------------------------------*/
 
+ /// position of batt_design in active_power_bounds_design_Const[ i ][ t ]
+ /** The position of batt_design in the LinearFunction of each of the
+  * active_power_bounds_design_Const depends on which reserve variables
+  * are there, and it is recorded at generation time so that
+  * update_kappa_in_cnstrs() need not look for it. */
 
+ Index f_design_pos_active_power{};
 
  SMSpp_insert_in_factory_h;
 
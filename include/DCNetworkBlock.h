@@ -220,6 +220,14 @@ class DCNetworkBlock : public NetworkBlock
 
   virtual void deserialize( const netCDF::NcGroup & group ) override;
 
+/*--------------------------------------------------------------------------*/
+
+  /// returns a copy of the DCNetworkData, see NetworkData::clone()
+
+  NetworkData * clone( void ) const override {
+   return( new DCNetworkData( *this ) );
+  }
+
 /**@} ----------------------------------------------------------------------*/
 /*------------ METHODS FOR READING THE DATA OF THE DCNetworkData -----------*/
 /*--------------------------------------------------------------------------*/
@@ -410,6 +418,9 @@ class DCNetworkBlock : public NetworkBlock
 
   virtual void serialize( netCDF::NcGroup & group ) const override;
 
+  /// returns the memory held by the DCNetworkData, see NetworkData
+  MemoryUsage get_memory_usage( void ) const override;
+
 /*--------------------------------------------------------------------------*/
 /*--------------------- PROTECTED PART OF THE CLASS ------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -982,6 +993,11 @@ class DCNetworkBlock : public NetworkBlock
 
  void deserialize( const netCDF::NcGroup & group ) override;
 
+/*--------------------------------------------------------------------------*/
+ /// returns a copy of the DCNetworkBlock, see NetworkBlock::clone()
+
+ NetworkBlock * clone( Block * father = nullptr ) const override;
+
 /*--------------------------------------------------------------------------*/
  /// loads the DCNetworkBlock instance from memory
  /** Like load( std::istream & ), if there is any Solver attached to this
@@ -1004,6 +1020,9 @@ class DCNetworkBlock : public NetworkBlock
 
  void serialize( netCDF::NcGroup & group ) const override;
 
+ /// returns the memory held by the DCNetworkBlock, see NetworkBlock
+ MemoryUsage get_memory_usage( void ) const override;
+
 /** @} ---------------------------------------------------------------------*/
 /*------------------------ METHODS FOR CHANGING DATA -----------------------*/
 /*--------------------------------------------------------------------------*/
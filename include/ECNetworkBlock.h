@@ -151,6 +151,14 @@ class ECNetworkBlock : public NetworkBlock
 
   virtual void deserialize( const netCDF::NcGroup & group ) override;
 
+/*--------------------------------------------------------------------------*/
+
+  /// returns a copy of the ECNetworkData, see NetworkData::clone()
+
+  NetworkData * clone( void ) const override {
+   return( new ECNetworkData( *this ) );
+  }
+
 /**@} ----------------------------------------------------------------------*/
 /*------------ METHODS FOR READING THE DATA OF THE ECNetworkData -----------*/
 /*--------------------------------------------------------------------------*/
@@ -693,6 +701,11 @@ class ECNetworkBlock : public NetworkBlock
 
  void deserialize( const netCDF::NcGroup & group ) override;
 
+/*--------------------------------------------------------------------------*/
+ /// returns a copy of the ECNetworkBlock, see NetworkBlock::clone()
+
+ NetworkBlock * clone( Block * father = nullptr ) const override;
+
 /*--------------------------------------------------------------------------*/
  /// loads the ECNetworkBlock instance from an input standard stream.
  /** Like load( std::istream & ), if there is any Solver attached to this
@@ -715,6 +728,9 @@ class ECNetworkBlock : public NetworkBlock
 
  void serialize( netCDF::NcGroup & group ) const override;
 
+ /// returns the memory held by the ECNetworkBlock, see NetworkBlock
+ MemoryUsage get_memory_usage( void ) const override;
+
 /** @} ---------------------------------------------------------------------*/
 /*------------------------ METHODS FOR CHANGING DATA -----------------------*/
 /*--------------------------------------------------------------------------*/
@@ -191,6 +191,14 @@ class HydroSystemUnitBlock : public UnitBlock
 
  void deserialize( const netCDF::NcGroup & group ) override;
 
+/*--------------------------------------------------------------------------*/
+ /// returns a copy of the HydroSystemUnitBlock, see UnitBlock::clone()
+ /** The HydroUnitBlock are copied by their clone(), the (optional)
+  * PolyhedralFunctionBlock by copying the data of its PolyhedralFunction
+  * into a new one; exception is thrown if it is of a derived class. */
+
+ UnitBlock * clone( Block * father = nullptr ) const override;
+
 /*--------------------------------------------------------------------------*/
 
  void generate_abstract_variables( Configuration * stvv = nullptr ) override;
@@ -272,6 +280,32 @@ class HydroSystemUnitBlock : public UnitBlock
   return( nullptr );
  }
 
+/*--------------------------------------------------------------------------*/
+ /// returns the total number of reservoirs of all the HydroUnitBlock
+
+ Index get_number_storages( void ) const override {
+  Index number_storages = 0;
+  for( auto sub_block : get_nested_Blocks() )
+   if( auto unit_block = dynamic_cast< HydroUnitBlock * >( sub_block ) )
+    number_storages += unit_block->get_number_storages();
+  return( number_storages );
+ }
+
+/*--------------------------------------------------------------------------*/
+ /// returns the volume variables of the i-th reservoir of the system
+
+ ColVariable * get_storage( Index i = 0 ) override {
+  auto temp = i;
+  for( auto sub_block : get_nested_Blocks() )
+   if( auto unit_block = dynamic_cast< HydroUnitBlock * >( sub_block ) ) {
+    if( temp < unit_block->get_number_storages() )
+     return( unit_block->get_storage( temp ) );
+    else
+     temp = temp - unit_block->get_number_storages();
+   }
+  return( nullptr );
+ }
+
 /*--------------------------------------------------------------------------*/
 
  virtual Index get_number_generators( void ) const override {
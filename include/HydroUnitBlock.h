@@ -512,6 +512,11 @@ class HydroUnitBlock : public UnitBlock
 
  void deserialize( const netCDF::NcGroup & group ) override;
 
+/*--------------------------------------------------------------------------*/
+ /// returns a copy of the HydroUnitBlock, see UnitBlock::clone()
+
+ UnitBlock * clone( Block * father = nullptr ) const override;
+
 /*--------------------------------------------------------------------------*/
  /// generate the abstract variables of the HydroUnitBlock
  /** The HydroUnitBlock class has five boost::multi_array< ColVariable , 2 >
@@ -1334,6 +1339,20 @@ class HydroUnitBlock : public UnitBlock
   return( nullptr );
  }
 
+/*--------------------------------------------------------------------------*/
+ /// returns the number of storages, i.e., of reservoirs
+
+ Index get_number_storages( void ) const override {
+  return( get_number_reservoirs() );
+ }
+
+/*--------------------------------------------------------------------------*/
+ /// returns the volume variables of the given reservoir, see get_volumetric()
+
+ ColVariable * get_storage( Index i = 0 ) override {
+  return( get_volumetric( i ) );
+ }
+
 /*--------------------------------------------------------------------------*/
  /// returns the volume of the given reservoir at the given time
  /** Returns a pointer to the ColVariable representing the volume of the given
@@ -1548,6 +1567,9 @@ class HydroUnitBlock : public UnitBlock
 
  void serialize( netCDF::NcGroup & group ) const override;
 
+ /// returns the memory held by the HydroUnitBlock, see UnitBlock
+ MemoryUsage get_memory_usage( void ) const override;
+
 /** @} ---------------------------------------------------------------------*/
 /*--------------- METHODS FOR INITIALIZING THE HydroUnitBlock --------------*/
 /*--------------------------------------------------------------------------*/
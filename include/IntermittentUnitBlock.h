@@ -190,6 +190,11 @@ class IntermittentUnitBlock : public UnitBlock
 
  void deserialize( const netCDF::NcGroup & group ) override;
 
+/*--------------------------------------------------------------------------*/
+ /// returns a copy of the IntermittentUnitBlock, see UnitBlock::clone()
+
+ UnitBlock * clone( Block * father = nullptr ) const override;
+
 /*--------------------------------------------------------------------------*/
  /// generate the abstract variables of the IntermittentUnitBlock
  /** The IntermittentUnitBlock class has three different variables which are:
@@ -502,8 +507,25 @@ class IntermittentUnitBlock : public UnitBlock
   return( design );
  }
 
+/*--------------------------------------------------------------------------*/
+ /// returns the number of design variables: 1 if f_InvestmentCost != 0
+
+ Index get_number_design_variables( void ) const override {
+  return( f_InvestmentCost != 0 ? 1 : 0 );
+ }
+
+/*--------------------------------------------------------------------------*/
+ /// returns the design variable, if any
+
+ ColVariable * get_design_variable( Index i = 0 ) override {
+  return( ( ( i == 0 ) && ( f_InvestmentCost != 0 ) ) ? & design : nullptr );
+ }
+
 /*--------------------------------------------------------------------------*/
  /// returns the minimum total power constraints
+ /** The vector is empty if there is no design variable and no reserve
+  * variable enters the constraints, which then are the lower bounds of
+  * get_active_power_bound_constraints(). */
 
  const std::vector< FRowConstraint > & get_min_power_constraints( void ) const {
   return( min_power_Const );
@@ -511,6 +533,10 @@ class IntermittentUnitBlock : public UnitBlock
 
 /*--------------------------------------------------------------------------*/
  /// returns the maximum total power constraints
+ /** The vector is empty if the unit produces no reserve, as well as if
+  * there is no design variable and no reserve variable enters the
+  * constraints, which then are the upper bounds of
+  * get_active_power_bound_constraints(). */
 
  const std::vector< FRowConstraint > & get_max_power_constraints( void ) const {
   return( max_power_Const );
@@ -537,6 +563,9 @@ class IntermittentUnitBlock : public UnitBlock
 
  void serialize( netCDF::NcGroup & group ) const override;
 
+ /// returns the memory held by the IntermittentUnitBlock, see UnitBlock
+ MemoryUsage get_memory_usage( void ) const override;
+
 /** @} ---------------------------------------------------------------------*/
 /*----------- METHODS FOR INITIALIZING THE IntermittentUnitBlock -----------*/
 /*--------------------------------------------------------------------------*/
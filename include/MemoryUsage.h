@@ -0,0 +1,175 @@
+/*--------------------------------------------------------------------------*/
+/*------------------------- File MemoryUsage.h -----------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ * Header file for the struct MemoryUsage, the breakdown by family of the
+ * memory held by a Block of the UCBlock project (see
+ * UnitBlock::get_memory_usage(), NetworkBlock::get_memory_usage() and
+ * UCBlock::get_memory_usage()).
+ *
+ * \author The UCBlock contributors
+ *
+ * \copyright &copy; by the UCBlock contributors
+ */
+/*--------------------------------------------------------------------------*/
+/*----------------------------- DEFINITIONS --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#ifndef __MemoryUsage
+ #define __MemoryUsage  /* self-identification: #endif at the end of file */
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ INCLUDES ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#include "Block.h"
+
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*--------------------------------------------------------------------------*/
+/*----------------------------- NAMESPACE ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+/// namespace for the Structured Modeling System++ (SMS++)
+
+namespace SMSpp_di_unipi_it
+{
+
+/*--------------------------------------------------------------------------*/
+/*------------------------- STRUCT MemoryUsage -----------------------------*/
+/*--------------------------------------------------------------------------*/
+/// the memory held by a Block, in bytes, broken down by family
+/** The struct MemoryUsage reports the memory held by a Block (and, unless
+ * otherwise stated, by all its sub-Block), in bytes, broken down into:
+ *
+ * - data: the physical data, i.e., the std::vector and boost::multi_array
+ *   (element storage plus the container itself) holding the parameters of
+ *   the Block; scalar fields are not accounted for;
+ *
+ * - variables: the static ColVariable;
+ *
+ * - constraints: the static FRowConstraint and OneVarConstraint, excluding
+ *   the Function of the FRowConstraint;
+ *
+ * - coefficients: the LinearFunction of the static FRowConstraint and of
+ *   the Objective, with one coefficient and one ColVariable pointer per
+ *   active Variable;
+ *
+ * - solver: the internals of the registered Solver that are able to report
+ *   them (so far, ThermalUnitDPSolver).
+ *
+ * All the figures are estimates: the allocator overhead, the dynamic
+ * Variable and Constraint, and Function other than LinearFunction are not
+ * accounted for. */
+
+struct MemoryUsage
+{
+ std::size_t data{};          ///< the physical data
+ std::size_t variables{};     ///< the static ColVariable
+ std::size_t constraints{};   ///< the static Constraint
+ std::size_t coefficients{};  ///< the LinearFunction
+ std::size_t solver{};        ///< the internals of the Solver
+
+ /// returns the total number of bytes
+ std::size_t total( void ) const {
+  return( data + variables + constraints + coefficients + solver );
+  }
+
+ MemoryUsage & operator+=( const MemoryUsage & usage ) {
+  data += usage.data;
+  variables += usage.variables;
+  constraints += usage.constraints;
+  coefficients += usage.coefficients;
+  solver += usage.solver;
+  return( *this );
+  }
+
+ MemoryUsage & operator-=( const MemoryUsage & usage ) {
+  data -= usage.data;
+  variables -= usage.variables;
+  constraints -= usage.constraints;
+  coefficients -= usage.coefficients;
+  solver -= usage.solver;
+  return( *this );
+  }
+
+ /// adds the given containers of physical data
+ template< class... C >
+ void add_data( const C & ... c ) {
+  data += ( ( sizeof( C ) + heap( c ) ) + ... + 0 );
+  }
+
+ /// adds the static Variable, Constraint and the Objective of b
+ /** Adds the static ColVariable and Constraint of the Block b, as well as
+  * its Objective, but not those of its sub-Block. */
+
+ void add_abstract( const Block * b );
+
+ /// returns the MemoryUsage of the abstract representation of b
+ /** Returns the MemoryUsage of the abstract representation (see
+  * add_abstract()) of the Block b and of all its sub-Block, recursively.
+  * This is used for the Block that cannot report about their physical
+  * data. */
+
+ static MemoryUsage of_abstract( const Block * b );
+
+ /// the dynamic memory held by an object, beyond its sizeof()
+ template< class T >
+ static std::size_t heap( const T & ) { return( 0 ); }
+
+ static std::size_t heap( const std::string & s ) {
+  return( s.capacity() > sizeof( std::string ) ? s.capacity() : 0 );
+  }
+
+ template< class T1 , class T2 >
+ static std::size_t heap( const std::pair< T1 , T2 > & p ) {
+  return( heap( p.first ) + heap( p.second ) );
+  }
+
+ template< class T , class A >
+ static std::size_t heap( const std::vector< T , A > & v ) {
+  std::size_t bytes = v.capacity() * sizeof( T );
+  for( const auto & e : v )
+   bytes += heap( e );
+  return( bytes );
+  }
+
+ template< class A >
+ static std::size_t heap( const std::vector< bool , A > & v ) {
+  return( v.capacity() / 8 );
+  }
+
+ template< class T , class A >
+ static std::size_t heap( const std::list< T , A > & l ) {
+  std::size_t bytes = l.size() * ( sizeof( T ) + 2 * sizeof( void * ) );
+  for( const auto & e : l )
+   bytes += heap( e );
+  return( bytes );
+  }
+
+ template< class T , std::size_t K , class A >
+ static std::size_t heap( const boost::multi_array< T , K , A > & a ) {
+  std::size_t bytes = a.num_elements() * sizeof( T );
+  for( auto p = a.data() ; p != a.data() + a.num_elements() ; ++p )
+   bytes += heap( *p );
+  return( bytes );
+  }
+
+};  // end( struct( MemoryUsage ) )
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+}  // end( namespace SMSpp_di_unipi_it )
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#endif /* MemoryUsage.h included */
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- End File MemoryUsage.h ---------------------------*/
+/*--------------------------------------------------------------------------*/
@@ -48,6 +48,8 @@
 
 #include "ColVariable.h"
 
+#include "MemoryUsage.h"
+
 /*--------------------------------------------------------------------------*/
 /*--------------------------- NAMESPACE ------------------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -201,6 +203,17 @@ class NetworkBlock : public Block
 
   virtual void deserialize( const netCDF::NcGroup & group ) {}
 
+/*--------------------------------------------------------------------------*/
+
+  /// returns a new NetworkData with the same data as this one
+  /** Returns a newly allocated NetworkData of the same type of this one and
+   * with the same data, which is owned by the caller. This is used by
+   * UCBlock::clone(); the base class has no data and throws exception. */
+
+  virtual NetworkData * clone( void ) const {
+   throw( std::logic_error( "NetworkData::clone() not implemented" ) );
+  }
+
 /**@} ----------------------------------------------------------------------*/
 /*------------- METHODS FOR READING THE DATA OF THE NetworkData ------------*/
 /*--------------------------------------------------------------------------*/
@@ -227,6 +240,14 @@ class NetworkBlock : public Block
 
   virtual void serialize( netCDF::NcGroup & group ) const = 0;
 
+  /// returns the memory held by the NetworkData, see MemoryUsage
+  /** Returns the memory held by the NetworkData (only the MemoryUsage::data
+   * part is meaningful); the base class only has scalar data. */
+
+  virtual MemoryUsage get_memory_usage( void ) const {
+   return( MemoryUsage() );
+   }
+
 /*--------------------------------------------------------------------------*/
 /*--------------------- PROTECTED PART OF THE CLASS ------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -367,6 +388,22 @@ class NetworkBlock : public Block
 
  void deserialize( const netCDF::NcGroup & group ) override {}
 
+/*--------------------------------------------------------------------------*/
+ /// returns a copy of this NetworkBlock
+ /** Returns a newly allocated NetworkBlock of the same type of this one,
+  * with the given father and the same data; its abstract representation is
+  * not copied, and it is generated anew when needed. The NetworkData of the
+  * copy is a copy of that of this NetworkBlock if the latter owns it, and
+  * the very same (not owned) object otherwise, so that the caller can
+  * replace it with set_NetworkData() (as UCBlock::clone() does).
+  *
+  * Derived classes copy their data directly, those of the base class (the
+  * BlockConfig included) by clone_data(). The base version throws
+  * exception, as the data of a derived class not overriding it would not
+  * be copied. */
+
+ virtual NetworkBlock * clone( Block * father = nullptr ) const;
+
 /*--------------------------------------------------------------------------*/
  /// generate the static variables of NetworkBlock
  /** The base NetworkBlock class has just the node injection variables, which
@@ -391,6 +428,17 @@ class NetworkBlock : public Block
   throw( std::logic_error( "NetworkBlock::load() not implemented yet" ) );
  }
 
+/*--------------------------------------------------------------------------*/
+ /// returns the memory held by the NetworkBlock
+ /** Returns the memory held by the NetworkBlock, broken down by family (see
+  * MemoryUsage), comprised that of its NetworkData if it is owned by the
+  * NetworkBlock (a NetworkData shared among several NetworkBlock is
+  * accounted for by their owner, e.g., UCBlock). Derived classes are
+  * expected to add their own data. This must not be called while the
+  * NetworkBlock is being modified. */
+
+ virtual MemoryUsage get_memory_usage( void ) const;
+
 /**@} ----------------------------------------------------------------------*/
 /*--------------- METHODS FOR MODIFYING THE NetworkBlock -------------------*/
 /*--------------------------------------------------------------------------*/
@@ -723,6 +771,9 @@ class NetworkBlock : public Block
  /// states that the Objective of the NetworkBlock has been generated
  void set_objective_generated( void ) { AR |= HasObj; }
 
+ /// copies the data of the base NetworkBlock from the given one
+ void clone_data( const NetworkBlock & from );
+
  /// indicates whether the Variable of the NetworkBlock have been generated
  bool variables_generated( void ) const { return( AR & HasVar ); }
 
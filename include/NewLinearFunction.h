@@ -0,0 +1,78 @@
+/*--------------------------------------------------------------------------*/
+/*----------------------- File NewLinearFunction.h -------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ * Header file for the function new_LinearFunction(), shared by the
+ * UnitBlock, NetworkBlock and UCBlock of the UCBlock project for building
+ * the LinearFunction of their static constraints one row at a time.
+ *
+ * \author The UCBlock contributors
+ *
+ * \copyright &copy; by the UCBlock contributors
+ */
+/*--------------------------------------------------------------------------*/
+/*----------------------------- DEFINITIONS --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#ifndef __NewLinearFunction
+ #define __NewLinearFunction  /* self-identification: #endif at the end */
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ INCLUDES ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#include "LinearFunction.h"
+
+/*--------------------------------------------------------------------------*/
+/*----------------------------- NAMESPACE ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+/// namespace for the Structured Modeling System++ (SMS++)
+
+namespace SMSpp_di_unipi_it
+{
+
+/*--------------------------------------------------------------------------*/
+/*---------------------- FUNCTION new_LinearFunction() ---------------------*/
+/*--------------------------------------------------------------------------*/
+
+/// returns a new LinearFunction with the coefficients in \p vars
+/** Returns a new LinearFunction whose coefficients are those in \p vars,
+ * which is then cleared but keeps its capacity. This is meant for the
+ * generate_abstract_constraints() of the UCBlock project, which build the
+ * LinearFunction of the static constraints one row at a time into a single
+ * v_coeff_pair: rather than handing it over to the LinearFunction (which
+ * makes it empty and with no capacity, so that each row re-grows it one
+ * push_back() at a time), it is used as a scratch buffer, and each
+ * LinearFunction gets an exactly-sized copy of it. Hence each row costs one
+ * allocation, with no reallocation along the way and no unused capacity
+ * left in the LinearFunction. The effect on the time and memory needed by
+ * large models can be measured with the "constraints.<class>" and
+ * "teardown" stages and the peak RSS reported by ucblock_bench.
+ *
+ * The LinearFunction are still allocated one by one, because the
+ * FRowConstraint owns (and eventually deletes) its Function. There is no
+ * point in using this when the size of the row is known in advance and the
+ * v_coeff_pair is constructed with that size anyway. */
+
+inline LinearFunction * new_LinearFunction(
+                                       LinearFunction::v_coeff_pair & vars )
+{
+ auto lf = new LinearFunction(
+  LinearFunction::v_coeff_pair( vars.begin() , vars.end() ) );
+ vars.clear();
+ return( lf );
+}
+
+/*--------------------------------------------------------------------------*/
+
+}  // end( namespace SMSpp_di_unipi_it )
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#endif /* NewLinearFunction.h included */
+
+/*--------------------------------------------------------------------------*/
+/*-------------------- End File NewLinearFunction.h ------------------------*/
+/*--------------------------------------------------------------------------*/
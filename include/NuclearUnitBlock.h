@@ -100,7 +100,7 @@ class NuclearUnitBlock : public ThermalUnitBlock {
 
  explicit NuclearUnitBlock( Block * f_block = nullptr ) :
   ThermalUnitBlock( f_block ) , f_initial_modulation( 0 ) ,
-  f_modulation_interval( 0 ) {}
+  f_modulation_interval( 0 ) , f_compact_modulation( false ) {}
 
 /*--------------------------------------------------------------------------*/
  /// destructor of NuclearUnitBlock
@@ -193,6 +193,11 @@ class NuclearUnitBlock : public ThermalUnitBlock {
 
  void deserialize( const netCDF::NcGroup & group ) override;
 
+/*--------------------------------------------------------------------------*/
+/// returns a copy of the NuclearUnitBlock, see UnitBlock::clone()
+
+ UnitBlock * clone( Block * father = nullptr ) const override;
+
 /*--------------------------------------------------------------------------*/
 /// generate the abstract variables of the NuclearUnitBlock
 /** Besides those of ThermalUnitBlock (depending on the exact chosen
@@ -202,9 +207,22 @@ class NuclearUnitBlock : public ThermalUnitBlock {
  * indicating whether or not the unit is performing a modulation at time
  * instant t. These variables are mandatory.
  *
- * The Configuration parameter has no use here and it is just passed up to
- * the method of the base ThermalUnitBlock class that is called first thing
- * here inside. */
+ * The Configuration parameter is passed up to the method of the base
+ * ThermalUnitBlock class that is called first thing here inside, which uses
+ * the "wf" value found there (see ThermalUnitBlock::
+ * generate_abstract_variables()) to choose the thermal formulation. The
+ * NuclearUnitBlock only looks at bit 16 of the same "wf": if
+ *
+ *     wf & 16 != 0
+ *
+ * then the "compact" formulation of the modulation constraints is used (see
+ * generate_abstract_constraints()). When this happens and the modulation
+ * interval is long enough for it to pay off (currently, \f$ \tau^M \geq 6
+ * \f$), a second std::vector of size TimeHorizon is constructed containing
+ * the continuous cumulative modulation variables
+ * \f$ s_t = \sum_{h = 0}^t m_h \f$. Note that bit 16 is ignored by
+ * ThermalUnitBlock, hence the same value can be used for ThermalUnitBlock
+ * and NuclearUnitBlock alike. */
 
  void generate_abstract_variables( Configuration *stvv = nullptr ) override;
 
@@ -256,6 +274,26 @@ class NuclearUnitBlock : public ThermalUnitBlock {
  * done by changing the bounds (and fixing them) and therefore it does not
  * result in a separate group of constraints.
  *
+ * If the "compact" formulation has been selected in
+ * generate_abstract_variables(), the two groups of logical constraints are
+ * replaced by the single one
+ *   \f[
+ *     m_t + v_t - u_t \leq 0
+ *   \f]
+ *
+ * which has the same integer solutions but a stronger continuous
+ * relaxation, with one row per time instant less. Furthermore, if the
+ * cumulative modulation variables have been constructed, the modulation
+ * constraint proper is written in "sliding-sum" form as
+ *   \f[
+ *     s_t - s_{t-1} - m_t = 0 \quad , \quad s_t - s_{t - \tau^M} \leq 1
+ *   \f]
+ *
+ * (with \f$ s_{-1} = 0 \f$, and the term \f$ s_{t - \tau^M} \f$ absent
+ * if \f$ t < \tau^M \f$), which uses O( T ) nonzeros rather than
+ * O( T \tau^M ). The definition rows are kept in ModulationSumConst while
+ * the window ones take the place of the original ones in ModulationConst.
+ *
  * The Configuration parameter has no use here and it is just passed up to
  * the method of the base ThermalUnitBlock class that is called first thing
  * here inside. */
@@ -397,6 +435,9 @@ class NuclearUnitBlock : public ThermalUnitBlock {
 
  void serialize( netCDF::NcGroup & group ) const override;
 
+ /// returns the memory held by the NuclearUnitBlock, see UnitBlock
+ MemoryUsage get_memory_usage( void ) const override;
+
 /** @} ---------------------------------------------------------------------*/
 /*-------------- METHODS FOR INITIALIZING THE NuclearUnitBlock -------------*/
 /*--------------------------------------------------------------------------*/
@@ -531,11 +572,17 @@ class NuclearUnitBlock : public ThermalUnitBlock {
  /// the minimum allowed modulation interval
  int f_modulation_interval;
 
+ /// true if the compact formulation of the modulation constraints is used
+ bool f_compact_modulation;
+
 //----------------------------- Variable ------------------------------------
 
  /// the modulation (binary) variables
  std::vector< ColVariable > v_modulation;
 
+ /// the cumulative modulation variables (compact formulation only)
+ std::vector< ColVariable > v_modulation_sum;
+
 //---------------------------- Constraint -----------------------------------
 
  /// the Modulation RampUp time constraints
@@ -553,6 +600,9 @@ class NuclearUnitBlock : public ThermalUnitBlock {
  /// the Modulation constraints constraints proper
  std::vector< FRowConstraint > ModulationConst;
 
+ /// the constraints defining the cumulative modulation variables
+ std::vector< FRowConstraint > ModulationSumConst;
+
 /*--------------------------------------------------------------------------*/
 /*----------------------- PRIVATE PART OF THE CLASS ------------------------*/
 /*--------------------------------------------------------------------------*/
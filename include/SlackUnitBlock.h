@@ -243,6 +243,11 @@ class SlackUnitBlock : public UnitBlock
 
  void deserialize( const netCDF::NcGroup & group ) override;
 
+/*--------------------------------------------------------------------------*/
+ /// returns a copy of the SlackUnitBlock, see UnitBlock::clone()
+
+ UnitBlock * clone( Block * father = nullptr ) const override;
+
 /*--------------------------------------------------------------------------*/
  /// generate the abstract variables of the SlackUnitBlock
  /** The SlackUnitBlock class has several different variables which are:
@@ -602,6 +607,9 @@ class SlackUnitBlock : public UnitBlock
 
  void serialize( netCDF::NcGroup & group ) const override;
 
+ /// returns the memory held by the SlackUnitBlock, see UnitBlock
+ MemoryUsage get_memory_usage( void ) const override;
+
 /** @} ---------------------------------------------------------------------*/
 /*--------------- METHODS FOR INITIALIZING THE SlackUnitBlock --------------*/
 /*--------------------------------------------------------------------------*/
@@ -0,0 +1,409 @@
+/*--------------------------------------------------------------------------*/
+/*----------------------- File StochasticUCBlock.h -------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ * Header file for the class StochasticUCBlock, which implements the Block
+ * concept [see Block.h] for a two-stage stochastic Unit Commitment problem
+ * whose scenarios only differ in the active power demand and in the maximum
+ * power of the intermittent units. The UCBlock [see UCBlock.h] describing
+ * the units and the network is read once, while the scenario-dependent
+ * arrays are stored as one time profile per scenario, and loaded into the
+ * UCBlock sub-Block on demand.
+ *
+ * \author The UCBlock contributors
+ *
+ * \copyright &copy; by the UCBlock contributors
+ */
+/*--------------------------------------------------------------------------*/
+/*----------------------------- DEFINITIONS --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#ifndef __StochasticUCBlock
+ #define __StochasticUCBlock
+                      /* self-identification: #endif at the end of the file */
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ INCLUDES ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#include "UCBlock.h"
+
+#include "FRowConstraint.h"
+
+#include <functional>
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ NAMESPACE ---------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+/// namespace for the Structured Modeling System++ (SMS++)
+
+namespace SMSpp_di_unipi_it
+{
+
+/*--------------------------------------------------------------------------*/
+/*------------------------ CLASS StochasticUCBlock -------------------------*/
+/*--------------------------------------------------------------------------*/
+/*--------------------------- GENERAL NOTES --------------------------------*/
+/*--------------------------------------------------------------------------*/
+/// a two-stage stochastic Unit Commitment problem
+/** The StochasticUCBlock class implements the Block concept for a two-stage
+ * stochastic Unit Commitment problem with S scenarios, each with a
+ * probability, that only differ in the active power demand and in the
+ * maximum power of the IntermittentUnitBlock. The commitment decisions of
+ * the ThermalUnitBlock (including the NuclearUnitBlock) can be taken as
+ * first-stage decisions, i.e., be required to be the same in all the
+ * scenarios ("non-anticipativity"), while all the rest is decided after the
+ * scenario is revealed.
+ *
+ * Rather than S full UCBlock, the StochasticUCBlock holds K <= S UCBlock
+ * sub-Block ("copies"), all read out of the same base UCBlock, and the S
+ * scenario-dependent time profiles; set_scenario() loads the data of any
+ * scenario into any copy by means of the set_*() methods of UCBlock and
+ * IntermittentUnitBlock. Each copy is a complete UCBlock, obtained by
+ * UCBlock::clone() (or by reading the base again, if it is of a class
+ * derived from UCBlock): the data of the units and of the network are
+ * *not* shared among the copies, but duplicated in each of them, as is
+ * their abstract representation. Thus, the memory grows with K, and the
+ * scenarios only cost their time profiles, which is what decomposition
+ * methods solving the scenarios one at a time (K = 1), or K at a time in
+ * parallel, need; progressive_hedging() and evaluate_commitment() are such
+ * methods. If K == S, copy s permanently holds scenario s and the
+ * StochasticUCBlock also is the "extensive form" of the problem, whose
+ * memory is that of S full UCBlock: if the
+ * commitments are non-anticipative, its abstract representation comprises
+ * the constraints u^s_t = u^0_t for all the ThermalUnitBlock, s = 1, ...,
+ * S - 1 and t, which link the commitment of each scenario with that of
+ * scenario 0. If K < S, these constraints are not generated, since the
+ * copies are not the scenarios, and the abstract representation only is a
+ * working space for decomposition methods. The StochasticUCBlock has no
+ * Objective; each copy has that of its UCBlock, and the expected cost is
+ * the sum of these weighted by the probabilities of the scenarios. */
+
+class StochasticUCBlock : public Block
+{
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PUBLIC PART OF THE CLASS -------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ public:
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- PUBLIC TYPES --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ /// the outcome of progressive_hedging()
+ struct PHResult {
+  Index iterations = 0;    ///< number of iterations performed
+  bool converged = false;  ///< true if the commitments have converged
+  double deviation = 0;    ///< max | u^s_t - average u_t | at the end
+  double expected_cost = 0;  ///< expected cost of the last scenario solutions
+
+  /// the average commitment of each ThermalUnitBlock, [ units ][ T ], the
+  /// units being taken in the order of their index in the UCBlock
+  std::vector< double > commitment;
+ };
+
+/*--------------------------------------------------------------------------*/
+/*--------------------- CONSTRUCTOR AND DESTRUCTOR -------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @name Constructor and Destructor
+ * @{ */
+
+ /// constructor, takes the father block
+ /** Constructor of StochasticUCBlock, taking possibly a pointer of its
+  * father Block. */
+
+ explicit StochasticUCBlock( Block * f_block = nullptr )
+  : Block( f_block ) {}
+
+/*--------------------------------------------------------------------------*/
+ /// destructor of StochasticUCBlock
+
+ virtual ~StochasticUCBlock() override;
+
+/**@} ----------------------------------------------------------------------*/
+/*-------------------------- OTHER INITIALIZATIONS -------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @name Other initializations
+ * @{ */
+
+ /// extends Block::deserialize( netCDF::NcGroup )
+ /** Extends Block::deserialize( netCDF::NcGroup ) to the specific format of
+  * a StochasticUCBlock. Besides the mandatory "type" attribute of any
+  * :Block, the group should contain the following:
+  *
+  * - The dimension "NumberScenarios", the number S >= 1 of scenarios.
+  *
+  * - The group "UCBlock", containing the base UCBlock in the format of
+  *   UCBlock::deserialize(); its "type" attribute must be "UCBlock" or the
+  *   name of a class deriving from it.
+  *
+  * - The optional variable "Probability", of type netCDF::NcDouble and
+  *   indexed over "NumberScenarios": Probability[ s ] is the probability of
+  *   scenario s. If it is not present, all the scenarios have probability
+  *   1 / S.
+  *
+  * - The optional variable "ActivePowerDemand", of type netCDF::NcDouble,
+  *   whose first dimension is "NumberScenarios" and whose entries for each
+  *   scenario s are the "ActivePowerDemand" of the base UCBlock in scenario
+  *   s, i.e., NumberNodes x TimeHorizon values in row-major order. If it is
+  *   not present, the demand is that of the base UCBlock in all scenarios.
+  *
+  * - The optional groups "UnitBlock_k", where k is the index of an
+  *   IntermittentUnitBlock of the base UCBlock, each containing the
+  *   variable "MaxPower", of type netCDF::NcDouble, whose first dimension is
+  *   "NumberScenarios" and whose entries for each scenario s are the
+  *   TimeHorizon values of the "MaxPower" of the unit in scenario s.
+  *
+  * - The optional integer attribute "NumberCopies", the number K of UCBlock
+  *   sub-Block (see the general notes); it must be between 1 and S, and it
+  *   is 1 if not present.
+  *
+  * - The optional integer attribute "NonAnticipative"; if it is present
+  *   and zero, the commitments of the ThermalUnitBlock are not required to
+  *   be the same in all the scenarios, otherwise they are.
+  *
+  * After the call, copy k holds scenario k, for all k = 0, ..., K - 1.
+  * Exception is thrown if the group does not have the above format. */
+
+ void deserialize( const netCDF::NcGroup & group ) override;
+
+/*--------------------------------------------------------------------------*/
+ /// generates the abstract constraints of the StochasticUCBlock
+ /** Generates the abstract constraints of all the copies and, if the
+  * commitments are non-anticipative and K == S, the non-anticipativity
+  * constraints linking the commitment of the ThermalUnitBlock of each
+  * scenario s > 0 with those of scenario 0. */
+
+ void generate_abstract_constraints( Configuration * stcc = nullptr )
+  override;
+
+/**@} ----------------------------------------------------------------------*/
+/*---------- METHODS FOR READING THE DATA OF THE StochasticUCBlock ---------*/
+/*--------------------------------------------------------------------------*/
+/** @name Reading the data of the StochasticUCBlock
+ * @{ */
+
+ /// returns the number S of scenarios
+ Index get_number_scenarios( void ) const { return( f_number_scenarios ); }
+
+/*--------------------------------------------------------------------------*/
+ /// returns the number K of copies
+ Index get_number_copies( void ) const { return( v_Block.size() ); }
+
+/*--------------------------------------------------------------------------*/
+ /// returns the probabilities of the scenarios
+ const std::vector< double > & get_probabilities( void ) const {
+  return( v_probability );
+ }
+
+/*--------------------------------------------------------------------------*/
+ /// tells if the commitments of the ThermalUnitBlock are non-anticipative
+ bool is_non_anticipative( void ) const { return( f_non_anticipative ); }
+
+/*--------------------------------------------------------------------------*/
+ /// returns the copy with the given index
+ /** Returns the UCBlock sub-Block with index \p copy, between 0 and
+  * get_number_copies() - 1; if K == S, it is that of scenario \p copy. */
+
+ UCBlock * get_copy( Index copy ) const {
+  return( static_cast< UCBlock * >( v_Block[ copy ] ) );
+ }
+
+/*--------------------------------------------------------------------------*/
+ /// returns the scenario currently loaded in the given copy
+ Index get_scenario( Index copy ) const { return( v_scenario[ copy ] ); }
+
+/**@} ----------------------------------------------------------------------*/
+/*------------------- METHODS FOR HANDLING THE SCENARIOS -------------------*/
+/*--------------------------------------------------------------------------*/
+/** @name Methods for handling the scenarios
+ * @{ */
+
+ /// loads the data of the given scenario into the given copy
+ /** Loads the active power demand and the maximum power of the
+  * IntermittentUnitBlock of scenario \p scenario (between 0 and
+  * get_number_scenarios() - 1) into the UCBlock with index \p copy, by
+  * calling UCBlock::set_active_power_demand() and
+  * IntermittentUnitBlock::set_maximum_power() with the given \p issuePMod
+  * and \p issueAMod; nothing is done if the copy already holds the
+  * scenario. Different copies can be loaded concurrently, provided that no
+  * Solver is registered to the StochasticUCBlock itself. If K == S, changing
+  * the scenario of a copy breaks the correspondence between copies and
+  * scenarios assumed by the non-anticipativity constraints, hence exception
+  * is thrown if these have been generated. */
+
+ void set_scenario( Index copy , Index scenario ,
+                    ModParam issuePMod = eNoBlck ,
+                    ModParam issueAMod = eNoBlck );
+
+/*--------------------------------------------------------------------------*/
+ /// solves the problem by progressive hedging
+ /** Solves the two-stage problem by the progressive hedging method, which
+  * at each iteration solves all the scenarios independently, with the
+  * objective of each augmented by the term
+  *
+  *   sum_t w^s_t u^s_t + rho / 2 ( u^s_t - ubar_t )^2
+  *
+  * for the commitment u^s_t of each ThermalUnitBlock, where ubar_t is the
+  * average over the scenarios of the commitments of the previous iteration
+  * (weighted by the probabilities) and w^s_t the multipliers, updated as
+  * w^s_t += rho ( u^s_t - ubar_t ) after each iteration. Since u^s_t is
+  * binary, the term is linear, and it is added to the constant term of the
+  * ThermalUnitBlock (see ThermalUnitBlock::set_const_term()), which is
+  * restored at the end. The first iteration solves the scenarios without
+  * any added term.
+  *
+  * The method stops when max | u^s_t - ubar_t | <= \p tolerance, or after
+  * \p max_iterations iterations. If the commitments are not
+  * non-anticipative, a single iteration is done.
+  *
+  * Each scenario is solved by the first Solver registered to the copy
+  * holding it, after loading the scenario with set_scenario() if K < S;
+  * the copies must therefore have a registered Solver, typically set up by
+  * a BlockSolverConfig. The scenarios are split among min( \p threads , K )
+  * threads, each handling one copy (0 meaning
+  * std::thread::hardware_concurrency()); the Solver of different copies
+  * must therefore be able to run concurrently. Since the Modification
+  * issued by set_scenario() and ThermalUnitBlock::set_const_term() on a
+  * copy are also passed to this StochasticUCBlock and to its ancestors,
+  * these calls are done by one thread at a time, while the Solver of the
+  * copies run in parallel. Exception is thrown if a
+  * copy has no registered Solver or a Solver does not find a solution, in
+  * which case the constant terms are restored as well. */
+
+ PHResult progressive_hedging( double rho , Index max_iterations = 100 ,
+                               double tolerance = 1e-6 ,
+                               unsigned int threads = 0 );
+
+/*--------------------------------------------------------------------------*/
+ /// returns the expected cost of a given first-stage commitment
+ /** Returns the expected cost of the second stage for the given commitments
+  * of the ThermalUnitBlock, i.e., the weighted sum over the scenarios of
+  * the optimal cost of each scenario when its commitments are fixed to
+  * those in \p commitment; this is the recourse function that a two-stage
+  * method (e.g., the L-shaped one) evaluates, and it gives an implementable
+  * solution out of the average commitment returned by
+  * progressive_hedging(), which need not be integer.
+  *
+  * \p commitment has the same format as PHResult::commitment, i.e.,
+  * [ units ][ T ], each value being rounded to 0 or 1. The commitment
+  * variables of each copy that are not already fixed are set to these
+  * values and fixed (by ColVariable::fix()), the scenario is solved by the
+  * first Solver registered to the copy as in progressive_hedging() (with the
+  * same use of \p threads), and the variables are then unfixed. If the
+  * Solver of a scenario does not find a solution, e.g., since the
+  * commitment is infeasible for it, Inf< double >() is returned. Exception
+  * is thrown if \p commitment has the wrong size or a copy has no
+  * registered Solver, in which case the variables are unfixed as well. */
+
+ double evaluate_commitment( const std::vector< double > & commitment ,
+                             unsigned int threads = 0 );
+
+/**@} ----------------------------------------------------------------------*/
+/*-------------- METHODS FOR SAVING THE StochasticUCBlock ------------------*/
+/*--------------------------------------------------------------------------*/
+/** @name Methods for printing & saving the StochasticUCBlock
+ * @{ */
+
+ /// extends Block::serialize( netCDF::NcGroup )
+ /** Extends Block::serialize( netCDF::NcGroup ) to the specific format of a
+  * StochasticUCBlock. See StochasticUCBlock::deserialize( netCDF::NcGroup )
+  * for details of the format of the created netCDF group; the base UCBlock
+  * is written out of copy 0, whatever scenario it currently holds, since
+  * all the scenario-dependent data are anyway written separately. */
+
+ void serialize( netCDF::NcGroup & group ) const override;
+
+/**@} ----------------------------------------------------------------------*/
+/*------------ METHODS FOR INITIALIZING THE StochasticUCBlock --------------*/
+/*--------------------------------------------------------------------------*/
+/** @name Handling the data of the StochasticUCBlock
+ * @{ */
+
+ void load( std::istream & input , char frmt = 0 ) override {
+  throw( std::logic_error(
+   "StochasticUCBlock::load() not implemented yet" ) );
+ }
+
+/** @} ---------------------------------------------------------------------*/
+/*-------------------- PROTECTED PART OF THE CLASS -------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ protected:
+
+/*--------------------------------------------------------------------------*/
+/*-------------------- PROTECTED FIELDS OF THE CLASS -----------------------*/
+/*--------------------------------------------------------------------------*/
+
+/*---------------------------------- data ----------------------------------*/
+
+ /// the number of scenarios
+ Index f_number_scenarios{};
+
+ /// true if the commitments of the ThermalUnitBlock are non-anticipative
+ bool f_non_anticipative = true;
+
+ /// the probability of each scenario
+ std::vector< double > v_probability;
+
+ /// the active power demand of each scenario, [ S ][ nodes * T ], or empty
+ std::vector< double > v_active_power_demand;
+
+ /// the index of each IntermittentUnitBlock with scenario-dependent
+ /// maximum power, and its maximum power in each scenario, [ S ][ T ]
+ std::vector< std::pair< Index , std::vector< double > > > v_max_power;
+
+ /// the scenario currently held by each copy
+ std::vector< Index > v_scenario;
+
+/*------------------------------- constraints ------------------------------*/
+
+ /// the non-anticipativity constraints, [ S - 1 ][ units ][ T ], the units
+ /// being the ThermalUnitBlock
+ boost::multi_array< FRowConstraint , 3 > v_NonAnticipativity_Const;
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PRIVATE PART OF THE CLASS ------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ private:
+
+/*--------------------------------------------------------------------------*/
+/*---------------------- PRIVATE METHODS OF THE CLASS ----------------------*/
+/*--------------------------------------------------------------------------*/
+
+ /// returns the indices of the ThermalUnitBlock of the UCBlock
+ std::vector< Index > thermal_units( void ) const;
+
+ /// calls solve( k , s ) for all the scenarios s, in parallel
+ /** Calls solve( k , s ) once for each scenario s, k being the copy that
+  * solves it, by min( threads , K ) threads (0 meaning
+  * std::thread::hardware_concurrency()), each using its own copy: if
+  * K == S then k == s, otherwise each thread picks the next scenario. If
+  * any call throws, no more calls are started, and the exception is
+  * rethrown after all the threads have stopped. */
+ void solve_scenarios( const std::function< void( Index , Index ) > & solve ,
+                       unsigned int threads );
+
+/*--------------------------------------------------------------------------*/
+
+ SMSpp_insert_in_factory_h;
+
+};  // end( class( StochasticUCBlock ) )
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+}  // end( namespace SMSpp_di_unipi_it )
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#endif /* StochasticUCBlock.h included */
+
+/*--------------------------------------------------------------------------*/
+/*--------------------- End File StochasticUCBlock.h -----------------------*/
+/*--------------------------------------------------------------------------*/
@@ -388,6 +388,11 @@ class ThermalUnitBlock : public UnitBlock
 
  void deserialize( const netCDF::NcGroup & group ) override;
 
+/*--------------------------------------------------------------------------*/
+ /// returns a copy of the ThermalUnitBlock, see UnitBlock::clone()
+
+ UnitBlock * clone( Block * father = nullptr ) const override;
+
 /*--------------------------------------------------------------------------*/
  /// generate the abstract variables of the ThermalUnitBlock
  /** Method that generates the abstract Variable of the ThermalUnitBlock,
@@ -1350,6 +1355,14 @@ class ThermalUnitBlock : public UnitBlock
   return( &( v_start_up.front() ) );
  }
 
+/*--------------------------------------------------------------------------*/
+ /// returns the start_up variable for time t, or nullptr if not defined
+ ColVariable * get_start_up( Index t ) {
+  if( v_start_up.empty() || ( t < init_t ) )
+   return( nullptr );
+  return( &( v_start_up[ t - init_t ] ) );
+ }
+
 /*--------------------------------------------------------------------------*/
  /// returns the vector of shut_down variables, or nullptr if not defined
  ColVariable * get_shut_down( void ) {
@@ -1373,6 +1386,20 @@ class ThermalUnitBlock : public UnitBlock
   return( design );
  }
 
+/*--------------------------------------------------------------------------*/
+ /// returns the number of design variables: 1 if f_InvestmentCost != 0
+
+ Index get_number_design_variables( void ) const override {
+  return( f_InvestmentCost != 0 ? 1 : 0 );
+ }
+
+/*--------------------------------------------------------------------------*/
+ /// returns the design variable, if any
+
+ ColVariable * get_design_variable( Index i = 0 ) override {
+  return( ( ( i == 0 ) && ( f_InvestmentCost != 0 ) ) ? & design : nullptr );
+ }
+
 /**@} ----------------------------------------------------------------------*/
 /*------------------ METHODS FOR SAVING THE ThermalUnitBlock ---------------*/
 /*--------------------------------------------------------------------------*/
@@ -1386,6 +1413,13 @@ class ThermalUnitBlock : public UnitBlock
 
  void serialize( netCDF::NcGroup & group ) const override;
 
+ /// returns the memory held by the ThermalUnitBlock, see UnitBlock
+ /** Returns the memory held by the ThermalUnitBlock (see
+  * UnitBlock::get_memory_usage()), comprised the internals of all the
+  * ThermalUnitDPSolver registered to it. */
+
+ MemoryUsage get_memory_usage( void ) const override;
+
 /** @} ---------------------------------------------------------------------*/
 /*-------------- METHODS FOR INITIALIZING THE ThermalUnitBlock -------------*/
 /*--------------------------------------------------------------------------*/
@@ -1640,6 +1674,9 @@ class ThermalUnitBlock : public UnitBlock
 /*--------------------- PROTECTED METHODS OF THE CLASS ---------------------*/
 /*--------------------------------------------------------------------------*/
 
+ /// copies the data of the ThermalUnitBlock out of \p from, see clone()
+ void clone_data( const ThermalUnitBlock & from );
+
  /// updates the abstract representation dependent on the availability
  /** This method updates any part of the abstract representation that may
   * depend on the availability of the unit at the given time \p t.
@@ -2155,7 +2192,7 @@ class ThermalUnitBlockMod : public UnitBlockMod
 
  /// constructor, takes the ThermalUnitBlock and the type
  ThermalUnitBlockMod( ThermalUnitBlock * const fblock , const int type )
-  : UnitBlockMod( fblock , type ) {}
+  : UnitBlockMod( fblock , type , eThermalUnitBlockModFamily ) {}
 
  /// destructor, does nothing
  virtual ~ThermalUnitBlockMod() override = default;
@@ -41,6 +41,8 @@
 
 #include "ThermalUnitBlock.h"
 
+#include <atomic>
+
 /*--------------------------------------------------------------------------*/
 /*----------------------------- NAMESPACE ----------------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -275,6 +277,61 @@ class ThermalUnitDPSolver : public Solver
  /// returns the value of the current solution, if any
  OFValue get_var_value( void ) override { return( f_end.lab ); }
 
+/** @} ---------------------------------------------------------------------*/
+/*-------------------- HANDLING THE FIXED-HORIZON KERNELS ------------------*/
+/*--------------------------------------------------------------------------*/
+/** @name Handling the fixed-horizon kernels
+ * @{ */
+
+ /// tells if the Economic Dispatch for the time horizon has a fixed kernel
+ /** Most instances have a time horizon of 24, 48, 96 or 168 time instants.
+  * For these the Economic Dispatch of each ON node (see
+  * DPEDSolver::compute_costs()) is solved by a version of the code compiled
+  * for that horizon, which keeps its work arrays on the stack rather than
+  * in each DPEDSolver: this saves the O( time_horizon^2 ) memory of the
+  * graph. The code itself is the same as the generic one, only with the
+  * time horizon known at compile time; no speed-up is claimed for it, the
+  * "ThermalUnitDPSolver" stages of ucblock_bench measure the two. Any
+  * other time horizon is handled by the generic code. */
+
+ static constexpr bool is_fixed_horizon( Index T ) {
+  return( ( T == 24 ) || ( T == 48 ) || ( T == 96 ) || ( T == 168 ) );
+  }
+
+ /// enables or disables the fixed-horizon kernels (default: enabled)
+ /** Enables or disables the fixed-horizon kernels (see is_fixed_horizon())
+  * for all the ThermalUnitDPSolver; this is mostly meant for benchmarking,
+  * as the two codes produce the same results. The setting is atomic, and
+  * it is only read when compute() (re)builds the graph, which surely
+  * happens at the first compute() after set_Block(): changing it while
+  * compute() is running in other threads is safe, and only affects the
+  * graphs built afterwards. */
+
+ static void set_fixed_horizon_kernels( bool fixed ) {
+  f_fixed_horizon_kernels.store( fixed , std::memory_order_relaxed );
+  }
+
+ /// tells if the fixed-horizon kernels are enabled
+ static bool get_fixed_horizon_kernels( void ) {
+  return( f_fixed_horizon_kernels.load( std::memory_order_relaxed ) );
+  }
+
+/** @} ---------------------------------------------------------------------*/
+/*-------------------------- HANDLING THE MEMORY ---------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @name Handling the memory
+ * @{ */
+
+ /// returns the (estimated) number of bytes held by the solver
+ /** Returns the (estimated) number of bytes held by the ThermalUnitDPSolver,
+  * comprised the graph and the EDSolver of all its ON nodes; this is
+  * reported by ThermalUnitBlock::get_memory_usage() as MemoryUsage::solver.
+  * Must not be called while compute() is running. */
+
+ std::size_t get_memory_usage( void ) const;
+
+/** @} ---------------------------------------------------------------------*/
+
 /*--------------------------------------------------------------------------*/
 /*-------------------- PROTECTED FIELDS OF THE CLASS -----------------------*/
 /*--------------------------------------------------------------------------*/
@@ -396,6 +453,11 @@ class ThermalUnitDPSolver : public Solver
   virtual void compute_power_variables( Index k ,
                                         std::vector< double > & p ) = 0;
 
+/*--------------------------------------------------------------------------*/
+  /// returns the number of bytes held by the EDSolver (beyond its sizeof)
+
+  virtual std::size_t get_memory_usage( void ) const { return( 0 ); }
+
 /*--------------------------------------------------------------------------*/
 /*-------------------- PRIVATE FIELDS OF THE CLASS -------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -441,6 +503,8 @@ class ThermalUnitDPSolver : public Solver
 
   void compute_power_variables( Index k , std::vector< double > & p ) override;
 
+  std::size_t get_memory_usage( void ) const override;
+
 /*--------------------------------------------------------------------------*/
 /*-------------------- PRIVATE FIELDS OF THE CLASS -------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -476,6 +540,18 @@ class ThermalUnitDPSolver : public Solver
   std::vector< double > m;
   std::vector< int > v;
 
+  /// the code of compute_costs(), for a time horizon of T (0 = generic)
+  /** The code of compute_costs() for a time horizon of T, or for any time
+   * horizon if T == 0, working on the given coeffs[] and m[] arrays. */
+
+  template< Index T >
+  void compute_costs_T( std::vector< double > & costs , coeff_t * cf ,
+                        double * mp );
+
+  /// compute_costs() for a fixed horizon T, with coeffs[] and m[] on stack
+  template< Index T >
+  void compute_costs_fixed( std::vector< double > & costs );
+
  };  // end( class( DPEDSolver ) );
 
 /*--------------------------------------------------------------------------*/
@@ -617,6 +693,9 @@ class ThermalUnitDPSolver : public Solver
  std::vector< double > P;          ///< power values
  std::vector< bool > U;            ///< commitment values
 
+ /// true if the fixed-horizon kernels are used, see is_fixed_horizon()
+ static std::atomic< bool > f_fixed_horizon_kernels;
+
  SMSpp_insert_in_factory_h;
 
 /*--------------------------------------------------------------------------*/
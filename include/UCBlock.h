@@ -53,6 +53,18 @@
 
 #include "FRowConstraint.h"
 
+#include <atomic>
+
+#include <cstdint>
+
+#include <map>
+
+#include <memory>
+
+#include <mutex>
+
+#include <set>
+
 /*--------------------------------------------------------------------------*/
 /*--------------------------- NAMESPACE ------------------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -143,6 +155,139 @@ class UCBlock : public Block
  public:
 
 /*--------------------------------------------------------------------------*/
+/*---------------------------- PUBLIC TYPES --------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @name Public types
+ * @{ */
+
+ /// storage options for serialize( netCDF::NcGroup & , const NcStorage & )
+ /** Describes how the netCDF variables are physically stored. This does not
+  * change their content, only the size of the file and the time needed to
+  * write and read it, which depend on the data (see the README for how to
+  * measure them):
+  *
+  * - deflate_level goes from 0 (no compression, the default) to 9
+  *   (maximum compression);
+  *
+  * - shuffle tells whether the byte shuffle filter is applied before
+  *   deflate;
+  *
+  * - time_chunk is the extent of the chunks along the "time" dimensions
+  *   ("TimeHorizon" and "NumberIntervals"), 0 meaning the whole dimension;
+  *
+  * - chunks gives the chunk shape explicitly for some variables, by name.
+  *   A shape whose size differs from the number of dimensions of the
+  *   variable is ignored;
+  *
+  * - jobs is the number of processes serializing the sub-Block, see
+  *   serialize( netCDF::NcGroup & , const NcStorage & ); it does not
+  *   change the output.
+  *
+  * Unless given explicitly, the chunks of a variable with a time dimension
+  * are "time-major": a chunk spans time_chunk instants (by default all of
+  * them) of a single entry of every other dimension. The time profile of a
+  * single unit / node / zone is therefore contiguous on disk, and reading
+  * it (or a window of it) touches as few chunks as possible. If such a
+  * chunk has fewer than kMinChunk elements, it is grown along the non-time
+  * dimensions, last first. A variable without a time dimension is a single
+  * chunk. */
+
+ struct NcStorage {
+  static constexpr std::size_t kMinChunk = 8192;
+  ///< minimum number of elements of a default chunk
+
+  int deflate_level = 0;  ///< deflate level, 0 (none) ... 9
+  bool shuffle = false;   ///< whether the shuffle filter is applied
+  Index time_chunk = 0;   ///< chunk extent along time, 0 = all
+  std::map< std::string , std::vector< std::size_t > > chunks;
+  ///< explicit chunk shapes, by variable name
+  unsigned int jobs = 1;  ///< processes serializing the sub-Block
+ };
+
+ /// selection for deserialize( const netCDF::NcGroup & , const NcSelection & )
+ /** Describes which part of a UCBlock netCDF group is loaded:
+  *
+  * - units contains the indices of the UnitBlock to be loaded, empty
+  *   meaning all of them;
+  *
+  * - unit_types contains the classnames (the "type" attribute of the
+  *   UnitBlock_i group) of the UnitBlock to be loaded, empty meaning all
+  *   of them; a UnitBlock is loaded if it passes both filters;
+  *
+  * - [ t0 , t1 ) is the time window to be loaded, t1 being capped to
+  *   TimeHorizon;
+  *
+  * - initial_at_t0 tells that the initial conditions in the file (initial
+  *   power, up/down time, storage level, ...) are those holding before t0
+  *   rather than before 0, which is required if t0 > 0 and any of them is
+  *   there. */
+
+ struct NcSelection {
+  std::vector< Index > units;             ///< selected unit indices
+  std::vector< std::string > unit_types;  ///< selected unit classnames
+  Index t0 = 0;                           ///< first loaded time instant
+  Index t1 = Inf< Index >();              ///< first time instant not loaded
+  bool initial_at_t0 = false;             ///< initial conditions hold at t0
+ };
+
+ /// summary of the violations of a family, see check_feasibility()
+ /** Describes the outcome of the feasibility check of a family, that is
+  * either a family of linking constraints of the UCBlock (say,
+  * "NodeInjection") or the sub-Block of the UCBlock with a given classname
+  * (say, "ThermalUnitBlock"):
+  *
+  * - rows is the number of checked constraints, or of sub-Block;
+  *
+  * - violated is the number of those that are violated (by more than the
+  *   tolerance), or of sub-Block that are not feasible;
+  *
+  * - max_violation is the largest violation of a constraint of the family,
+  *   always 0 for the sub-Block (whose is_feasible() only returns a bool). */
+
+ struct ViolationSummary {
+  std::string family;        ///< name of the family
+  Index rows = 0;            ///< number of checked constraints / sub-Block
+  Index violated = 0;        ///< number of violated ones
+  double max_violation = 0;  ///< largest violation of a constraint
+ };
+
+ /// a candidate schedule, see evaluate_cost()
+ /** A candidate schedule of the UCBlock given as plain arrays, without
+  * using its Variable. Each of commitment, active_power, start_up,
+  * primary_reserve and secondary_reserve is indexed over the electrical
+  * generators and the time instants, in this order: the entry g * T + t,
+  * with T = get_time_horizon(), is the value of the generator g at time t,
+  * the generators being numbered as in the "GeneratorNode" variable (that
+  * is, all the generators of UnitBlock 0, then those of UnitBlock 1, ...).
+  * The arrays of the generators that do not have the corresponding
+  * Variable (say, the commitment of a BatteryUnitBlock) are ignored.
+  *
+  * commitment and active_power are mandatory. The other ones may be empty:
+  * an empty start_up is computed from commitment (a start-up happening when
+  * the commitment goes from 0 to 1, comprised at time 0 w.r.t. the initial
+  * status of the unit), and an empty reserve array means no reserve.
+  *
+  * intake and outtake are the intake and outtake power of the
+  * BatteryUnitBlock, whose active power is intake - outtake; they are
+  * either both empty or both given. If they are empty, the intake is
+  * max( 0 , p ) and the outtake max( 0 , -p ) for an active power p.
+  *
+  * power_flow, if not empty, contains the power flow on all the lines of
+  * the first DCNetworkBlock, then on those of the second one, ..., and is
+  * only needed for the line costs of the DCNetworkBlock. */
+
+ struct Schedule {
+  std::vector< double > commitment;         ///< commitment, [ G ][ T ]
+  std::vector< double > active_power;       ///< active power, [ G ][ T ]
+  std::vector< double > start_up;           ///< start-up, [ G ][ T ]
+  std::vector< double > primary_reserve;    ///< primary reserve, [ G ][ T ]
+  std::vector< double > secondary_reserve;  ///< secondary reserve, [ G ][ T ]
+  std::vector< double > intake;             ///< battery intake, [ G ][ T ]
+  std::vector< double > outtake;            ///< battery outtake, [ G ][ T ]
+  std::vector< double > power_flow;         ///< line flows, [ N ][ L ]
+ };
+
+/** @} ---------------------------------------------------------------------*/
 /*--------------------- CONSTRUCTOR AND DESTRUCTOR -------------------------*/
 /*--------------------------------------------------------------------------*/
 /** @name Constructor and Destructor
@@ -513,10 +658,70 @@ class UCBlock : public Block
  * - The variable "NetworkDataClassname", of type netCDF::NcString specify
  *   the classname of the specific NetworkData to be instantiate. For backward
  *   compatibility reasons w.r.t. the netCDF input data files already given,
- *   the default value is "DCNetworkData". */
+ *   the default value is "DCNetworkData".
+ *
+ * - The optional netCDF::NcUint64 attribute "Validated"; if it is present
+ *   and equal to data_checksum( group ), the data of the group is assumed
+ *   to have already been checked (typically, by the ucblock_validate tool),
+ *   and the checks on the netCDF dimensions and variables of the UCBlock
+ *   and of its UnitBlock (only done if NDEBUG is not defined), as well as
+ *   the data consistency checks of the UnitBlock, are skipped. Only the
+ *   metadata of the group are read for this, since the checksum covers its
+ *   structure (dimensions, names, types and shapes of the variables,
+ *   attributes) but not the values of its variables: any change to the
+ *   former (typically, regenerating the file) makes the attribute void,
+ *   and the checks are done again, while a change to the latter that keeps
+ *   the structure is only found by "ucblock_validate --verify", which
+ *   compares all the data with the "ValidatedContent" attribute written
+ *   together with "Validated". The attributes whose name starts with
+ *   "Validated" are never copied by copy_nc_group(). See
+ *   set_trust_validated(). */
 
  void deserialize( const netCDF::NcGroup & group ) override;
 
+/*--------------------------------------------------------------------------*/
+ /// deserialize a part of a UCBlock, see NcSelection
+ /** Loads the smaller UCBlock made of the UnitBlock and of the time window
+  * given by \p selection out of \p group, which has the format described
+  * in deserialize( netCDF::NcGroup ). The UnitBlock are renumbered in their
+  * original order, and time instant t0 becomes time instant 0.
+  *
+  * Only the needed hyperslabs of the netCDF variables are read, by
+  * getVar( start , count ) on the window and on the runs of generators of
+  * the selected UnitBlock. The data of the UCBlock group, and that of the
+  * UnitBlock if the window is not the whole horizon, is restricted into a
+  * scratch in-memory netCDF-4 file, which is then loaded with
+  * deserialize( netCDF::NcGroup ); the NetworkBlock, and the UnitBlock if
+  * the window is the whole horizon, are rather loaded straight out of
+  * \p group, with no copy. In the restricted data:
+  *
+  * - every variable indexed over "TimeHorizon" (or over "NumberIntervals",
+  *   if it has size TimeHorizon) is restricted to the window, in the
+  *   UCBlock group and in all the UnitBlock_i groups;
+  *
+  * - "GeneratorNode" and "PollutantRho" only keep the electrical generators
+  *   of the selected UnitBlock. Unless "NumberElectricalGenerators" ==
+  *   "NumberUnits" (which means that each UnitBlock has one generator),
+  *   the number of generators of each UnitBlock is found out of the
+  *   dimensions of its group (see number_generators()), without loading
+  *   it;
+  *
+  * - the NetworkBlock and "StartNetworkIntervals", "NetworkConstantTerms"
+  *   only keep the networks spanning the window, which therefore must not
+  *   split any of them.
+  *
+  * A UnitBlock whose data changes over 1 < "NumberIntervals" < TimeHorizon
+  * intervals can only be loaded for the whole horizon. The initial
+  * conditions of the UnitBlock (the variables whose name starts with
+  * "Init") are copied as they are: since those in the file hold before time
+  * 0, and those before t0 depend on the solution over [ 0 , t0 ), if t0 > 0
+  * and any selected UnitBlock has some of them std::invalid_argument is
+  * thrown, unless selection.initial_at_t0 tells that the file has already
+  * been updated with the initial conditions at t0. */
+
+ void deserialize( const netCDF::NcGroup & group ,
+                   const NcSelection & selection );
+
 /*--------------------------------------------------------------------------*/
  /// generates the static constraint of the UCBlock
  /** This method generates the abstract constraints of the UCBlock.
@@ -738,6 +943,53 @@ class UCBlock : public Block
 
  Index get_number_units( void ) const { return( f_number_units ); }
 
+/*--------------------------------------------------------------------------*/
+ /// tells whether the data of the UCBlock has been read as validated
+ /** Returns true if the UCBlock has been deserialized out of a netCDF group
+  * with a matching "Validated" attribute while get_trust_validated() was
+  * true, hence the checks on its data (and on that of its UnitBlock) have
+  * been skipped. Any call to apply_delta() (hence, new_from_delta())
+  * resets it to false, since the data are then no longer those that have
+  * been validated. */
+
+ bool is_validated( void ) const { return( f_validated ); }
+
+/*--------------------------------------------------------------------------*/
+ /// sets whether the "Validated" attribute of a netCDF group is honoured
+ /** Sets whether the "Validated" attribute of the netCDF groups (see
+  * deserialize( netCDF::NcGroup )) is honoured by all the UCBlock
+  * deserialized from then on; it is true by default. Setting it to false
+  * forces the checks on all the data, as done by the ucblock_validate
+  * tool. */
+
+ static void set_trust_validated( bool trust ) {
+  f_trust_validated = trust;
+ }
+
+/*--------------------------------------------------------------------------*/
+ /// tells whether the "Validated" attribute of a netCDF group is honoured
+
+ static bool get_trust_validated( void ) { return( f_trust_validated ); }
+
+/*--------------------------------------------------------------------------*/
+ /// returns a checksum of the netCDF group
+ /** Returns a 64-bit FNV-1a checksum of the names and sizes of all the
+  * dimensions of group, of the names, types and dimensions of all its
+  * variables, of all the attributes of both (but those whose name starts
+  * with "Validated") and (recursively) of all its sub-groups. This only
+  * reads the metadata of group, and it is the value that the "Validated"
+  * attribute must have for the data of group to be trusted (see
+  * deserialize( netCDF::NcGroup )).
+  *
+  * If \p content is true, the values of all the variables (strings and
+  * variable-length ones included) are also fed to the checksum, which then
+  * requires reading all the data of group once; this is the value of the
+  * "ValidatedContent" attribute, which is only checked by the
+  * ucblock_validate tool. */
+
+ static std::uint64_t data_checksum( const netCDF::NcGroup & group ,
+                                     bool content = false );
+
 /*--------------------------------------------------------------------------*/
  /// returns the number of primary zones of the problem
 
@@ -1284,6 +1536,426 @@ class UCBlock : public Block
   return( true );
  }
 
+/**@} ----------------------------------------------------------------------*/
+/*--------------- METHODS FOR HANDLING THE DESIGN VARIABLES ----------------*/
+/*--------------------------------------------------------------------------*/
+/** @name Methods for handling the design variables of the UCBlock
+ *
+ * In the design (capacity expansion) scenario of the UC problem, some of
+ * the UnitBlock have "design" variables (see
+ * UnitBlock::get_number_design_variables()) linked to their operational
+ * variables at all time instants. These methods expose all of them at the
+ * UCBlock level, so that the investment and the operation problems can be
+ * separated in a Benders-like fashion: the master problem decides on the
+ * design variables, and the operational problem of each UCBlock (e.g., one
+ * per representative period, possibly solved in parallel by separate
+ * Solver) is then obtained by fixing them to the master values, which
+ * turns all the design linking rows into simple bounds. The dual values of
+ * the linking rows at the operational optimum then give the Benders cut.
+ * @{ */
+
+ /// returns all the design variables of the UnitBlock of the UCBlock
+ /** This method returns a vector with (pointers to) all the design
+  * variables of all the UnitBlock of the UCBlock, in the order of the
+  * UnitBlock and, within each UnitBlock, in the order given by
+  * UnitBlock::get_design_variable(). The vector is empty if no UnitBlock
+  * has any investment cost. The variables only are meaningful after
+  * generate_abstract_variables() has been called. */
+
+ std::vector< ColVariable * > get_design_variables( void );
+
+/*--------------------------------------------------------------------------*/
+ /// fixes all the design variables to the given values
+ /** This method sets the values of all the design variables (in the order
+  * of get_design_variables()) to those in \p values, which must have the
+  * same size, and fixes them. This gives the operational problem for the
+  * given investment decisions. Design variables that are already fixed
+  * (e.g., that of a ThermalUnitBlock which is forced to be on at the
+  * beginning of the time horizon) are left untouched, and the
+  * corresponding entries of \p values are ignored.
+  *
+  * @param values The values of the design variables.
+  *
+  * @param issueAMod Decides if and how the "abstract Modification" caused
+  *        by fixing the variables are issued. */
+
+ void fix_design_variables( const std::vector< double > & values ,
+                            ModParam issueAMod = eModBlck );
+
+/*--------------------------------------------------------------------------*/
+ /// unfixes all the design variables
+ /** This method unfixes all the design variables that have been fixed by
+  * the last call to fix_design_variables(), thereby restoring the full
+  * capacity expansion problem.
+  *
+  * @param issueAMod Decides if and how the "abstract Modification" caused
+  *        by unfixing the variables are issued. */
+
+ void unfix_design_variables( ModParam issueAMod = eModBlck );
+
+/**@} ----------------------------------------------------------------------*/
+/*------------------- METHODS FOR COMPUTING A SOLUTION ---------------------*/
+/*--------------------------------------------------------------------------*/
+/** @name Methods for computing a (heuristic) solution of the UCBlock
+ * @{ */
+
+ /// computes a merit-order solution and writes it into the Variable
+ /** This method computes a fast, deterministic heuristic solution of the
+  * UC problem and writes it into the (already generated) Variable of the
+  * UnitBlock, where it can be used as a warm start. The heuristic works on
+  * the aggregated (single-node, single-zone) version of the problem and
+  * proceeds as follows:
+  *
+  * - the IntermittentUnitBlock are dispatched at their maximum power
+  *   (curtailed proportionally if this exceeds the demand), and the
+  *   remaining ActivePowerDemand is the net demand to be covered;
+  *
+  * - the ThermalUnitBlock are sorted in a merit order by their average
+  *   cost per unit of energy at maximum power, comprised the constant term
+  *   and the start-up cost spread over the minimum up time;
+  *
+  * - for each time instant, units are committed greedily in merit order
+  *   until the committed capacity covers the net demand plus the primary
+  *   and secondary reserve requirements, and the inertia they provide
+  *   covers the inertia requirement; units whose state is forced by the
+  *   initial conditions are kept in that state;
+  *
+  * - the commitment of each unit is then repaired, first extending the
+  *   up periods shorter than the minimum up time and then closing the down
+  *   periods shorter than the minimum down time;
+  *
+  * - finally, for each time instant the committed units are dispatched at
+  *   their minimum power and the rest of the net demand is covered in merit
+  *   order, after which the primary and secondary reserves are allocated
+  *   from the remaining headroom (within the PrimaryRho and SecondaryRho
+  *   fractions of the produced power).
+  *
+  * The commitment, start-up, shut-down, active power and reserve Variable
+  * of the ThermalUnitBlock and the active power Variable of the
+  * IntermittentUnitBlock are set, all the other ones are left untouched.
+  * Ramping constraints, the network and the zonal structure of the
+  * requirements are ignored, hence the solution need not be feasible: it is
+  * just meant to be a good starting point. The cost is O( U log U + U T ),
+  * U being the number of units. */
+
+ void merit_order_heuristic( void );
+
+/**@} ----------------------------------------------------------------------*/
+/*-------------- METHODS FOR CHECKING SOLUTION INFORMATION -----------------*/
+/*--------------------------------------------------------------------------*/
+/** @name Methods for checking the solution of the UCBlock
+ * @{ */
+
+ /// returns true if the current solution is (approximately) feasible
+ /** Returns true if the current solution of the UCBlock is feasible within
+  * the given tolerance, that is, if the linking constraints of the UCBlock
+  * (node injection, primary, secondary and inertia demand and pollutant
+  * budget) are not violated by more than the tolerance and all the
+  * sub-Block are feasible (according to their own is_feasible()). This is
+  * check_feasibility() without the summary and with a single thread, i.e.,
+  * the sub-Block are checked in the calling thread; see it for details, and
+  * for the meaning of \p fsbc. The parameter \p useabstract is passed to
+  * the is_feasible() of the sub-Block. */
+
+ bool is_feasible( bool useabstract = false ,
+                   Configuration * fsbc = nullptr ) override;
+
+/*--------------------------------------------------------------------------*/
+ /// checks the current solution, possibly reporting the violations
+ /** Checks whether the current solution of the UCBlock is feasible, as in
+  * is_feasible(). The tolerance and the type of violation are given by
+  * \p fsbc or by f_BlockConfig->f_is_feasible_Configuration as in
+  * ThermalUnitBlock::is_feasible(), the same \p fsbc being passed to the
+  * is_feasible() of the sub-Block. Each linking constraint is computed
+  * (Constraint::compute()) before being checked; the linking constraints
+  * that have not been generated are not checked.
+  *
+  * The sub-Block are checked by a pool of \p threads threads (0 meaning
+  * std::thread::hardware_concurrency()), one of which is the calling one
+  * and also checks the linking constraints. This requires the is_feasible()
+  * of the sub-Block to be thread-safe, i.e., to only touch the data of the
+  * sub-Block itself, which is the case for all the UnitBlock and
+  * NetworkBlock of this library; it is the caller's responsibility to only
+  * ask for more than one thread if this also holds for any other sub-Block
+  * of the UCBlock. If any of them, or the computation of a linking
+  * constraint, throws, the exception is rethrown after all the threads have
+  * stopped.
+  *
+  * If \p summary is nullptr, the check stops at the first violation that
+  * is found, hence its cost is typically much smaller for an infeasible
+  * solution than for a feasible one. Otherwise, everything is checked, and
+  * *summary is filled with one ViolationSummary per family: first the
+  * families of linking constraints that have been generated, then the
+  * sub-Block grouped by classname, in alphabetical order.
+  *
+  * @param summary If not nullptr, where the violations are reported.
+  *
+  * @param fsbc The Configuration with the tolerance and type of violation.
+  *
+  * @param threads The number of threads checking the sub-Block; the default
+  *        1 checks them in the calling thread.
+  *
+  * @param useabstract Passed to the is_feasible() of the sub-Block. */
+
+ bool check_feasibility( std::vector< ViolationSummary > * summary = nullptr ,
+                         Configuration * fsbc = nullptr ,
+                         unsigned int threads = 1 ,
+                         bool useabstract = false );
+
+/**@} ----------------------------------------------------------------------*/
+/*------------------- METHODS FOR EVALUATING A SCHEDULE --------------------*/
+/*--------------------------------------------------------------------------*/
+/** @name Methods for evaluating the cost of a candidate schedule
+ *
+ * These methods compute the operational cost of a candidate schedule given
+ * as a Schedule, i.e., as plain arrays, reading the cost data of the
+ * UnitBlock and NetworkBlock directly rather than writing the schedule into
+ * the Variable and computing the Objective. This is meant for heuristics
+ * that rank many candidate schedules, and works whether or not the abstract
+ * representation of the UCBlock has been generated. The cost is the one of
+ * the Objective of the sub-Block, without the investment costs of the
+ * design variables, i.e.:
+ *
+ * - for a ThermalUnitBlock, the sum over t of the start-up cost (for t not
+ *   smaller than the initial time step for which the start-up is fixed by
+ *   the initial conditions), the constant, linear and quadratic terms, and
+ *   the primary and secondary spinning reserve costs, times the scale;
+ *
+ * - for a BatteryUnitBlock, the sum over t of the cost times the intake
+ *   power plus the cost times the outtake power (see Schedule), times the
+ *   scale, with the same signed coefficients as in its Objective;
+ *
+ * - for a SlackUnitBlock, the sum over t of the active power, primary,
+ *   secondary and inertia costs, the latter being paid for the maximum
+ *   inertia whenever the commitment is nonzero;
+ *
+ * - for a NetworkBlock, its constant term plus, for a DCNetworkBlock, the
+ *   sum of the line costs times the absolute value of the flows (only if
+ *   Schedule::power_flow is given).
+ *
+ * The other UnitBlock (IntermittentUnitBlock, HydroUnitBlock, ...) have no
+ * operational cost. The terms that a Schedule does not describe are not
+ * supported: exception is thrown if a HydroSystemUnitBlock has the
+ * PolyhedralFunctionBlock giving the future value of water, or if there is
+ * an ECNetworkBlock. The feasibility of the schedule is not checked.
+ *
+ * All the methods only read the data of the UCBlock, which must not be
+ * changed while they run.
+ * @{ */
+
+ /// returns the cost of the given schedule
+ /** Returns the cost of \p schedule, see above. The cost is O( G T ), G
+  * being the number of electrical generators. Exception is thrown if an
+  * array of \p schedule has the wrong size, or if the UCBlock has a term
+  * that is not supported (see above). */
+
+ double evaluate_cost( const Schedule & schedule ) const;
+
+/*--------------------------------------------------------------------------*/
+ /// returns the costs of the given schedules, using multiple threads
+ /** Returns the vector whose i-th element is evaluate_cost( schedules[ i ] ),
+  * the schedules being split among \p threads threads (0 meaning
+  * std::thread::hardware_concurrency()). If any evaluation throws, the
+  * exception is rethrown after all the threads have stopped. */
+
+ std::vector< double > evaluate_costs( const std::vector< Schedule > &
+                                        schedules ,
+                                       unsigned int threads = 0 ) const;
+
+/**@} ----------------------------------------------------------------------*/
+/*---------------- METHODS FOR SAVING AND RESTORING A SOLUTION -------------*/
+/*--------------------------------------------------------------------------*/
+/** @name Methods for saving and restoring a solution of the UCBlock
+ *
+ * These methods save the current values of the main Variable of the UCBlock
+ * into a compact netCDF group, and write them back, e.g., to warm-start the
+ * next run of a near-identical instance. The format is made of dense
+ * arrays of double, where NaN marks the entries whose Variable does not
+ * exist (say, the commitment of an IntermittentUnitBlock):
+ *
+ * - the dimensions "TimeHorizon", "NumberElectricalGenerators" and,
+ *   if nonzero, "NumberStorages" (see UnitBlock::get_number_storages())
+ *   and "NumberNodes";
+ *
+ * - the variables "Commitment", "ActivePower", "PrimaryReserve" and
+ *   "SecondaryReserve", indexed over "NumberElectricalGenerators" and
+ *   "TimeHorizon", with the generators numbered as in "GeneratorNode";
+ *
+ * - the variable "Storage", indexed over "NumberStorages" and "TimeHorizon",
+ *   with the storages numbered in the order of the UnitBlock;
+ *
+ * - the variable "NodeInjection", indexed over "TimeHorizon" and
+ *   "NumberNodes", if the UCBlock has NetworkBlock;
+ *
+ * - optionally, the variables "NodeInjectionDual", "PrimaryDemandDual",
+ *   "SecondaryDemandDual" and "InertiaDemandDual" with the dual values of
+ *   the corresponding linking constraints, indexed over "TimeHorizon" and,
+ *   respectively, "NumberNodes", "NumberPrimaryZones",
+ *   "NumberSecondaryZones" and "NumberInertiaZones".
+ *
+ * A variable of the group is only written if at least one of its entries
+ * exists. The time profile of each row is a single chunk, compressed with
+ * deflate and shuffle, so that the typical (mostly 0/1 or constant) profiles
+ * take little space.
+ * @{ */
+
+ /// saves the current solution of the UCBlock into the given group
+ /** Saves the current solution of the UCBlock into \p group, with the format
+  * described above. The Variable (and, if \p duals is true, the
+  * Constraint) of the UCBlock must have been generated.
+  *
+  * @param group The netCDF group where the solution is saved.
+  *
+  * @param duals If true, the dual values of the linking constraints are
+  *        saved as well.
+  *
+  * @param deflate_level The deflate level of the variables, from 0 (no
+  *        compression) to 9. */
+
+ void serialize_solution( netCDF::NcGroup & group , bool duals = false ,
+                          int deflate_level = 1 ) const;
+
+/*--------------------------------------------------------------------------*/
+ /// restores a solution of the UCBlock from the given group
+ /** Writes the solution saved in \p group by serialize_solution() into the
+  * Variable (and, if \p duals is true, into the dual values of the linking
+  * constraints) of the UCBlock. The dimensions of \p group must match those
+  * of the UCBlock, otherwise exception is thrown. Each netCDF variable is
+  * read in one go, after which the values are written straight into the
+  * ColVariable; the NaN entries, and the netCDF variables that are not in
+  * \p group, are skipped, i.e., the corresponding Variable keep their
+  * current value. No Modification is issued. */
+
+ void deserialize_solution( const netCDF::NcGroup & group ,
+                            bool duals = true );
+
+/**@} ----------------------------------------------------------------------*/
+/*------------------- METHODS FOR HANDLING INSTANCE VARIANTS ---------------*/
+/*--------------------------------------------------------------------------*/
+/** @name Methods for handling instance variants
+ *
+ * A "delta" netCDF group describes a variant of a base UCBlock instance by
+ * only storing the arrays that differ from the base. Its format is:
+ *
+ * - the string attribute "BaseFile" with the name of the netCDF file
+ *   containing the base instance; a relative name is relative to the
+ *   directory of the delta file;
+ *
+ * - the optional string attribute "BaseGroup" with the name of the group of
+ *   "BaseFile" holding the base UCBlock; if not present, "Block_0" is used;
+ *
+ * - the optional variable "ActivePowerDemand";
+ *
+ * - the optional groups "UnitBlock_k", where k is the index of a UnitBlock
+ *   of the base instance, each containing variables among "MaxPower",
+ *   "Availability", "LinearTerm", "QuadTerm", "ConstTerm", "StartUpCost",
+ *   "InitialPower" (ThermalUnitBlock), "MaxPower", "Kappa"
+ *   (IntermittentUnitBlock), "Inflows" (HydroUnitBlock), "InitialStorage",
+ *   "InitialPower" and "Kappa" (BatteryUnitBlock).
+ *
+ * Each variable of the delta is one-dimensional, with any name for its
+ * dimension, and has the same meaning as the variable with the same name
+ * in the base instance, of which it replaces a contiguous slice: if the
+ * optional integer attribute "Start" of the variable (of any integer type,
+ * serialize_delta() writing it as NC_UINT64) is s (0 if not present) and
+ * its size is n, it replaces the entries s, ..., s + n - 1 of the base
+ * array, taken in row-major order and with the time profiles given as a
+ * single value expanded to the whole TimeHorizon. The delta is
+ * applied to the UCBlock by means of the corresponding set_*() method
+ * (set_active_power_demand(), ThermalUnitBlock::set_maximum_power(), ...),
+ * hence these methods can be used on an UCBlock that is already being
+ * solved and the size of the delta, and the time needed to apply it, only
+ * depend on the size of the change.
+ * @{ */
+
+ /// applies the given delta group to the UCBlock
+ /** Applies the delta in \p delta (see above; the "BaseFile" and
+  * "BaseGroup" attributes are ignored) to the UCBlock, by calling the
+  * set_*() method corresponding to each of its variables with the given
+  * \p issuePMod and \p issueAMod. If \p delta contains any variable or group
+  * that is not described above, or a variable does not fit the base array,
+  * exception is thrown. */
+
+ void apply_delta( const netCDF::NcGroup & delta ,
+                   ModParam issuePMod = eNoBlck ,
+                   ModParam issueAMod = eNoBlck );
+
+/*--------------------------------------------------------------------------*/
+ /// writes the delta between two UCBlock groups
+ /** Writes into \p delta the variables (see above) describing the variant
+  * \p variant of the base instance \p base, both being netCDF groups with
+  * the format of UCBlock::deserialize(). Only the variables and groups that
+  * can be set by apply_delta() are compared, and each variable that differs
+  * is written as the smallest slice containing all the differences. The
+  * attributes "BaseFile" and "BaseGroup" are not written, since only the
+  * caller knows where \p base is stored. If a variable of \p variant is not
+  * present in \p base, it is written whole; if it has a different size
+  * than that of \p base (not counting a time profile given as a single
+  * value), or it is present in \p base but not in \p variant (which a
+  * delta cannot express), or \p variant has different "UnitBlock_k" groups
+  * than \p base, exception is thrown. */
+
+ static void serialize_delta( const netCDF::NcGroup & base ,
+                              const netCDF::NcGroup & variant ,
+                              netCDF::NcGroup & delta );
+
+/*--------------------------------------------------------------------------*/
+ /// loads an UCBlock out of a delta file
+ /** Reads the base UCBlock named by the "BaseFile" and "BaseGroup"
+  * attributes of the netCDF file \p filename, and applies to it the delta
+  * in the root group of that file with apply_delta(). The returned UCBlock
+  * is owned by the caller. Exception is thrown if the files cannot be read
+  * or the base group does not contain an UCBlock. */
+
+ static UCBlock * new_from_delta( const std::string & filename );
+
+/**@} ----------------------------------------------------------------------*/
+/*--------------------- METHODS FOR CLONING THE UCBlock --------------------*/
+/*--------------------------------------------------------------------------*/
+/** @name Methods for cloning the UCBlock
+ *
+ * These methods make independent copies of an UCBlock, e.g., one for each
+ * thread of a parallel what-if analysis, without reading the netCDF file
+ * again.
+ * @{ */
+
+ /// returns a copy of the UCBlock
+ /** Returns a new UCBlock, with father \p father, having the same data as
+  * this one, i.e., what deserialize() has read, as changed since by the
+  * set_*() methods. The UnitBlock and NetworkBlock are copied with
+  * UnitBlock::clone() and NetworkBlock::clone(), and the NetworkData by
+  * NetworkBlock::NetworkData::clone(), so that the copy shares nothing
+  * with this UCBlock and can be changed and solved concurrently with it.
+  * All the data is copied, that which no set_*() method can change
+  * included, hence the copy takes as much memory as this UCBlock. The
+  * BlockConfig of this UCBlock and of each sub-Block, if any, is copied
+  * (by BlockConfig::clone()) as well. All is done in memory, with no netCDF
+  * involved: exception is thrown if a sub-Block is of a class whose
+  * clone() is not implemented.
+  *
+  * The abstract representation is *not* copied: that of the new UCBlock
+  * (and of its sub-Block) is generated, if ever, by the
+  * generate_abstract_*() methods exactly as for a just deserialized one,
+  * typically when a Solver is registered to it. Neither are the registered
+  * Solver and the Solution. The HeatBlock, currently not handled by
+  * deserialize(), are not copied either. The returned UCBlock is owned by
+  * the caller. */
+
+ UCBlock * clone( Block * father = nullptr ) const;
+
+/*--------------------------------------------------------------------------*/
+ /// copies \p from into \p to, whatever their shapes
+ /** boost::multi_array::operator=() requires the two arrays to have the
+  * same shape; this reshapes \p to as \p from before copying it. */
+
+ template< class T , std::size_t K >
+ static void copy_multi_array( boost::multi_array< T , K > & to ,
+                               const boost::multi_array< T , K > & from ) {
+  to.resize( std::vector< std::size_t >( from.shape() ,
+                                         from.shape() + K ) );
+  to = from;
+ }
+
 /**@} ----------------------------------------------------------------------*/
 /*---------------------- METHODS FOR SAVING THE UCBlock --------------------*/
 /*--------------------------------------------------------------------------*/
@@ -1297,6 +1969,72 @@ class UCBlock : public Block
 
  void serialize( netCDF::NcGroup & group ) const override;
 
+/*--------------------------------------------------------------------------*/
+ /// returns the memory held by the UCBlock and all its sub-Block
+ /** Returns the memory held by the UCBlock, broken down by family (see
+  * MemoryUsage), comprised that of its NetworkData and of all its sub-Block:
+  * UnitBlock and NetworkBlock report through their get_memory_usage(), for
+  * any other sub-Block (e.g., HeatBlock) only the abstract representation is
+  * accounted for. The breakdown for each sub-Block can be had by calling
+  * their get_memory_usage() directly. This must not be called while the
+  * UCBlock is being modified. */
+
+ MemoryUsage get_memory_usage( void ) const;
+
+/*--------------------------------------------------------------------------*/
+ /// serialize the UCBlock with the given storage options
+ /** Same as serialize( netCDF::NcGroup ), except that every variable of
+  * the UCBlock and of all its sub-Block is written with the chunking,
+  * deflate and shuffle options in \p storage (see NcStorage).
+  *
+  * The SMS++ ::serialize() helpers define and write a variable in one go,
+  * after which its storage can no longer be changed. The UCBlock data and
+  * each sub-Block are therefore serialized, one at a time, into a scratch
+  * in-memory netCDF-4 file and then copied to \p group with copy_nc_group().
+  * The memory overhead is thus that of the largest single piece, not that
+  * of the whole instance.
+  *
+  * Nothing special is needed when reading: deserialize() reads whole
+  * variables, which is chunk-aligned by construction. With the time-major
+  * chunks, the time profile of a single unit or a window of it lies in as
+  * few chunks as possible.
+  *
+  * If storage.jobs > 1 (and the system has fork()), the sub-Block are
+  * serialized in parallel by min( storage.jobs , number of sub-Block )
+  * child processes, each writing its share of them into a temporary
+  * netCDF-4 file (in $TMPDIR, or /tmp); threads cannot be used for this,
+  * since neither the netCDF library nor the HDF5 one below it is
+  * thread-safe, even on distinct files. The calling process is the single
+  * writer: once all the children are done, it copies the pieces into
+  * \p group with copy_nc_group(), in the same order and by the same netCDF
+  * calls as the serial path, hence the output does not depend on
+  * storage.jobs. The children are forked out of the calling process, so
+  * no other thread of it must be using the netCDF library meanwhile.
+  * Exception is thrown if a temporary file cannot be created or a child
+  * fails; the temporary files are removed in any case. Without fork(),
+  * storage.jobs is ignored and the pieces are serialized serially. */
+
+ void serialize( netCDF::NcGroup & group , const NcStorage & storage ) const;
+
+/*--------------------------------------------------------------------------*/
+ /// copy a netCDF group into another, with the given storage options
+ /** Copies all the attributes, dimensions, variables and (recursively)
+  * sub-groups of \p from into \p to, writing the variables with the
+  * chunking, deflate and shuffle options in \p storage (see NcStorage).
+  * A variable may use a dimension that is not defined in \p from itself
+  * but in one of its ancestors. Such a dimension is looked up by name
+  * among \p to and its ancestors, so it must exist there.
+  *
+  * If [ \p t0 , \p t1 ) does not span the whole "TimeHorizon" of \p from,
+  * only that window is copied of every variable indexed over "TimeHorizon",
+  * or over "NumberIntervals" if it has size TimeHorizon, and these
+  * dimensions are resized accordingly when defined in \p from. */
+
+ static void copy_nc_group( const netCDF::NcGroup & from ,
+                            netCDF::NcGroup & to ,
+                            const NcStorage & storage ,
+                            Index t0 = 0 , Index t1 = Inf< Index >() );
+
 /** @} ---------------------------------------------------------------------*/
 /*------------------ METHODS FOR INITIALIZING THE UCBlock ------------------*/
 /*--------------------------------------------------------------------------*/
@@ -1326,10 +2064,70 @@ class UCBlock : public Block
   * Modification". These Modification are those for which
   * Modification::concerns_Block() is true. Currently, this method only
   * handles UnitBlockMod whose modification is associated with the changing of
-  * the scale factor of a UnitBlock. */
+  * the scale factor of a UnitBlock.
+  *
+  * While a concurrent update session is open (see
+  * begin_concurrent_updates()), the Modification is only staged, and it is
+  * handled when end_concurrent_updates() is called. */
 
  void add_Modification( sp_Mod mod , ChnlName chnl = 0 ) override;
 
+/*--------------------------------------------------------------------------*/
+ /// starts accepting Modification from concurrent producers
+ /** Opens a "concurrent update" session, during which the methods changing
+  * the data of *distinct* sub-Block of the UCBlock (set_linear_term(),
+  * set_maximum_power(), ...) can be called by different threads at the
+  * same time, e.g., to refresh the parameters of thousands of UnitBlock in
+  * parallel without serializing all of them under one lock.
+  *
+  * All the Modification issued by a sub-Block eventually reach
+  * add_Modification() of the UCBlock, which may change the demand
+  * constraints and passes them to the Solver registered to the UCBlock and
+  * to its father, none of which can be done concurrently. During the
+  * session, add_Modification() rather appends the Modification to a staging
+  * buffer owned by the calling thread; this only takes a lock the first
+  * time each thread does it. The staged Modification are handled when
+  * end_concurrent_updates() is called. Note that the sub-Block themselves,
+  * and the Solver registered to them, still see their Modification right
+  * away: this is why two threads must never change the same sub-Block (nor
+  * two HydroUnitBlock of the same HydroSystemUnitBlock).
+  *
+  * During the session the data of the UCBlock proper must not be changed,
+  * and no Solver of the UCBlock (or of its ancestors) must be run. Besides,
+  * no channel (see Block::open_channel()) must be opened or closed, since
+  * the channels are handled by the root Block for all the threads: a
+  * producer can only pass to the set_*() methods a channel that has been
+  * opened before the session and is closed after end_concurrent_updates(),
+  * when the staged Modification have been handled. The only set_*()
+  * methods of the sub-Block of this library that open a channel of their
+  * own, to pack their "abstract Modification", are
+  * BatteryUnitBlock::set_kappa() and the
+  * NuclearUnitBlock::set_modulation_ramp_*(); while a session is open they
+  * rather issue them one by one (see UnitBlock::open_packing_channel()),
+  * hence they can be called as well.
+  * Calling this while a session is already open has no effect. */
+
+ void begin_concurrent_updates( void );
+
+/*--------------------------------------------------------------------------*/
+ /// handles the staged Modification and closes the concurrent session
+ /** Closes the session opened by begin_concurrent_updates(); this must be
+  * called by one thread, after all the producers are done. The staged
+  * Modification are then passed to add_Modification(), one buffer at a time
+  * in the order in which the threads started staging, and within each
+  * buffer in the order in which they were issued, so that those of each
+  * sub-Block keep their relative order. Does nothing if no session is
+  * open. */
+
+ void end_concurrent_updates( void );
+
+/*--------------------------------------------------------------------------*/
+ /// tells if a concurrent update session is open
+
+ bool concurrent_updates_open( void ) const {
+  return( f_staging_epoch.load( std::memory_order_acquire ) != 0 );
+  }
+
 /*--------------------------------------------------------------------------*/
  /// update the active power demand
 
@@ -1398,6 +2196,12 @@ class UCBlock : public Block
  /// the number of units of the problem
  Index f_number_units{};
 
+ /// true if the data has been read as validated, see is_validated()
+ bool f_validated{};
+
+ /// true if the "Validated" attribute is honoured, see set_trust_validated()
+ static bool f_trust_validated;
+
  /// the number of electrical generators of the problem
  Index f_number_elc_generators{};
 
@@ -1591,21 +2395,44 @@ class UCBlock : public Block
   * some time instant, then it has secondary spinning reserve for all time
   * instants. */
 
- boost::multi_array< Index , 2 > inertia_var_index;
- ///< indices of active Variable in the inertia demand constraints
- /**< The active Variables of each LinearFunction defining a inertia demand
-  * constraint are grouped by UnitBlocks. That is, all active Variables of a
-  * given UnitBlock have consecutive indices in the LinearFunction that
-  * defines each constraint. The element at position (i, z) in the multi-array
-  * will store the smallest index of an active Variable (that belong to the
-  * i-th UnitBlock) in the constraint associated with zone "z". If no Variable
-  * of the i-th UnitBlock is active in the constraint associated with zone
-  * "z", then the element at position (i, z) is Inf< Index >().
+ /// descriptor of a term of the inertia demand constraints
+ struct InertiaTerm {
+  Index unit;       ///< the index of the UnitBlock
+  Index generator;  ///< the index of the generator within the UnitBlock
+  bool power;       ///< true if inertia power * p, false if commitment * u
+ };
+
+ std::vector< InertiaTerm > v_inertia_terms;
+ ///< the terms of the inertia demand constraints, grouped by zone
+ /**< The terms of the LinearFunction defining the inertia demand constraint
+  * of zone z are v_inertia_terms[ i ] for i in [ v_inertia_zone_start[ z ] ,
+  * v_inertia_zone_start[ z + 1 ] ), in this order, i.e., the term i is the
+  * active Variable of index i - v_inertia_zone_start[ z ].
   *
-  * Notice that these indices do not depend on the time instant. This is
-  * because we assume that, if a generator has commitment variable, inertia
-  * commitment, inertia power, or active power variable for some time instant,
-  * then it has the same thing for all time instants. */
+  * Notice that this does not depend on the time instant. This is because we
+  * assume that, if a generator has commitment variable, inertia commitment,
+  * inertia power, or active power variable for some time instant, then it
+  * has the same thing for all time instants. */
+
+ std::vector< Index > v_inertia_zone_start;
+ ///< the start of the terms of each zone in v_inertia_terms
+
+ std::vector< ColVariable * > v_fixed_design;
+ ///< the design variables fixed by the last fix_design_variables()
+
+ std::map< std::string , netCDF::NcGroup > f_nc_sub_groups;
+ ///< sub-groups read in place of those of the group given to deserialize()
+
+ /// a staged Modification, together with the channel it was issued on
+ using StagedMod = std::pair< sp_Mod , ChnlName >;
+
+ std::atomic< std::uint64_t > f_staging_epoch{};
+ ///< the id of the open concurrent update session, 0 if none
+
+ std::vector< std::unique_ptr< std::vector< StagedMod > > > v_staging;
+ ///< the staging buffers of the open session, one per producer thread
+
+ std::mutex f_staging_mutex;  ///< protects v_staging
 
  SMSpp_insert_in_factory_h;
 
@@ -1613,6 +2440,52 @@ class UCBlock : public Block
 /*---------------------- PRIVATE METHODS OF THE CLASS ----------------------*/
 /*--------------------------------------------------------------------------*/
 
+ /// serialize the data of the UCBlock proper, i.e., not its sub-Block
+
+ void serialize_data( netCDF::NcGroup & group ) const;
+
+/*--------------------------------------------------------------------------*/
+ /// the number of electrical generators of the UnitBlock in group
+ /** Returns the number of electrical generators of the UnitBlock described
+  * by group out of the dimensions of the group, without deserializing it:
+  * this mirrors UnitBlock::get_number_generators(), i.e., it is the size
+  * of "NumberArcs" for a HydroUnitBlock, the sum over the HydroUnitBlock_i
+  * sub-groups for a HydroSystemUnitBlock, and 1 for any other UnitBlock. A
+  * "NumberElectricalGenerators" dimension in group, if any, takes
+  * precedence. */
+
+ static Index number_generators( const netCDF::NcGroup & group );
+
+/*--------------------------------------------------------------------------*/
+ /// the name of the first initial condition in group or in its sub-groups
+ /// (a variable whose name starts with "Init"), empty if there is none
+
+ static std::string initial_condition( const netCDF::NcGroup & group );
+
+/*--------------------------------------------------------------------------*/
+ /// serialize the given sub-Block into groups of group by storage.jobs
+ /// child processes, see serialize( netCDF::NcGroup & , const NcStorage & )
+
+ static void serialize_pieces( netCDF::NcGroup & group ,
+                               const NcStorage & storage ,
+                               const std::vector< std::pair< const Block * ,
+                               std::string > > & pieces );
+
+/*--------------------------------------------------------------------------*/
+ /// stage mod in the buffer of the calling thread for the given session
+
+ void stage_Modification( sp_Mod mod , ChnlName chnl , std::uint64_t epoch );
+
+/*--------------------------------------------------------------------------*/
+ /// copy the attributes, dimensions and variables of a group, see
+ /// copy_nc_group(), except those whose name is in skip
+
+ static void copy_nc_items( const netCDF::NcGroup & from ,
+                            netCDF::NcGroup & to ,
+                            const NcStorage & storage , Index t0 , Index t1 ,
+                            const std::set< std::string > & skip );
+
+/*--------------------------------------------------------------------------*/
  /// deserialize the sub-blocks of UCBlock that have the given prefix name
 
  void deserialize_sub_blocks( const netCDF::NcGroup & group ,
@@ -1644,6 +2517,15 @@ class UCBlock : public Block
 
  void generate_inertia_demand_constraints( void );
 
+/*--------------------------------------------------------------------------*/
+ /// builds the descriptor table of the inertia demand constraints
+ /** This function fills v_inertia_terms and v_inertia_zone_start, resolving
+  * once and for all (rather than once for each time instant) which terms
+  * of which UnitBlock appear in the inertia demand constraint of each
+  * zone. */
+
+ void build_inertia_terms( void );
+
 /*--------------------------------------------------------------------------*/
  /// generate the pollutant budget constraints
 
@@ -1755,9 +2637,13 @@ class UCBlock : public Block
 
 /*--------------------------------------------------------------------------*/
  /// returns the inertia zone to which the given electrical generator belongs
+ /** Returns the inertia zone to which the given electrical generator
+  * belongs; this is 0 if there is (at most) one zone, in which case
+  * InertiaZones may be missing, and it is >= get_number_inertia_zones() if
+  * the node of the generator belongs to no zone. */
 
  Index get_inertia_zone( Index elc_generator ) const {
-  if( f_number_inertia_zones == 0 )
+  if( ( f_number_inertia_zones <= 1 ) || v_inertia_zones.empty() )
    return( 0 );
 
   // Node to which the given electrical generator belongs
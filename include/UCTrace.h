@@ -0,0 +1,210 @@
+/*--------------------------------------------------------------------------*/
+/*--------------------------- File UCTrace.h -------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ * Header file for the class UCTrace, a lightweight tracing facility for
+ * recording where the time goes inside the UCBlock project (deserialize(),
+ * the generate_*() methods, add_Modification(), the stages of the
+ * ThermalUnitDPSolver, ...) without attaching a profiler.
+ *
+ * The code to be traced is marked with
+ *
+ *     UCBLOCK_TRACE_SPAN( "ThermalUnitBlock::generate_objective" );
+ *
+ * which records a "span" from that point to the end of the enclosing scope.
+ * The macro expands to nothing unless the code is compiled with the
+ * UCBLOCK_TRACE macro defined (e.g., -DUCBLOCK_TRACE in $(SW) for the
+ * makefiles, or -DUCBLOCK_TRACE=ON for CMake), so tracing costs nothing
+ * at all in the ordinary builds. When it is compiled in, each span costs
+ * two reads of std::chrono::steady_clock and one relaxed atomic increment.
+ *
+ * The spans are stored in an in-memory ring buffer of fixed capacity, which
+ * keeps the most recent ones, and can be written as a Chrome trace (JSON)
+ * file that can be loaded in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * \author The UCBlock contributors
+ *
+ * \copyright &copy; by the UCBlock contributors
+ */
+/*--------------------------------------------------------------------------*/
+/*----------------------------- DEFINITIONS --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#ifndef __UCTrace
+ #define __UCTrace    /* self-identification: #endif at the end of the file */
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ INCLUDES ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/*--------------------------------------------------------------------------*/
+/*-------------------------------- MACROS ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @defgroup UCTRACE_MACROS Macros for the tracing spans
+ *  @{ */
+
+#define UCBLOCK_TRACE_CAT_( a , b ) a ## b
+#define UCBLOCK_TRACE_CAT( a , b ) UCBLOCK_TRACE_CAT_( a , b )
+
+#ifdef UCBLOCK_TRACE
+ /// records a span called name (a string literal) up to the end of scope
+ #define UCBLOCK_TRACE_SPAN( name )                                  \
+  SMSpp_di_unipi_it::UCTrace::Span                                  \
+   UCBLOCK_TRACE_CAT( uctrace_span_ , __COUNTER__ )( name )
+#else
+ #define UCBLOCK_TRACE_SPAN( name )
+#endif
+
+/** @} end( group( UCTRACE_MACROS ) ) */
+/*--------------------------------------------------------------------------*/
+/*----------------------------- NAMESPACE ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+/// namespace for the Structured Modeling System++ (SMS++)
+
+namespace SMSpp_di_unipi_it
+{
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------- CLASS UCTrace --------------------------------*/
+/*--------------------------------------------------------------------------*/
+/// the ring buffer of the tracing spans of the UCBlock project
+/** The class UCTrace only has static members, which handle the ring buffer
+ * where the spans marked with UCBLOCK_TRACE_SPAN() are recorded. Spans can
+ * be recorded concurrently by any number of threads; however, the ring
+ * buffer must only be read (events(), write_json()), cleared or resized
+ * when no traced code is running. If more spans than the capacity of the
+ * buffer are recorded, the oldest ones are overwritten (see dropped()).
+ *
+ * All this is available (and harmless) even if UCBLOCK_TRACE is not
+ * defined, in which case nothing is ever recorded. */
+
+class UCTrace
+{
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- PUBLIC PART OF THE CLASS -------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ public:
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ PUBLIC TYPES ------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ /// a recorded span
+ struct Event {
+  const char * name;   ///< the name of the span (a string literal)
+  std::uint64_t ts;    ///< the start, in nanoseconds from the trace origin
+  std::uint64_t dur;   ///< the duration, in nanoseconds
+  std::uint32_t tid;   ///< the (small, consecutive) id of the thread
+ };
+
+/*--------------------------------------------------------------------------*/
+ /// the RAII object recording a span, see UCBLOCK_TRACE_SPAN()
+
+ class Span
+ {
+  public:
+
+  explicit Span( const char * name )
+   : f_name( name ) , f_on( f_enabled.load( std::memory_order_relaxed ) ) ,
+     f_begin( f_on ? now() : 0 ) {}
+
+  ~Span() {
+   if( f_on )
+    record( f_name , f_begin , now() );
+   }
+
+  Span( const Span & ) = delete;
+  Span & operator=( const Span & ) = delete;
+
+  private:
+
+  const char * f_name;
+  bool f_on;
+  std::uint64_t f_begin;
+ };
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------- PUBLIC METHODS -------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ /// enables or disables the recording of the spans (default: enabled)
+ static void set_enabled( bool enabled ) {
+  f_enabled.store( enabled , std::memory_order_relaxed );
+  }
+
+ /// tells if the spans are being recorded
+ static bool is_enabled( void ) {
+  return( f_enabled.load( std::memory_order_relaxed ) );
+  }
+
+ /// sets the capacity of the ring buffer (default: 65536), and clears it
+ static void set_capacity( std::size_t capacity );
+
+ /// returns the capacity of the ring buffer
+ static std::size_t get_capacity( void ) { return( f_buffer.size() ); }
+
+ /// discards all the recorded spans
+ static void clear( void ) { f_next.store( 0 ); }
+
+ /// returns the number of spans that have been overwritten
+ static std::uint64_t dropped( void );
+
+ /// returns the recorded spans, from the oldest to the most recent one
+ static std::vector< Event > events( void );
+
+ /// writes the recorded spans in Chrome trace (JSON) format
+ /** Writes the recorded spans to the given stream in the JSON format
+  * of the Chrome trace viewer (with "ph": "X" complete events and times in
+  * microseconds), which can also be loaded in the Perfetto UI. */
+
+ static void write_json( std::ostream & out );
+
+/*--------------------------------------------------------------------------*/
+/*-------------------- PRIVATE PART OF THE CLASS ---------------------------*/
+/*--------------------------------------------------------------------------*/
+
+ private:
+
+ /// nanoseconds elapsed since the trace origin
+ static std::uint64_t now( void ) {
+  return( std::chrono::duration_cast< std::chrono::nanoseconds >(
+           std::chrono::steady_clock::now() - f_origin ).count() );
+  }
+
+ /// writes one span in the ring buffer
+ static void record( const char * name , std::uint64_t begin ,
+                     std::uint64_t end );
+
+ static std::atomic< bool > f_enabled;   ///< if spans are recorded
+
+ static std::atomic< std::uint64_t > f_next;  ///< next position (mod size)
+
+ static std::vector< Event > f_buffer;   ///< the ring buffer
+
+ /// the origin of all the times
+ static const std::chrono::steady_clock::time_point f_origin;
+
+};  // end( class( UCTrace ) )
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+}  // end( namespace SMSpp_di_unipi_it )
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#endif /* UCTrace.h included */
+
+/*--------------------------------------------------------------------------*/
+/*------------------------- End File UCTrace.h -----------------------------*/
+/*--------------------------------------------------------------------------*/
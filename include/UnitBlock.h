@@ -53,6 +53,10 @@
 
 #include "ColVariable.h"
 
+#include "LinearFunction.h"
+
+#include "MemoryUsage.h"
+
 /*--------------------------------------------------------------------------*/
 /*--------------------------- NAMESPACE ------------------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -194,6 +198,22 @@ class UnitBlock : public Block
 
  void deserialize( const netCDF::NcGroup & group ) override;
 
+/*--------------------------------------------------------------------------*/
+ /// returns a copy of the UnitBlock
+ /** Returns a new UnitBlock of the same type, with father \p father, having
+  * the same data as this one, i.e., what deserialize() has read, as changed
+  * since by the set_*() methods. The abstract representation is *not*
+  * copied: that of the new UnitBlock is generated, if ever, by the
+  * generate_abstract_*() methods exactly as for a just deserialized one.
+  * Neither are the registered Solver and the Solution.
+  *
+  * The data, the BlockConfig included, is copied directly by clone_data().
+  * The base class implementation only handles a plain UnitBlock, and
+  * throws exception for any derived class that does not override it. The
+  * returned UnitBlock is owned by the caller. */
+
+ virtual UnitBlock * clone( Block * father = nullptr ) const;
+
 /**@} ----------------------------------------------------------------------*/
 /*------------ METHODS FOR READING THE DATA OF THE UnitBlock ---------------*/
 /*--------------------------------------------------------------------------*/
@@ -391,6 +411,58 @@ class UnitBlock : public Block
   return( nullptr );
  }
 
+/*--------------------------------------------------------------------------*/
+ /// returns the number of design (investment) variables of this UnitBlock
+ /** In the design scenario of the UC problem (i.e., when some investment
+  * cost is nonzero), a UnitBlock has one or more "design" variables x that
+  * decide whether (or how much of) the unit is built, and that are linked
+  * to the operational variables at all time instants. This method returns
+  * the number of such variables, so that they can be collected at the
+  * UCBlock level (see UCBlock::get_design_variables()).
+  *
+  * The default implementation of this method returns 0; derived classes
+  * that have design variables must override it. */
+
+ virtual Index get_number_design_variables( void ) const { return( 0 ); }
+
+/*--------------------------------------------------------------------------*/
+ /// returns the i-th design (investment) variable of this UnitBlock
+ /** This method returns a pointer to the \p i-th design variable of this
+  * UnitBlock, for \p i in {0, ..., get_number_design_variables() - 1}, or
+  * nullptr if there is no such variable. The variable only is meaningful
+  * after generate_abstract_variables() has been called.
+  *
+  * The default implementation of this method returns nullptr. */
+
+ virtual ColVariable * get_design_variable( Index i = 0 ) {
+  return( nullptr );
+ }
+
+/*--------------------------------------------------------------------------*/
+ /// returns the number of storages of this UnitBlock
+ /** A UnitBlock may have one or more "storages" (the level of a battery,
+  * the volume of a reservoir, ...) whose state at each time instant is
+  * described by a ColVariable. This method returns their number, so that
+  * they can be handled at the UCBlock level (see, e.g.,
+  * UCBlock::serialize_solution()).
+  *
+  * The default implementation of this method returns 0; derived classes
+  * that have storages must override it. */
+
+ virtual Index get_number_storages( void ) const { return( 0 ); }
+
+/*--------------------------------------------------------------------------*/
+ /// returns the storage level variables of the i-th storage
+ /** This method returns a pointer to the array of get_time_horizon()
+  * ColVariable representing the level of the \p i-th storage of this
+  * UnitBlock, for \p i in {0, ..., get_number_storages() - 1}, or nullptr
+  * if there is no such storage or its variables have not been generated
+  * yet.
+  *
+  * The default implementation of this method returns nullptr. */
+
+ virtual ColVariable * get_storage( Index i = 0 ) { return( nullptr ); }
+
 /*--------------------------------------------------------------------------*/
  /// returns the scale factor of this UnitBlock
  /** This method returns the scale factor of this UnitBlock. Since not every
@@ -452,6 +524,17 @@ class UnitBlock : public Block
 
  void serialize( netCDF::NcGroup & group ) const override;
 
+ /// returns the memory held by the UnitBlock and its sub-Block
+ /** Returns the memory held by the UnitBlock, broken down by family (see
+  * MemoryUsage), comprised that of all its sub-Block: those that are
+  * UnitBlock report through get_memory_usage(), for any other only the
+  * abstract representation is accounted for. The base class implementation
+  * accounts for the abstract representation and the data of UnitBlock;
+  * derived classes are expected to add their own data (and Solver, if
+  * any). This must not be called while the UnitBlock is being modified. */
+
+ virtual MemoryUsage get_memory_usage( void ) const;
+
 /** @} ---------------------------------------------------------------------*/
 /*---------------- METHODS FOR MODIFYING THE UnitBlock ---------------------*/
 /*--------------------------------------------------------------------------*/
@@ -651,6 +734,29 @@ class UnitBlock : public Block
  /// deserializes the change intervals vector from a netCDF group
  void deserialize_change_intervals( const netCDF::NcGroup & group );
 
+ /// tells whether the data of the UnitBlock has already been validated
+ /** Returns true if the UnitBlock belongs (possibly indirectly) to a
+  * UCBlock whose UCBlock::is_validated() is true, in which case the checks
+  * on the data can be skipped in deserialize(). */
+ bool validated_data( void ) const;
+
+ /// opens a channel for packing the "abstract Modification" of a set_*()
+ /** Returns open_channel( par2chnl( issueAMod ) ), i.e., a new channel
+  * packing the Modification into a GroupModification, unless the UnitBlock
+  * belongs (possibly indirectly) to a UCBlock with an open concurrent update
+  * session (see UCBlock::begin_concurrent_updates()). Then, since the
+  * channels are handled by the root Block for all the threads, no channel
+  * can be opened, and par2chnl( issueAMod ) is returned instead: the
+  * Modification are issued one by one, in the channel of the caller. The
+  * channel must be closed by close_packing_channel(). */
+ ChnlName open_packing_channel( ModParam issueAMod );
+
+ /// closes a channel returned by open_packing_channel( issueAMod )
+ void close_packing_channel( ChnlName chnl , ModParam issueAMod );
+
+ /// copies the data of the base UnitBlock out of \p from, see clone()
+ void clone_data( const UnitBlock & from );
+
  /// states that the Variable of the UnitBlock have been generated
  void set_variables_generated( void ) { AR |= HasVar; }
 
@@ -781,9 +887,21 @@ public:
                    * extend the set of types of UnitBlockMod. */
  };
 
- /// constructor, takes the UnitBlock and the type
- UnitBlockMod( UnitBlock * const fblock, const int type )
-  : f_Block( fblock ), f_type( type ) {}
+ /// public enum for the families of UnitBlockMod
+ /** The family tells which class (among those that need to be told apart
+  * when the Modification are dispatched) a UnitBlockMod is an instance of,
+  * so that once a Modification is known to be a UnitBlockMod the derived
+  * class is found by a switch on family() and a static_cast, rather than by
+  * a chain of dynamic_cast. */
+ enum UB_mod_family {
+  eUnitBlockModFamily = 0 ,  ///< any UnitBlockMod not listed below
+  eThermalUnitBlockModFamily ///< a ThermalUnitBlockMod (or derived)
+ };
+
+ /// constructor, takes the UnitBlock, the type and the family
+ UnitBlockMod( UnitBlock * const fblock, const int type ,
+               const UB_mod_family family = eUnitBlockModFamily )
+  : f_Block( fblock ), f_type( type ), f_family( family ) {}
 
  /// destructor, default version
  virtual ~UnitBlockMod() override = default;
@@ -794,6 +912,9 @@ public:
  /// accessor to the type of modification
  int type( void ) { return( f_type ); }
 
+ /// accessor to the family of the UnitBlockMod
+ UB_mod_family family( void ) const { return( f_family ); }
+
  protected:
 
  /// prints the UnitBlockMod
@@ -812,6 +933,8 @@ public:
 
  int f_type;  ///< type of modification
 
+ UB_mod_family f_family;  ///< family of the UnitBlockMod
+
 };  // end( class( UnitBlockMod ) )
 
 /*--------------------------------------------------------------------------*/
@@ -39,10 +39,15 @@
 
 #include "LinearFunction.h"
 
+#include "NewLinearFunction.h"
+
+
 #include "FRealObjective.h"
 
 #include "UnitBlock.h"
 
+#include "UCTrace.h"
+
 /*--------------------------------------------------------------------------*/
 /*------------------------- NAMESPACE AND USING ----------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -57,6 +62,25 @@ using namespace SMSpp_di_unipi_it;
 
 SMSpp_insert_in_factory_cpp_1( BatteryUnitBlock );
 
+/*--------------------------------------------------------------------------*/
+/*-------------------------------- CONSTANTS -------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+// positions of the kappa-dependent coefficients in the LinearFunction of the
+// rows constructed by generate_abstract_constraints(), which are the same
+// for all t: these are the position of batt_design in
+// intake_outtake_upper_bounds_design_Const[ 0 / 1 ][ t ] and in
+// storage_level_bounds_design_Const[ 0 / 1 ][ t ], of conv_design in
+// intake_outtake_upper_bounds_design_Const[ 2 ][ t ], and of
+// v_battery_binary[ t ] in intake_outtake_binary_Const[ 0 / 1 ][ t ]; the
+// position of batt_design in active_power_bounds_design_Const[ 0 / 1 ][ t ]
+// depends on the reserve variables, hence it is f_design_pos_active_power
+
+static constexpr Block::Index IOBDPos = 1;
+static constexpr Block::Index IOBDConvPos = 2;
+static constexpr Block::Index SLBDPos = 1;
+static constexpr Block::Index IOBinPos = 1;
+
 /*--------------------------------------------------------------------------*/
 /*----------------------- METHODS OF BatteryUnitBlock ----------------------*/
 /*--------------------------------------------------------------------------*/
@@ -64,6 +88,7 @@ SMSpp_insert_in_factory_cpp_1( BatteryUnitBlock );
 BatteryUnitBlock::~BatteryUnitBlock()
 {
  Constraint::clear( active_power_bounds_Const );
+ Constraint::clear( active_power_box_Const );
  Constraint::clear( active_power_bounds_design_Const );
  Constraint::clear( intake_outtake_upper_bounds_design_Const );
  Constraint::clear( storage_level_bounds_design_Const );
@@ -89,32 +114,35 @@ BatteryUnitBlock::~BatteryUnitBlock()
 
 void BatteryUnitBlock::deserialize( const netCDF::NcGroup & group )
 {
+ UCBLOCK_TRACE_SPAN( "BatteryUnitBlock::deserialize" );
 
 #ifndef NDEBUG
- std::vector< std::string > expected_dims = { "TimeHorizon" ,
-                                              "NumberIntervals" };
- check_dimensions( group , expected_dims , std::cerr );
-
- std::vector< std::string > expected_vars = { "MinStorage" , "MaxStorage" ,
-                                              "InitialStorage" ,
-                                              "MinPower" , "MaxPower" ,
-                                              "InitialPower" ,
-                                              "ConverterMaxPower" ,
-                                              "MaxPrimaryPower" ,
-                                              "MaxSecondaryPower" ,
-                                              "DeltaRampUp" , "DeltaRampDown" ,
-                                              "StoringBatteryRho" ,
-                                              "ExtractingBatteryRho" ,
-                                              "Cost" , "Demand" , "Kappa" ,
-                                              "MaxCRateCharge" ,
-                                              "MaxCRateDischarge" ,
-                                              "BatteryMaxCapacity" ,
-                                              "ConverterMaxCapacity" ,
-                                              "MaxIntakePower" ,
-                                              "MaxOuttakePower" ,
-                                              "BatteryInvestmentCost" ,
-                                              "ConverterInvestmentCost" };
- check_variables( group , expected_vars , std::cerr );
+ if( ! validated_data() ) {
+  std::vector< std::string > expected_dims = { "TimeHorizon" ,
+                                               "NumberIntervals" };
+  check_dimensions( group , expected_dims , std::cerr );
+
+  std::vector< std::string > expected_vars = { "MinStorage" , "MaxStorage" ,
+                                               "InitialStorage" ,
+                                               "MinPower" , "MaxPower" ,
+                                               "InitialPower" ,
+                                               "ConverterMaxPower" ,
+                                               "MaxPrimaryPower" ,
+                                               "MaxSecondaryPower" ,
+                                               "DeltaRampUp" , "DeltaRampDown" ,
+                                               "StoringBatteryRho" ,
+                                               "ExtractingBatteryRho" ,
+                                               "Cost" , "Demand" , "Kappa" ,
+                                               "MaxCRateCharge" ,
+                                               "MaxCRateDischarge" ,
+                                               "BatteryMaxCapacity" ,
+                                               "ConverterMaxCapacity" ,
+                                               "MaxIntakePower" ,
+                                               "MaxOuttakePower" ,
+                                               "BatteryInvestmentCost" ,
+                                               "ConverterInvestmentCost" };
+  check_variables( group , expected_vars , std::cerr );
+ }
 #endif
 
  // Deserialize data from the base class
@@ -186,12 +214,48 @@ void BatteryUnitBlock::deserialize( const netCDF::NcGroup & group )
  decompress_vector( v_Demand );
  decompress_vector( v_Cost );
 
- check_data_consistency();
+ if( ! validated_data() )
+  check_data_consistency();
 
 }  // end( BatteryUnitBlock::deserialize )
 
 /*--------------------------------------------------------------------------*/
 
+UnitBlock * BatteryUnitBlock::clone( Block * father ) const
+{
+ auto unit = std::make_unique< BatteryUnitBlock >( father );
+ unit->clone_data( *this );
+
+ unit->v_MinStorage = v_MinStorage;
+ unit->v_MaxStorage = v_MaxStorage;
+ unit->v_MinPower = v_MinPower;
+ unit->v_MaxPower = v_MaxPower;
+ unit->v_ConvMaxPower = v_ConvMaxPower;
+ unit->v_MaxPrimaryPower = v_MaxPrimaryPower;
+ unit->v_MaxSecondaryPower = v_MaxSecondaryPower;
+ unit->v_DeltaRampUp = v_DeltaRampUp;
+ unit->v_DeltaRampDown = v_DeltaRampDown;
+ unit->v_StoringBatteryRho = v_StoringBatteryRho;
+ unit->v_ExtractingBatteryRho = v_ExtractingBatteryRho;
+ unit->v_Cost = v_Cost;
+ unit->v_Demand = v_Demand;
+
+ unit->f_BattInvestmentCost = f_BattInvestmentCost;
+ unit->f_ConvInvestmentCost = f_ConvInvestmentCost;
+ unit->f_BattMaxCapacity = f_BattMaxCapacity;
+ unit->f_ConvMaxCapacity = f_ConvMaxCapacity;
+ unit->f_InitialStorage = f_InitialStorage;
+ unit->f_InitialPower = f_InitialPower;
+ unit->f_MaxCRateCharge = f_MaxCRateCharge;
+ unit->f_MaxCRateDischarge = f_MaxCRateDischarge;
+ unit->f_kappa = f_kappa;
+ unit->f_scale = f_scale;
+
+ return( unit.release() );
+}
+
+/*--------------------------------------------------------------------------*/
+
 void BatteryUnitBlock::check_data_consistency( void ) const {
 
  // InvestmentCost
@@ -330,6 +394,8 @@ void BatteryUnitBlock::check_data_consistency( void ) const {
 
 void BatteryUnitBlock::generate_abstract_variables( Configuration * stvv )
 {
+ UCBLOCK_TRACE_SPAN( "BatteryUnitBlock::generate_abstract_variables" );
+
  if( variables_generated() )  // variables have already been generated
   return;                     // nothing to do
 
@@ -430,6 +496,8 @@ void BatteryUnitBlock::generate_abstract_variables( Configuration * stvv )
 
 void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
 {
+ UCBLOCK_TRACE_SPAN( "BatteryUnitBlock::generate_abstract_constraints" );
+
  if( constraints_generated() )  // constraints have already been generated
   return;                       // nothing to do
 
@@ -468,53 +536,71 @@ void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
   // Active power bounds constraints
 
-  active_power_bounds_Const.resize(
-   boost::multi_array< FRowConstraint , 2 >::extent_gen()
-   [ 2 ][ f_time_horizon ] );  // 2 dims, i.e., the lower and upper bounds
-
-  for( Index t = 0 ; t < f_time_horizon ; ++t ) {
+  // if no reserve variable enters them, the two rows only involve the
+  // active power, and they are rather a bound on it
+  if( ( ! ( ( reserve_vars & 1u ) && ( ! v_MaxPrimaryPower.empty() ) ) ) &&
+      ( ! ( ( reserve_vars & 2u ) && ( ! v_MaxSecondaryPower.empty() ) ) ) ) {
 
-   vars.push_back( std::make_pair( &v_active_power[ t ] , 1.0 ) );
-
-   if( reserve_vars & 1u )  // if UCBlock has primary demand variables
-    if( ! v_MaxPrimaryPower.empty() )
-     // if this unit produces any primary reserve
-     vars.push_back( std::make_pair( &v_primary_spinning_reserve[ t ] ,
-                                     -1.0 ) );
+   active_power_box_Const.resize( f_time_horizon );
 
-   if( reserve_vars & 2u )  // if UCBlock has secondary demand variables
-    if( ! v_MaxSecondaryPower.empty() )
-     // if unit produces any secondary reserve
-     vars.push_back( std::make_pair( &v_secondary_spinning_reserve[ t ] ,
-                                     -1.0 ) );
+   for( Index t = 0 ; t < f_time_horizon ; ++t ) {
+    active_power_box_Const[ t ].set_lhs( f_kappa * v_MinPower[ t ] );
+    active_power_box_Const[ t ].set_rhs( f_kappa * v_MaxPower[ t ] );
+    active_power_box_Const[ t ].set_variable( &v_active_power[ t ] );
+   }
 
-   active_power_bounds_Const[ 0 ][ t ].set_lhs( f_kappa * v_MinPower[ t ] );
-   active_power_bounds_Const[ 0 ][ t ].set_rhs( Inf< double >() );
-   active_power_bounds_Const[ 0 ][ t ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+   add_static_constraint( active_power_box_Const , "ActivePower_Battery" );
+  }
+  else {
 
-   vars.push_back( std::make_pair( &v_active_power[ t ] , 1.0 ) );
+   active_power_bounds_Const.resize(
+    boost::multi_array< FRowConstraint , 2 >::extent_gen()
+    [ 2 ][ f_time_horizon ] );  // 2 dims, i.e., the lower and upper bounds
 
-   if( reserve_vars & 1u )  // if UCBlock has primary demand variables
-    if( ! v_MaxPrimaryPower.empty() )
-     // if this unit produces any primary reserve
-     vars.push_back( std::make_pair( &v_primary_spinning_reserve[ t ] ,
-                                     1.0 ) );
+   for( Index t = 0 ; t < f_time_horizon ; ++t ) {
 
-   if( reserve_vars & 2u )  // if UCBlock has secondary demand variable
-    if( ! v_MaxSecondaryPower.empty() )
-     // if this unit produces any secondary reserve
-     vars.push_back( std::make_pair( &v_secondary_spinning_reserve[ t ] ,
-                                     1.0 ) );
+    vars.push_back( std::make_pair( &v_active_power[ t ] , 1.0 ) );
+
+    if( reserve_vars & 1u )  // if UCBlock has primary demand variables
+     if( ! v_MaxPrimaryPower.empty() )
+      // if this unit produces any primary reserve
+      vars.push_back( std::make_pair( &v_primary_spinning_reserve[ t ] ,
+                                      -1.0 ) );
+
+    if( reserve_vars & 2u )  // if UCBlock has secondary demand variables
+     if( ! v_MaxSecondaryPower.empty() )
+      // if unit produces any secondary reserve
+      vars.push_back( std::make_pair( &v_secondary_spinning_reserve[ t ] ,
+                                      -1.0 ) );
+
+    active_power_bounds_Const[ 0 ][ t ].set_lhs( f_kappa * v_MinPower[ t ] );
+    active_power_bounds_Const[ 0 ][ t ].set_rhs( Inf< double >() );
+    active_power_bounds_Const[ 0 ][ t ].set_function(
+     new_LinearFunction( vars ) );
+
+    vars.push_back( std::make_pair( &v_active_power[ t ] , 1.0 ) );
+
+    if( reserve_vars & 1u )  // if UCBlock has primary demand variables
+     if( ! v_MaxPrimaryPower.empty() )
+      // if this unit produces any primary reserve
+      vars.push_back( std::make_pair( &v_primary_spinning_reserve[ t ] ,
+                                      1.0 ) );
+
+    if( reserve_vars & 2u )  // if UCBlock has secondary demand variable
+     if( ! v_MaxSecondaryPower.empty() )
+      // if this unit produces any secondary reserve
+      vars.push_back( std::make_pair( &v_secondary_spinning_reserve[ t ] ,
+                                      1.0 ) );
+
+    active_power_bounds_Const[ 1 ][ t ].set_lhs( -Inf< double >() );
+    active_power_bounds_Const[ 1 ][ t ].set_rhs( f_kappa * v_MaxPower[ t ] );
+    active_power_bounds_Const[ 1 ][ t ].set_function(
+     new_LinearFunction( vars ) );
+   }
 
-   active_power_bounds_Const[ 1 ][ t ].set_lhs( -Inf< double >() );
-   active_power_bounds_Const[ 1 ][ t ].set_rhs( f_kappa * v_MaxPower[ t ] );
-   active_power_bounds_Const[ 1 ][ t ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+   add_static_constraint( active_power_bounds_Const , "ActivePower_Battery" );
   }
 
-  add_static_constraint( active_power_bounds_Const , "ActivePower_Battery" );
-
  } else {
 
   // Intake outtake upper bounds design constraints
@@ -541,7 +627,7 @@ void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
    intake_outtake_upper_bounds_design_Const[ 0 ][ t ].set_lhs( -Inf< double >() );
    intake_outtake_upper_bounds_design_Const[ 0 ][ t ].set_rhs( 0.0 );
    intake_outtake_upper_bounds_design_Const[ 0 ][ t ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
 
    // Upper bound of the outtake level design constraints:
    //
@@ -558,7 +644,7 @@ void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
    intake_outtake_upper_bounds_design_Const[ 1 ][ t ].set_lhs( -Inf< double >() );
    intake_outtake_upper_bounds_design_Const[ 1 ][ t ].set_rhs( 0.0 );
    intake_outtake_upper_bounds_design_Const[ 1 ][ t ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
 
    // Upper bound of the intake + outtake level design constraints:
    //
@@ -574,7 +660,7 @@ void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
    intake_outtake_upper_bounds_design_Const[ 2 ][ t ].set_lhs( -Inf< double >() );
    intake_outtake_upper_bounds_design_Const[ 2 ][ t ].set_rhs( 0.0 );
    intake_outtake_upper_bounds_design_Const[ 2 ][ t ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
   }
 
   add_static_constraint( intake_outtake_upper_bounds_design_Const ,
@@ -610,10 +696,13 @@ void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
    vars.push_back( std::make_pair( &batt_design ,
                                    -f_kappa * v_MinPower[ t ] ) );
 
+   // batt_design is the last one, in the same position in both rows
+   f_design_pos_active_power = vars.size() - 1;
+
    active_power_bounds_design_Const[ 0 ][ t ].set_lhs( 0.0 );
    active_power_bounds_design_Const[ 0 ][ t ].set_rhs( Inf< double >() );
    active_power_bounds_design_Const[ 0 ][ t ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
 
    // Upper bound of the active power design constraints:
    //
@@ -640,7 +729,7 @@ void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
    active_power_bounds_design_Const[ 1 ][ t ].set_lhs( -Inf< double >() );
    active_power_bounds_design_Const[ 1 ][ t ].set_rhs( 0.0 );
    active_power_bounds_design_Const[ 1 ][ t ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
   }
 
   add_static_constraint( active_power_bounds_design_Const ,
@@ -659,7 +748,7 @@ void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
   power_intake_outtake_Const[ t ].set_both( 0.0 );
   power_intake_outtake_Const[ t ].set_function(
-   new LinearFunction( std::move( vars ) ) );
+   new_LinearFunction( vars ) );
  }
 
  add_static_constraint( power_intake_outtake_Const ,
@@ -675,7 +764,7 @@ void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
   ramp_up_Const[ 0 ].set_lhs( -Inf< double >() );
   ramp_up_Const[ 0 ].set_rhs( v_DeltaRampUp[ 0 ] + f_InitialPower );
-  ramp_up_Const[ 0 ].set_function( new LinearFunction( std::move( vars ) ) );
+  ramp_up_Const[ 0 ].set_function( new_LinearFunction( vars ) );
 
   for( Index t = 1 ; t < f_time_horizon ; ++t ) {
 
@@ -684,7 +773,7 @@ void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
    ramp_up_Const[ t ].set_lhs( -Inf< double >() );
    ramp_up_Const[ t ].set_rhs( v_DeltaRampUp[ t ] );
-   ramp_up_Const[ t ].set_function( new LinearFunction( std::move( vars ) ) );
+   ramp_up_Const[ t ].set_function( new_LinearFunction( vars ) );
   }
  }
 
@@ -700,7 +789,7 @@ void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
   ramp_down_Const[ 0 ].set_lhs( -v_DeltaRampDown[ 0 ] + f_InitialPower );
   ramp_down_Const[ 0 ].set_rhs( Inf< double >() );
-  ramp_down_Const[ 0 ].set_function( new LinearFunction( std::move( vars ) ) );
+  ramp_down_Const[ 0 ].set_function( new_LinearFunction( vars ) );
 
   for( Index t = 1 ; t < f_time_horizon ; ++t ) {
 
@@ -709,7 +798,7 @@ void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
    ramp_down_Const[ t ].set_lhs( -v_DeltaRampDown[ 0 ] );
    ramp_down_Const[ t ].set_rhs( Inf< double >() );
-   ramp_down_Const[ t ].set_function( new LinearFunction( std::move( vars ) ) );
+   ramp_down_Const[ t ].set_function( new_LinearFunction( vars ) );
   }
  }
 
@@ -742,7 +831,7 @@ void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
   demand_Const[ 0 ].set_both(
    ( f_InitialStorage < 0 ? 0.0 : f_InitialStorage ) );
 
- demand_Const[ 0 ].set_function( new LinearFunction( std::move( vars ) ) );
+ demand_Const[ 0 ].set_function( new_LinearFunction( vars ) );
 
  for( Index t = 1 ; t < f_time_horizon ; ++t ) {
 
@@ -764,7 +853,7 @@ void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
   else
    demand_Const[ t ].set_both( 0.0 );
 
-  demand_Const[ t ].set_function( new LinearFunction( std::move( vars ) ) );
+  demand_Const[ t ].set_function( new_LinearFunction( vars ) );
  }
 
  add_static_constraint( demand_Const , "Demand_Battery" );
@@ -805,7 +894,7 @@ void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
    storage_level_bounds_design_Const[ 0 ][ t ].set_lhs( 0.0 );
    storage_level_bounds_design_Const[ 0 ][ t ].set_rhs( Inf< double >() );
    storage_level_bounds_design_Const[ 0 ][ t ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
 
    // Upper bound of the storage level design constraints:
    //
@@ -819,7 +908,7 @@ void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
    storage_level_bounds_design_Const[ 1 ][ t ].set_lhs( -Inf< double >() );
    storage_level_bounds_design_Const[ 1 ][ t ].set_rhs( 0.0 );
    storage_level_bounds_design_Const[ 1 ][ t ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
   }
 
   add_static_constraint( storage_level_bounds_design_Const ,
@@ -845,7 +934,7 @@ void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
    intake_outtake_binary_Const[ 0 ][ t ].set_lhs( -Inf< double >() );
    intake_outtake_binary_Const[ 0 ][ t ].set_rhs( 0.0 );
    intake_outtake_binary_Const[ 0 ][ t ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
 
    //      v_outtake_level <= - v_MinPower ( 1 - b )
    // => v_outtake_level - v_MinPower b <= - v_MinPower
@@ -858,7 +947,7 @@ void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
    intake_outtake_binary_Const[ 1 ][ t ].set_lhs( -Inf< double >() );
    intake_outtake_binary_Const[ 1 ][ t ].set_rhs( -f_kappa * v_MinPower[ t ] );
    intake_outtake_binary_Const[ 1 ][ t ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
   }
 
   add_static_constraint( intake_outtake_binary_Const ,
@@ -928,6 +1017,8 @@ void BatteryUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
 void BatteryUnitBlock::generate_objective( Configuration *objc )
 {
+ UCBLOCK_TRACE_SPAN( "BatteryUnitBlock::generate_objective" );
+
  if( objective_generated() )  // Objective has already been generated
   return;                     // nothing to do
 
@@ -998,6 +1089,7 @@ bool BatteryUnitBlock::is_feasible( bool useabstract , Configuration * fsbc )
   // Constraints: notice that the ZOConstraint are not checked, since the
   // corresponding check is made on the ColVariable
   && RowConstraint::is_feasible( active_power_bounds_Const , tol , rel_viol )
+  && RowConstraint::is_feasible( active_power_box_Const , tol , rel_viol )
   && RowConstraint::is_feasible( intake_outtake_upper_bounds_design_Const , tol , rel_viol )
   && RowConstraint::is_feasible( storage_level_bounds_design_Const , tol , rel_viol )
   && RowConstraint::is_feasible( intake_outtake_binary_Const , tol , rel_viol )
@@ -1097,6 +1189,18 @@ void BatteryUnitBlock::serialize( netCDF::NcGroup & group ) const {
 
 }  // end( BatteryUnitBlock::serialize )
 
+/*--------------------------------------------------------------------------*/
+
+MemoryUsage BatteryUnitBlock::get_memory_usage( void ) const
+{
+ auto usage = UnitBlock::get_memory_usage();
+ usage.add_data( v_MinStorage , v_MaxStorage , v_MinPower , v_MaxPower ,
+                 v_ConvMaxPower , v_MaxPrimaryPower , v_MaxSecondaryPower ,
+                 v_DeltaRampUp , v_DeltaRampDown , v_StoringBatteryRho ,
+                 v_ExtractingBatteryRho , v_Cost , v_Demand );
+ return( usage );
+}  // end( BatteryUnitBlock::get_memory_usage )
+
 /*--------------------------------------------------------------------------*/
 /*------------------------ METHODS FOR CHANGING DATA -----------------------*/
 /*--------------------------------------------------------------------------*/
@@ -1316,191 +1420,129 @@ void BatteryUnitBlock::scale( MF_dbl_it values ,
 
 void BatteryUnitBlock::update_kappa_in_cnstrs( ModParam issueAMod )
 {
+ // all the rows depending on kappa have the kappa-dependent coefficient in
+ // a fixed position (see the CONSTANTS at the beginning of the file), which
+ // is only checked in debug mode; each row has its own LinearFunction with
+ // a single kappa-dependent coefficient, hence one "abstract Modification"
+ // per row is the least that can be issued, but they are all packed into a
+ // single GroupModification
+
+ auto nAM = un_ModBlock( make_par( par2mod( issueAMod ) ,
+                                   open_packing_channel( issueAMod ) ) );
+
+ // change coefficient pos of the LinearFunction of all the rows cnst[ t ] to
+ // cf * data[ t ], possibly checking that it is that of variable var[ t ]
+ auto upd_coeff = [ this , nAM ]( auto && cnst , Index pos , double cf ,
+                                  const std::vector< double > & data ,
+                                  [[maybe_unused]] auto var ,
+                                  [[maybe_unused]] const char * name ) {
+  for( Index t = 0 ; t < f_time_horizon ; ++t ) {
+   auto f = static_cast< LinearFunction * >( cnst[ t ].get_function() );
+#ifndef NDEBUG
+   if( f->is_active( var( t ) ) != pos )
+    throw( std::logic_error( std::string(
+                        "BatteryUnitBlock::update_kappa_in_cnstrs: expected"
+                        " Variable not found in " ) + name ) );
+#endif
+   f->modify_coefficient( pos , cf * data[ t ] , nAM );
+  }
+ };
+
+ auto bd = [ this ]( Index ) { return( &batt_design ); };
+ auto cd = [ this ]( Index ) { return( &conv_design ); };
+ auto bb = [ this ]( Index t ) { return( &v_battery_binary[ t ] ); };
+
  if( ! intake_outtake_bounds_Const.empty() )
 
   for( Index t = 0 ; t < f_time_horizon ; ++t ) {
    intake_outtake_bounds_Const[ 0 ][ t ].set_rhs(
-    -f_kappa * f_MaxCRateDischarge * v_MinPower[ t ] , issueAMod );
+    -f_kappa * f_MaxCRateDischarge * v_MinPower[ t ] , nAM );
    intake_outtake_bounds_Const[ 1 ][ t ].set_rhs(
-    f_kappa * f_MaxCRateCharge * v_MaxPower[ t ] , issueAMod );
+    f_kappa * f_MaxCRateCharge * v_MaxPower[ t ] , nAM );
   }
 
- else if( ! intake_outtake_upper_bounds_design_Const.empty() )
-
-  for( Index t = 0 ; t < f_time_horizon ; ++t ) {
-
-   auto f0 = static_cast< LinearFunction * >(
-    intake_outtake_upper_bounds_design_Const[ 0 ][ t ].get_function() );
-
-   const auto batt_design_idx0 = f0->is_active( &batt_design );
-
-   if( batt_design_idx0 == Inf< Index >() )
-    throw( std::logic_error( "BatteryUnitBlock::update_kappa_in_cnstrs: "
-                             "expected Variable not found in "
-                             "intake_outtake_upper_bounds_design_Const." ) );
-
-   f0->modify_coefficient( batt_design_idx0 ,
-                           f_kappa * f_MaxCRateDischarge * v_MinPower[ t ] ,
-                           issueAMod );
-
-   auto f1 = static_cast< LinearFunction * >(
-    intake_outtake_upper_bounds_design_Const[ 1 ][ t ].get_function() );
-
-   const auto batt_design_idx1 = f1->is_active( &batt_design );
-
-   if( batt_design_idx1 == Inf< Index >() )
-    throw( std::logic_error( "BatteryUnitBlock::update_kappa_in_cnstrs: "
-                             "expected Variable not found in "
-                             "intake_outtake_upper_bounds_design_Const." ) );
-
-   f1->modify_coefficient( batt_design_idx1 ,
-                           -f_kappa * f_MaxCRateCharge * v_MaxPower[ t ] ,
-                           issueAMod );
-
-   auto f2 = static_cast< LinearFunction * >(
-    intake_outtake_upper_bounds_design_Const[ 2 ][ t ].get_function() );
-
-   const auto conv_design_idx2 = f2->is_active( &conv_design );
-
-   if( conv_design_idx2 == Inf< Index >() )
-    throw( std::logic_error( "BatteryUnitBlock::update_kappa_in_cnstrs: "
-                              "expected Variable not found in "
-                              "intake_outtake_upper_bounds_design_Const." ) );
-
-   f2->modify_coefficient( conv_design_idx2 ,
-                           -f_kappa * v_ConvMaxPower[ t ] ,
-                           issueAMod );
-  }
+ else if( ! intake_outtake_upper_bounds_design_Const.empty() ) {
+  upd_coeff( intake_outtake_upper_bounds_design_Const[ 0 ] , IOBDPos ,
+             f_kappa * f_MaxCRateDischarge , v_MinPower , bd ,
+             "intake_outtake_upper_bounds_design_Const." );
+  upd_coeff( intake_outtake_upper_bounds_design_Const[ 1 ] , IOBDPos ,
+             -f_kappa * f_MaxCRateCharge , v_MaxPower , bd ,
+             "intake_outtake_upper_bounds_design_Const." );
+  upd_coeff( intake_outtake_upper_bounds_design_Const[ 2 ] , IOBDConvPos ,
+             -f_kappa , v_ConvMaxPower , cd ,
+             "intake_outtake_upper_bounds_design_Const." );
+ }
 
  if( ! active_power_bounds_Const.empty() )
 
   for( Index t = 0 ; t < f_time_horizon ; ++t ) {
    active_power_bounds_Const[ 0 ][ t ].set_lhs(
-    f_kappa * v_MinPower[ t ] , issueAMod );
+    f_kappa * v_MinPower[ t ] , nAM );
    active_power_bounds_Const[ 1 ][ t ].set_rhs(
-    f_kappa * v_MaxPower[ t ] , issueAMod );
+    f_kappa * v_MaxPower[ t ] , nAM );
   }
 
- else if( ! active_power_bounds_design_Const.empty() )
+ else if( ! active_power_box_Const.empty() )
 
   for( Index t = 0 ; t < f_time_horizon ; ++t ) {
-   auto f0 = static_cast< LinearFunction * >(
-    active_power_bounds_design_Const[ 0 ][ t ].get_function() );
-
-   const auto batt_design_idx0 = f0->is_active( &batt_design );
-
-   if( batt_design_idx0 == Inf< Index >() )
-    throw( std::logic_error( "BatteryUnitBlock::update_kappa_in_cnstrs: "
-                             "expected Variable not found in "
-                             "active_power_bounds_design_Const." ) );
-
-   f0->modify_coefficient( batt_design_idx0 ,
-                           -f_kappa * v_MinPower[ t ] ,
-                           issueAMod );
-
-   auto f1 = static_cast< LinearFunction * >(
-    active_power_bounds_design_Const[ 1 ][ t ].get_function() );
-
-   const auto batt_design_idx1 = f1->is_active( &batt_design );
-
-   if( batt_design_idx1 == Inf< Index >() )
-    throw( std::logic_error( "BatteryUnitBlock::update_kappa_in_cnstrs: "
-                             "expected Variable not found in "
-                             "active_power_bounds_design_Const." ) );
-
-   f1->modify_coefficient( batt_design_idx1 ,
-                           -f_kappa * v_MaxPower[ t ] ,
-                           issueAMod );
+   active_power_box_Const[ t ].set_lhs( f_kappa * v_MinPower[ t ] , nAM );
+   active_power_box_Const[ t ].set_rhs( f_kappa * v_MaxPower[ t ] , nAM );
   }
 
+ else if( ! active_power_bounds_design_Const.empty() ) {
+  upd_coeff( active_power_bounds_design_Const[ 0 ] ,
+             f_design_pos_active_power , -f_kappa , v_MinPower , bd ,
+             "active_power_bounds_design_Const." );
+  upd_coeff( active_power_bounds_design_Const[ 1 ] ,
+             f_design_pos_active_power , -f_kappa , v_MaxPower , bd ,
+             "active_power_bounds_design_Const." );
+ }
+
  if( ! storage_level_bounds_Const.empty() )
 
   for( Index t = 0 ; t < f_time_horizon ; ++t ) {
    storage_level_bounds_Const[ t ].set_lhs(
-    f_kappa * v_MinStorage[ t ] , issueAMod );
+    f_kappa * v_MinStorage[ t ] , nAM );
    storage_level_bounds_Const[ t ].set_rhs(
-    f_kappa * v_MaxStorage[ t ] , issueAMod );
+    f_kappa * v_MaxStorage[ t ] , nAM );
   }
 
- else if( ! storage_level_bounds_design_Const.empty() )
-
-  for( Index t = 0 ; t < f_time_horizon ; ++t ) {
-
-   auto f0 = static_cast< LinearFunction * >(
-    storage_level_bounds_design_Const[ 0 ][ t ].get_function() );
-
-   const auto batt_design_idx0 = f0->is_active( &batt_design );
-
-   if( batt_design_idx0 == Inf< Index >() )
-    throw( std::logic_error( "BatteryUnitBlock::update_kappa_in_cnstrs: "
-                             "expected Variable not found in "
-                             "storage_level_bounds_design_Const." ) );
-
-   f0->modify_coefficient( batt_design_idx0 ,
-                           -f_kappa * v_MinStorage[ t ] ,
-                           issueAMod );
-
-   auto f1 = static_cast< LinearFunction * >(
-    storage_level_bounds_design_Const[ 1 ][ t ].get_function() );
-
-   const auto batt_design_idx1 = f1->is_active( &batt_design );
-
-   if( batt_design_idx1 == Inf< Index >() )
-    throw( std::logic_error( "BatteryUnitBlock::update_kappa_in_cnstrs: "
-                             "expected Variable not found in "
-                             "storage_level_bounds_design_Const." ) );
-
-   f1->modify_coefficient( batt_design_idx1 ,
-                           -f_kappa * v_MaxStorage[ t ] ,
-                           issueAMod );
-  }
+ else if( ! storage_level_bounds_design_Const.empty() ) {
+  upd_coeff( storage_level_bounds_design_Const[ 0 ] , SLBDPos ,
+             -f_kappa , v_MinStorage , bd ,
+             "storage_level_bounds_design_Const." );
+  upd_coeff( storage_level_bounds_design_Const[ 1 ] , SLBDPos ,
+             -f_kappa , v_MaxStorage , bd ,
+             "storage_level_bounds_design_Const." );
+ }
 
  if( ( ! intake_outtake_binary_Const.empty() ) &&
      ( ! intake_outtake_binary_Const[ 0 ].empty() ) )
-
-  for( Index t = 0 ; t < f_time_horizon ; ++t ) {
-
-   auto f = static_cast< LinearFunction * >(
-    intake_outtake_binary_Const[ 0 ][ t ].get_function() );
-
-   const auto index = f->is_active( &v_battery_binary[ t ] );
-
-   if( index == Inf< Index >() )
-    throw( std::logic_error( "BatteryUnitBlock::set_kappa: expected Variable"
-                             "not found in intake_binary_Const." ) );
-
-   f->modify_coefficient( index , -f_kappa * v_MaxPower[ t ] , issueAMod );
-  }
+  upd_coeff( intake_outtake_binary_Const[ 0 ] , IOBinPos ,
+             -f_kappa , v_MaxPower , bb , "intake_binary_Const." );
 
  if( ( ! intake_outtake_binary_Const.empty() ) &&
-     ( ! intake_outtake_binary_Const[ 1 ].empty() ) )
-
-  for( Index t = 0 ; t < f_time_horizon ; ++t ) {
-
-   auto f = static_cast< LinearFunction * >
-    ( intake_outtake_binary_Const[ 1 ][ t ].get_function() );
-
-   const auto index = f->is_active( &v_battery_binary[ t ] );
-
-   if( index == Inf< Index >() )
-    throw( std::logic_error( "BatteryUnitBlock::set_kappa: expected Variable"
-                             "not found in outtake_binary_Const." ) );
-
-   f->modify_coefficient( index , -f_kappa * v_MinPower[ t ] , issueAMod );
+     ( ! intake_outtake_binary_Const[ 1 ].empty() ) ) {
+  upd_coeff( intake_outtake_binary_Const[ 1 ] , IOBinPos ,
+             -f_kappa , v_MinPower , bb , "outtake_binary_Const." );
 
+  for( Index t = 0 ; t < f_time_horizon ; ++t )
    intake_outtake_binary_Const[ 1 ][ t ].set_rhs(
-    -f_kappa * v_MinPower[ t ] , issueAMod );
-  }
+    -f_kappa * v_MinPower[ t ] , nAM );
+ }
 
  if( ! primary_upper_bound_Const.empty() )
   for( Index t = 0 ; t < f_time_horizon ; ++t )
    primary_upper_bound_Const[ t ].set_rhs( f_kappa * v_MaxPrimaryPower[ t ] ,
-                                           issueAMod );
+                                           nAM );
 
  if( ! secondary_upper_bound_Const.empty() )
   for( Index t = 0 ; t < f_time_horizon ; ++t )
    secondary_upper_bound_Const[ t ].set_rhs( f_kappa * v_MaxSecondaryPower[ t ] ,
-                                             issueAMod );
+                                             nAM );
+
+ // at the end close the channel
+ close_packing_channel( par2chnl( nAM ) , issueAMod );
 
  }  // end( BatteryUnitBlock::update_kappa_in_cnstrs )
 
@@ -37,6 +37,10 @@
 
 #include "FRealObjective.h"
 
+#include "NewLinearFunction.h"
+
+#include "UCTrace.h"
+
 /*--------------------------------------------------------------------------*/
 /*------------------------- NAMESPACE AND USING ----------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -184,6 +188,7 @@ void DCNetworkData::deserialize( const netCDF::NcGroup & group )
 
 void DCNetworkBlock::deserialize( const netCDF::NcGroup & group )
 {
+ UCBLOCK_TRACE_SPAN( "DCNetworkBlock::deserialize" );
 
 #ifndef NDEBUG
  static std::vector< std::string > expected_dims = { "NumberNodes" };
@@ -240,8 +245,31 @@ void DCNetworkBlock::deserialize( const netCDF::NcGroup & group )
 
 /*--------------------------------------------------------------------------*/
 
+NetworkBlock * DCNetworkBlock::clone( Block * father ) const
+{
+ auto network = std::make_unique< DCNetworkBlock >( father );
+ network->clone_data( *this );
+
+ if( f_local_NetworkData ) {
+  network->f_NetworkData = static_cast< DCNetworkData * >(
+   f_NetworkData->clone() );
+  network->f_local_NetworkData = true;
+ }
+ else
+  network->f_NetworkData = f_NetworkData;
+
+ network->v_ActiveDemand = v_ActiveDemand;
+ network->v_kappa = v_kappa;
+
+ return( network.release() );
+}
+
+/*--------------------------------------------------------------------------*/
+
 void DCNetworkBlock::generate_abstract_variables( Configuration * stvv )
 {
+ UCBLOCK_TRACE_SPAN( "DCNetworkBlock::generate_abstract_variables" );
+
  if( variables_generated() )  // variables have already been generated
   return;                     // nothing to do
 
@@ -273,6 +301,8 @@ void DCNetworkBlock::generate_abstract_variables( Configuration * stvv )
 
 void DCNetworkBlock::generate_abstract_constraints( Configuration * stcc )
 {
+ UCBLOCK_TRACE_SPAN( "DCNetworkBlock::generate_abstract_constraints" );
+
  if( constraints_generated() )  // constraints have already been generated
   return;                       // nothing to do
 
@@ -332,7 +362,7 @@ void DCNetworkBlock::generate_abstract_constraints( Configuration * stcc )
 
    v_power_flow_injection_const[ n ].set_both( -v_ActiveDemand[ n ] );
    v_power_flow_injection_const[ n ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
   }
 
   add_static_constraint( v_power_flow_injection_const ,
@@ -355,7 +385,7 @@ void DCNetworkBlock::generate_abstract_constraints( Configuration * stcc )
     v_power_flow_relax_abs[ 0 ][ line_id ].set_lhs( 0.0 );
     v_power_flow_relax_abs[ 0 ][ line_id ].set_rhs( Inf< double >() );
     v_power_flow_relax_abs[ 0 ][ line_id ].set_function(
-     new LinearFunction( std::move( vars ) ) );
+     new_LinearFunction( vars ) );
 
     // - F_l <= V_l
 
@@ -365,7 +395,7 @@ void DCNetworkBlock::generate_abstract_constraints( Configuration * stcc )
     v_power_flow_relax_abs[ 1 ][ line_id ].set_lhs( 0.0 );
     v_power_flow_relax_abs[ 1 ][ line_id ].set_rhs( Inf< double >() );
     v_power_flow_relax_abs[ 1 ][ line_id ].set_function(
-     new LinearFunction( std::move( vars ) ) );
+     new_LinearFunction( vars ) );
    }
 
    add_static_constraint( v_power_flow_relax_abs , "power_flow_relax_abs" );
@@ -401,7 +431,7 @@ void DCNetworkBlock::generate_abstract_constraints( Configuration * stcc )
    v_AC_power_flow_limit_const[ line_id ].set_rhs(
     kappa * get_max_power_flow( line_id ) - constant_term );
    v_AC_power_flow_limit_const[ line_id ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
   }
 
   add_static_constraint( v_AC_power_flow_limit_const ,
@@ -448,6 +478,8 @@ void DCNetworkBlock::generate_abstract_constraints( Configuration * stcc )
 
 void DCNetworkBlock::generate_objective( Configuration * objc )
 {
+ UCBLOCK_TRACE_SPAN( "DCNetworkBlock::generate_objective" );
+
  if( objective_generated() )  // Objective has already been generated
   return;                     // nothing to do
 
@@ -566,6 +598,17 @@ void DCNetworkData::serialize( netCDF::NcGroup & group ) const {
 
 /*--------------------------------------------------------------------------*/
 
+MemoryUsage DCNetworkData::get_memory_usage( void ) const
+{
+ MemoryUsage usage;
+ usage.add_data( v_start_line , v_end_line , v_susceptance ,
+                 v_min_power_flow , v_max_power_flow , v_network_cost ,
+                 v_node_names , v_line_names );
+ return( usage );
+}  // end( DCNetworkData::get_memory_usage )
+
+/*--------------------------------------------------------------------------*/
+
 void DCNetworkBlock::serialize( netCDF::NcGroup & group ) const
 {
  NetworkBlock::serialize( group );
@@ -599,6 +642,15 @@ void DCNetworkBlock::serialize( netCDF::NcGroup & group ) const
 
 }  // end( DCNetworkBlock::serialize )
 
+/*--------------------------------------------------------------------------*/
+
+MemoryUsage DCNetworkBlock::get_memory_usage( void ) const
+{
+ auto usage = NetworkBlock::get_memory_usage();
+ usage.add_data( v_ActiveDemand , v_kappa );
+ return( usage );
+}  // end( DCNetworkBlock::get_memory_usage )
+
 /*--------------------------------------------------------------------------*/
 /*------------------------ METHODS FOR CHANGING DATA -----------------------*/
 /*--------------------------------------------------------------------------*/
@@ -26,8 +26,13 @@
 
 #include "LinearFunction.h"
 
+#include "NewLinearFunction.h"
+
+
 #include "UCBlock.h"
 
+#include "UCTrace.h"
+
 /*--------------------------------------------------------------------------*/
 /*------------------------- NAMESPACE AND USING ----------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -122,6 +127,7 @@ void ECNetworkData::deserialize( const netCDF::NcGroup & group )
 
 void ECNetworkBlock::deserialize( const netCDF::NcGroup & group )
 {
+ UCBLOCK_TRACE_SPAN( "ECNetworkBlock::deserialize" );
 
 #ifndef NDEBUG
  static std::vector< std::string > expected_dims = { "NumberNodes" ,
@@ -181,8 +187,34 @@ void ECNetworkBlock::deserialize( const netCDF::NcGroup & group )
 
 /*--------------------------------------------------------------------------*/
 
+NetworkBlock * ECNetworkBlock::clone( Block * father ) const
+{
+ auto network = std::make_unique< ECNetworkBlock >( father );
+ network->clone_data( *this );
+
+ if( f_local_NetworkData ) {
+  network->f_NetworkData = static_cast< ECNetworkData * >(
+   f_NetworkData->clone() );
+  network->f_local_NetworkData = true;
+ }
+ else
+  network->f_NetworkData = f_NetworkData;
+
+ UCBlock::copy_multi_array( network->v_ActiveDemand , v_ActiveDemand );
+ network->v_BuyPrice = v_BuyPrice;
+ network->v_SellPrice = v_SellPrice;
+ network->v_RewardPrice = v_RewardPrice;
+ network->f_PeakTariff = f_PeakTariff;
+
+ return( network.release() );
+}
+
+/*--------------------------------------------------------------------------*/
+
 void ECNetworkBlock::generate_abstract_variables( Configuration * stvv )
 {
+ UCBLOCK_TRACE_SPAN( "ECNetworkBlock::generate_abstract_variables" );
+
  if( variables_generated() )  // variables have already been generated
   return;                     // nothing to do
 
@@ -229,6 +261,8 @@ void ECNetworkBlock::generate_abstract_variables( Configuration * stvv )
 
 void ECNetworkBlock::generate_abstract_constraints( Configuration * stcc )
 {
+ UCBLOCK_TRACE_SPAN( "ECNetworkBlock::generate_abstract_constraints" );
+
  if( constraints_generated() )  // constraints have already been generated
   return;                       // nothing to do
 
@@ -260,7 +294,7 @@ void ECNetworkBlock::generate_abstract_constraints( Configuration * stcc )
    power_balance_const[ node_id ][ i ].set_both(
     -v_ActiveDemand[ i ][ node_id ] );
    power_balance_const[ node_id ][ i ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
   }
 
  add_static_constraint( power_balance_const , "Power_Balance_Const_Network" );
@@ -303,7 +337,7 @@ void ECNetworkBlock::generate_abstract_constraints( Configuration * stcc )
    power_shared_const[ i ][ 0 ].set_lhs( -Inf< double >() );
    power_shared_const[ i ][ 0 ].set_rhs( 0.0 );
    power_shared_const[ i ][ 0 ].set_function(
-    new LinearFunction( std::move( vars_inj ) ) );
+    new_LinearFunction( vars_inj ) );
 
    // case (2)
    vars_abs.push_back( std::make_pair( &v_shared_power[ i ] , 1.0 ) );
@@ -311,7 +345,7 @@ void ECNetworkBlock::generate_abstract_constraints( Configuration * stcc )
    power_shared_const[ i ][ 1 ].set_lhs( -Inf< double >() );
    power_shared_const[ i ][ 1 ].set_rhs( 0.0 );
    power_shared_const[ i ][ 1 ].set_function(
-    new LinearFunction( std::move( vars_abs ) ) );
+    new_LinearFunction( vars_abs ) );
   }
 
   add_static_constraint( power_shared_const ,
@@ -353,13 +387,13 @@ void ECNetworkBlock::generate_abstract_constraints( Configuration * stcc )
    power_flow_limit_const[ node_id ][ i ][ 0 ].set_lhs( 0.0 );
    power_flow_limit_const[ node_id ][ i ][ 0 ].set_rhs( Inf< double >() );
    power_flow_limit_const[ node_id ][ i ][ 0 ].set_function(
-    new LinearFunction( std::move( vars_inj ) ) );
+    new_LinearFunction( vars_inj ) );
 
    // case (2)
    power_flow_limit_const[ node_id ][ i ][ 1 ].set_lhs( 0.0 );
    power_flow_limit_const[ node_id ][ i ][ 1 ].set_rhs( Inf< double >() );
    power_flow_limit_const[ node_id ][ i ][ 1 ].set_function(
-    new LinearFunction( std::move( vars_abs ) ) );
+    new_LinearFunction( vars_abs ) );
   }
 
  add_static_constraint( power_flow_limit_const ,
@@ -394,6 +428,8 @@ void ECNetworkBlock::generate_abstract_constraints( Configuration * stcc )
 
 void ECNetworkBlock::generate_objective( Configuration * objc )
 {
+ UCBLOCK_TRACE_SPAN( "ECNetworkBlock::generate_objective" );
+
  if( objective_generated() )  // Objective has already been generated
   return;                     // nothing to do
 
@@ -548,6 +584,15 @@ void ECNetworkBlock::serialize( netCDF::NcGroup & group ) const
 
 }  // end( ECNetworkBlock::serialize )
 
+/*--------------------------------------------------------------------------*/
+
+MemoryUsage ECNetworkBlock::get_memory_usage( void ) const
+{
+ auto usage = NetworkBlock::get_memory_usage();
+ usage.add_data( v_ActiveDemand , v_BuyPrice , v_SellPrice , v_RewardPrice );
+ return( usage );
+}  // end( ECNetworkBlock::get_memory_usage )
+
 /*--------------------------------------------------------------------------*/
 /*------------------------ METHODS FOR CHANGING DATA -----------------------*/
 /*--------------------------------------------------------------------------*/
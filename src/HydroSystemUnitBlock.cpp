@@ -26,6 +26,10 @@
 
 #include "FRealObjective.h"
 
+#include "UCTrace.h"
+
+#include <typeinfo>
+
 /*--------------------------------------------------------------------------*/
 /*------------------------- NAMESPACE AND USING ----------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -66,12 +70,15 @@ HydroUnitBlock * HydroSystemUnitBlock::get_hydro_unit_block( Index i ) const
 
 void HydroSystemUnitBlock::deserialize( const netCDF::NcGroup & group )
 {
+ UCBLOCK_TRACE_SPAN( "HydroSystemUnitBlock::deserialize" );
 
 #ifndef NDEBUG
- static std::vector< std::string > expected_dims = { "TimeHorizon" ,
-                                                     "NumberIntervals" ,
-                                                     "NumberHydroUnits" };
- check_dimensions( group , expected_dims , std::cerr );
+ if( ! validated_data() ) {
+  static std::vector< std::string > expected_dims = { "TimeHorizon" ,
+                                                      "NumberIntervals" ,
+                                                      "NumberHydroUnits" };
+  check_dimensions( group , expected_dims , std::cerr );
+ }
 #endif
 
  UnitBlock::deserialize_time_horizon( group );
@@ -83,6 +90,38 @@ void HydroSystemUnitBlock::deserialize( const netCDF::NcGroup & group )
 
 /*--------------------------------------------------------------------------*/
 
+UnitBlock * HydroSystemUnitBlock::clone( Block * father ) const
+{
+ auto unit = std::make_unique< HydroSystemUnitBlock >( father );
+ unit->clone_data( *this );
+ unit->f_number_hydro_units = f_number_hydro_units;
+
+ unit->v_Block.reserve( v_Block.size() );
+ for( Index i = 0 ; i < v_Block.size() ; ++i )
+  if( i < f_number_hydro_units )
+   unit->v_Block.push_back( static_cast< HydroUnitBlock * >( v_Block[ i ] )
+                            ->clone( unit.get() ) );
+  else {  // the PolyhedralFunctionBlock
+   if( typeid( *v_Block[ i ] ) != typeid( PolyhedralFunctionBlock ) )
+    throw( std::logic_error( "HydroSystemUnitBlock::clone: cannot copy a "
+                             + v_Block[ i ]->classname() ) );
+   auto pfb = new PolyhedralFunctionBlock( unit.get() );
+   unit->v_Block.push_back( pfb );
+   const auto & from = static_cast< PolyhedralFunctionBlock * >( v_Block[ i ] )
+    ->get_PolyhedralFunction();
+   auto A = from.get_A();
+   auto b = from.get_b();
+   // the active Variable are set by generate_abstract_variables()
+   pfb->get_PolyhedralFunction().set_PolyhedralFunction(
+    std::move( A ) , std::move( b ) , from.get_global_bound() ,
+    from.is_convex() , eNoMod );
+  }
+
+ return( unit.release() );
+}
+
+/*--------------------------------------------------------------------------*/
+
 void HydroSystemUnitBlock::deserialize_sub_blocks( const netCDF::NcGroup & group )
 {
  for( auto block : v_Block )
@@ -169,6 +208,8 @@ void HydroSystemUnitBlock::deserialize_sub_blocks(
 
 void HydroSystemUnitBlock::generate_abstract_variables( Configuration * stvv )
 {
+ UCBLOCK_TRACE_SPAN( "HydroSystemUnitBlock::generate_abstract_variables" );
+
  if( variables_generated() )  // variables have already been generated
   return;                     // nothing to do
 
@@ -203,6 +244,8 @@ void HydroSystemUnitBlock::generate_abstract_variables( Configuration * stvv )
 
 void HydroSystemUnitBlock::generate_objective( Configuration * objc )
 {
+ UCBLOCK_TRACE_SPAN( "HydroSystemUnitBlock::generate_objective" );
+
  if( objective_generated() )  // Objective has already been generated
   return;                     // nothing to do
 
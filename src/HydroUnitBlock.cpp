@@ -30,14 +30,21 @@
 
 #include "LinearFunction.h"
 
+#include "NewLinearFunction.h"
+
+
 #include "FRowConstraint.h"
 
 #include "FRealObjective.h"
 
 #include "OneVarConstraint.h"
 
+#include "UCBlock.h"
+
 #include "UnitBlock.h"
 
+#include "UCTrace.h"
+
 /*--------------------------------------------------------------------------*/
 /*------------------------- NAMESPACE AND USING ----------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -81,37 +88,40 @@ HydroUnitBlock::~HydroUnitBlock()
 
 void HydroUnitBlock::deserialize( const netCDF::NcGroup & group )
 {
+ UCBLOCK_TRACE_SPAN( "HydroUnitBlock::deserialize" );
 
 #ifndef NDEBUG
- std::vector< std::string > expected_dims = { "TimeHorizon" ,
-                                              "NumberIntervals" ,
-                                              "NumberReservoirs" ,
-                                              "NumberArcs" ,
-                                              "TotalNumberPieces" };
- check_dimensions( group , expected_dims , std::cerr );
-
- std::vector< std::string > expected_vars = { "StartArc" ,
-                                              "EndArc" ,
-                                              "MinFlow" ,
-                                              "MaxFlow" ,
-                                              "MinVolumetric" ,
-                                              "MaxVolumetric" ,
-                                              "Inflows" ,
-                                              "MinPower" ,
-                                              "MaxPower" ,
-                                              "DeltaRampUp" ,
-                                              "DeltaRampDown" ,
-                                              "PrimaryRho" ,
-                                              "SecondaryRho" ,
-                                              "NumberPieces" ,
-                                              "LinearTerm" ,
-                                              "ConstantTerm" ,
-                                              "InertiaPower" ,
-                                              "InitialFlowRate" ,
-                                              "InitialVolumetric" ,
-                                              "UphillFlow" ,
-                                              "DownhillFlow" };
- check_variables( group , expected_vars , std::cerr );
+ if( ! validated_data() ) {
+  std::vector< std::string > expected_dims = { "TimeHorizon" ,
+                                               "NumberIntervals" ,
+                                               "NumberReservoirs" ,
+                                               "NumberArcs" ,
+                                               "TotalNumberPieces" };
+  check_dimensions( group , expected_dims , std::cerr );
+
+  std::vector< std::string > expected_vars = { "StartArc" ,
+                                               "EndArc" ,
+                                               "MinFlow" ,
+                                               "MaxFlow" ,
+                                               "MinVolumetric" ,
+                                               "MaxVolumetric" ,
+                                               "Inflows" ,
+                                               "MinPower" ,
+                                               "MaxPower" ,
+                                               "DeltaRampUp" ,
+                                               "DeltaRampDown" ,
+                                               "PrimaryRho" ,
+                                               "SecondaryRho" ,
+                                               "NumberPieces" ,
+                                               "LinearTerm" ,
+                                               "ConstantTerm" ,
+                                               "InertiaPower" ,
+                                               "InitialFlowRate" ,
+                                               "InitialVolumetric" ,
+                                               "UphillFlow" ,
+                                               "DownhillFlow" };
+  check_variables( group , expected_vars , std::cerr );
+ }
 #endif
 
  UnitBlock::deserialize_time_horizon( group );
@@ -213,8 +223,47 @@ void HydroUnitBlock::deserialize( const netCDF::NcGroup & group )
 
 /*--------------------------------------------------------------------------*/
 
+UnitBlock * HydroUnitBlock::clone( Block * father ) const
+{
+ auto unit = std::make_unique< HydroUnitBlock >( father );
+ unit->clone_data( *this );
+
+ unit->f_NumberReservoirs = f_NumberReservoirs;
+ unit->f_NumberArcs = f_NumberArcs;
+ unit->f_TotalNumberPieces = f_TotalNumberPieces;
+
+ unit->v_UphillDelay = v_UphillDelay;
+ unit->v_DownhillDelay = v_DownhillDelay;
+ unit->v_StartArc = v_StartArc;
+ unit->v_EndArc = v_EndArc;
+ unit->v_InitialVolumetric = v_InitialVolumetric;
+ unit->v_InitialFlowRate = v_InitialFlowRate;
+ unit->v_NumberPieces = v_NumberPieces;
+ unit->v_LinearTerm = v_LinearTerm;
+ unit->v_ConstTerm = v_ConstTerm;
+
+ UCBlock::copy_multi_array( unit->v_InertiaPower , v_InertiaPower );
+ UCBlock::copy_multi_array( unit->v_MinVolumetric , v_MinVolumetric );
+ UCBlock::copy_multi_array( unit->v_MaxVolumetric , v_MaxVolumetric );
+ UCBlock::copy_multi_array( unit->v_inflows , v_inflows );
+ UCBlock::copy_multi_array( unit->v_MinPower , v_MinPower );
+ UCBlock::copy_multi_array( unit->v_MaxPower , v_MaxPower );
+ UCBlock::copy_multi_array( unit->v_MinFlow , v_MinFlow );
+ UCBlock::copy_multi_array( unit->v_MaxFlow , v_MaxFlow );
+ UCBlock::copy_multi_array( unit->v_DeltaRampUp , v_DeltaRampUp );
+ UCBlock::copy_multi_array( unit->v_DeltaRampDown , v_DeltaRampDown );
+ UCBlock::copy_multi_array( unit->v_PrimaryRho , v_PrimaryRho );
+ UCBlock::copy_multi_array( unit->v_SecondaryRho , v_SecondaryRho );
+
+ return( unit.release() );
+}
+
+/*--------------------------------------------------------------------------*/
+
 void HydroUnitBlock::generate_abstract_variables( Configuration * stvv )
 {
+ UCBLOCK_TRACE_SPAN( "HydroUnitBlock::generate_abstract_variables" );
+
  if( variables_generated() )  // variables have already been generated
   return;                     // nothing to do
 
@@ -278,6 +327,8 @@ void HydroUnitBlock::generate_abstract_variables( Configuration * stvv )
 
 void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
 {
+ UCBLOCK_TRACE_SPAN( "HydroUnitBlock::generate_abstract_constraints" );
+
  if( constraints_generated() )  // constraints have already been generated
   return;                       // nothing to do
 
@@ -332,7 +383,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
     FinalVolumeReservoir_Const[ t ][ n ].set_both( initial_volume );
 
    FinalVolumeReservoir_Const[ t ][ n ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
   }
  }
 
@@ -414,7 +465,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
    else
     MaxPowerPrimarySecondary_Const[ t ][ arc ].set_rhs( 0.0 );
    MaxPowerPrimarySecondary_Const[ t ][ arc ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
   }
  }
 
@@ -452,7 +503,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
     MinPowerPrimarySecondary_Const[ t ][ arc ].set_lhs( 0.0 );
    MinPowerPrimarySecondary_Const[ t ][ arc ].set_rhs( Inf< double >() );
    MinPowerPrimarySecondary_Const[ t ][ arc ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
   }
  }
 
@@ -487,7 +538,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
        ActivePowerPrimary_Const[ t ][ arc ].set_lhs( 0.0 );
        ActivePowerPrimary_Const[ t ][ arc ].set_rhs( Inf< double >() );
        ActivePowerPrimary_Const[ t ][ arc ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
       }
 
       if( ( v_MaxFlow[ t ][ arc ] <= 0 ) &&
@@ -497,7 +548,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
                                        1.0 ) );
        ActivePowerPrimary_Const[ t ][ arc ].set_both( 0.0 );
        ActivePowerPrimary_Const[ t ][ arc ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
       }
 
       if( ( v_MaxFlow[ t ][ arc ] == 0 ) &&
@@ -506,7 +557,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
        vars.push_back( std::make_pair( get_flow_rate( arc , t ) , 1.0 ) );
        ActivePowerPrimary_Const[ t ][ arc ].set_both( 0.0 );
        ActivePowerPrimary_Const[ t ][ arc ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
       }
      }
     }
@@ -528,7 +579,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
        ActivePowerPrimary_Const[ t ][ arc ].set_lhs( 0.0 );
        ActivePowerPrimary_Const[ t ][ arc ].set_rhs( Inf< double >() );
        ActivePowerPrimary_Const[ t ][ arc ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
       }
 
       if( v_MaxFlow[ t ][ arc ] == 0 ) {  // Nothing
@@ -537,7 +588,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
        ActivePowerPrimary_Const[ t ][ arc ].set_both( 0.0 );
        ActivePowerPrimary_Const[ t ][ arc ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
       }
      }
     }
@@ -575,7 +626,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
        ActivePowerSecondary_Const[ t ][ arc ].set_lhs( 0.0 );
        ActivePowerSecondary_Const[ t ][ arc ].set_rhs( Inf< double >() );
        ActivePowerSecondary_Const[ t ][ arc ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
       }
 
       if( ( v_MaxFlow[ t ][ arc ] <= 0 ) &&
@@ -586,7 +637,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
        ActivePowerSecondary_Const[ t ][ arc ].set_both( 0.0 );
        ActivePowerSecondary_Const[ t ][ arc ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
       }
 
       if( ( v_MaxFlow[ t ][ arc ] == 0 ) &&
@@ -596,7 +647,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
        ActivePowerSecondary_Const[ t ][ arc ].set_both( 0.0 );
        ActivePowerSecondary_Const[ t ][ arc ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
       }
      }
     }
@@ -618,7 +669,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
        ActivePowerSecondary_Const[ t ][ arc ].set_lhs( 0.0 );
        ActivePowerSecondary_Const[ t ][ arc ].set_rhs( Inf< double >() );
        ActivePowerSecondary_Const[ t ][ arc ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
       }
 
       if( v_MaxFlow[ t ][ arc ] == 0 ) {  // Nothing
@@ -628,7 +679,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
        ActivePowerSecondary_Const[ t ][ arc ].set_both( 0.0 );
        ActivePowerSecondary_Const[ t ][ arc ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
       }
      }
     }
@@ -679,7 +730,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
         FlowActivePower_Const[ t ][ piece ].set_rhs( 0.0 );
        FlowActivePower_Const[ t ][ piece ].set_lhs( -Inf< double >() );
        FlowActivePower_Const[ t ][ piece ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
       }
      }
 
@@ -692,7 +743,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
       FlowActivePower_Const[ t ][ cnstr_idx ].set_both( 0.0 );
       FlowActivePower_Const[ t ][ cnstr_idx ].set_function(
-       new LinearFunction( std::move( vars ) ) );
+       new_LinearFunction( vars ) );
 
       ++cnstr_idx;
       piece = cnstr_idx;
@@ -705,7 +756,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
       FlowActivePower_Const[ t ][ cnstr_idx ].set_both( 0.0 );
       FlowActivePower_Const[ t ][ cnstr_idx ].set_function(
-       new LinearFunction( std::move( vars ) ) );
+       new_LinearFunction( vars ) );
 
       ++cnstr_idx;
       piece = cnstr_idx;
@@ -748,7 +799,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
         FlowActivePower_Const[ t ][ piece ].set_rhs( 0.0 );
        FlowActivePower_Const[ t ][ piece ].set_lhs( -Inf< double >() );
        FlowActivePower_Const[ t ][ piece ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
       }
      }
 
@@ -758,7 +809,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
       FlowActivePower_Const[ t ][ cnstr_idx ].set_both( 0.0 );
       FlowActivePower_Const[ t ][ cnstr_idx ].set_function(
-       new LinearFunction( std::move( vars ) ) );
+       new_LinearFunction( vars ) );
 
       ++cnstr_idx;
       piece = cnstr_idx;
@@ -821,7 +872,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
    RampUp_Const[ 0 ][ arc ].set_rhs( v_DeltaRampUp[ 0 ][ arc ] +
                                      get_initial_flow_rate( arc ) );
    RampUp_Const[ 0 ][ arc ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
 
    for( Index t = 1 , cnstr_idx = 1 ; t < f_time_horizon ; ++t , ++cnstr_idx ) {
 
@@ -831,7 +882,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
     RampUp_Const[ cnstr_idx ][ arc ].set_lhs( -Inf< double >() );
     RampUp_Const[ cnstr_idx ][ arc ].set_rhs( v_DeltaRampUp[ t ][ arc ] );
     RampUp_Const[ cnstr_idx ][ arc ].set_function(
-     new LinearFunction( std::move( vars ) ) );
+     new_LinearFunction( vars ) );
    }
   }
 
@@ -857,7 +908,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
                                        v_DeltaRampDown[ 0 ][ arc ] );
    RampDown_Const[ 0 ][ arc ].set_rhs( Inf< double >() );
    RampDown_Const[ 0 ][ arc ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
 
    for( Index t = 1 , cnstr_idx = 1 ; t < f_time_horizon ; ++t , ++cnstr_idx ) {
 
@@ -868,7 +919,7 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
     RampDown_Const[ cnstr_idx ][ arc ].set_rhs(
      v_DeltaRampDown[ t ][ arc ] );
     RampDown_Const[ cnstr_idx ][ arc ].set_function(
-     new LinearFunction( std::move( vars ) ) );
+     new_LinearFunction( vars ) );
    }
   }
 
@@ -921,6 +972,8 @@ void HydroUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
 void HydroUnitBlock::generate_objective( Configuration * objc )
 {
+ UCBLOCK_TRACE_SPAN( "HydroUnitBlock::generate_objective" );
+
  if( objective_generated() )  // Objective has already been generated
   return;                     // nothing to do
 
@@ -1077,6 +1130,20 @@ void HydroUnitBlock::serialize( netCDF::NcGroup & group ) const
 
 }  // end( HydroUnitBlock::serialize )
 
+/*--------------------------------------------------------------------------*/
+
+MemoryUsage HydroUnitBlock::get_memory_usage( void ) const
+{
+ auto usage = UnitBlock::get_memory_usage();
+ usage.add_data( v_UphillDelay , v_DownhillDelay , v_StartArc , v_EndArc ,
+                 v_InitialVolumetric , v_InitialFlowRate , v_NumberPieces ,
+                 v_LinearTerm , v_ConstTerm , v_InertiaPower ,
+                 v_MinVolumetric , v_MaxVolumetric , v_inflows , v_MinPower ,
+                 v_MaxPower , v_MinFlow , v_MaxFlow , v_DeltaRampUp ,
+                 v_DeltaRampDown , v_PrimaryRho , v_SecondaryRho );
+ return( usage );
+}  // end( HydroUnitBlock::get_memory_usage )
+
 /*--------------------------------------------------------------------------*/
 /*------------------------ METHODS FOR CHANGING DATA -----------------------*/
 /*--------------------------------------------------------------------------*/
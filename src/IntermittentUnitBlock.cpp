@@ -39,10 +39,15 @@
 
 #include "LinearFunction.h"
 
+#include "NewLinearFunction.h"
+
+
 #include "FRealObjective.h"
 
 #include "UnitBlock.h"
 
+#include "UCTrace.h"
+
 /*--------------------------------------------------------------------------*/
 /*------------------------- NAMESPACE AND USING ----------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -77,18 +82,21 @@ IntermittentUnitBlock::~IntermittentUnitBlock()
 
 void IntermittentUnitBlock::deserialize( const netCDF::NcGroup & group )
 {
+ UCBLOCK_TRACE_SPAN( "IntermittentUnitBlock::deserialize" );
 
 #ifndef NDEBUG
- static std::vector< std::string > expected_dims = { "TimeHorizon" ,
-                                                     "NumberIntervals" };
- check_dimensions( group , expected_dims , std::cerr );
-
- static std::vector< std::string > expected_vars = { "InvestmentCost" ,
-                                                     "MaxCapacity" ,
-                                                     "MinPower" , "MaxPower" ,
-                                                     "InertiaPower" ,
-                                                     "Gamma" , "Kappa" };
- check_variables( group , expected_vars , std::cerr );
+ if( ! validated_data() ) {
+  static std::vector< std::string > expected_dims = { "TimeHorizon" ,
+                                                      "NumberIntervals" };
+  check_dimensions( group , expected_dims , std::cerr );
+
+  static std::vector< std::string > expected_vars = { "InvestmentCost" ,
+                                                      "MaxCapacity" ,
+                                                      "MinPower" , "MaxPower" ,
+                                                      "InertiaPower" ,
+                                                      "Gamma" , "Kappa" };
+  check_variables( group , expected_vars , std::cerr );
+ }
 #endif
 
  // Deserialize data from the base class
@@ -125,12 +133,34 @@ void IntermittentUnitBlock::deserialize( const netCDF::NcGroup & group )
    if( v_MaxPower[ t ] == 0.0 )
     v_MaxPower[ t ] = f_max_power_epsilon;
 
- check_data_consistency();
+ if( ! validated_data() )
+  check_data_consistency();
 
 }  // end( IntermittentUnitBlock::deserialize )
 
 /*--------------------------------------------------------------------------*/
 
+UnitBlock * IntermittentUnitBlock::clone( Block * father ) const
+{
+ auto unit = std::make_unique< IntermittentUnitBlock >( father );
+ unit->clone_data( *this );
+
+ unit->v_MinPower = v_MinPower;
+ unit->v_MaxPower = v_MaxPower;
+ unit->v_InertiaPower = v_InertiaPower;
+
+ unit->f_InvestmentCost = f_InvestmentCost;
+ unit->f_MaxCapacity = f_MaxCapacity;
+ unit->f_gamma = f_gamma;
+ unit->f_kappa = f_kappa;
+ unit->f_scale = f_scale;
+ unit->f_max_power_epsilon = f_max_power_epsilon;
+
+ return( unit.release() );
+}
+
+/*--------------------------------------------------------------------------*/
+
 void IntermittentUnitBlock::check_data_consistency( void ) const
 {
  // Minimum and maximum power
@@ -182,6 +212,8 @@ void IntermittentUnitBlock::check_data_consistency( void ) const
 
 void IntermittentUnitBlock::generate_abstract_variables( Configuration * stvv )
 {
+ UCBLOCK_TRACE_SPAN( "IntermittentUnitBlock::generate_abstract_variables" );
+
  if( variables_generated() )  // variables have already been generated
   return;                     // nothing to do
 
@@ -225,38 +257,49 @@ void IntermittentUnitBlock::generate_abstract_variables( Configuration * stvv )
 
 void IntermittentUnitBlock::generate_abstract_constraints( Configuration * stcc )
 {
+ UCBLOCK_TRACE_SPAN( "IntermittentUnitBlock::generate_abstract_constraints" );
+
  if( constraints_generated() )  // constraints have already been generated
   return;                       // nothing to do
 
  LinearFunction::v_coeff_pair vars;
 
+ // if no reserve variable enters them, the minimum and maximum power
+ // constraints only involve the active power; without design they then are
+ // the very same bounds as active_power_bounds_Const, and are not generated
+ const bool bounds_only = ( f_InvestmentCost == 0 ) &&
+                          ( ( f_gamma == 0 ) || ( ! ( reserve_vars & 3u ) ) );
+
  // Minimum power constraints
 
- min_power_Const.resize( f_time_horizon );
+ if( ! bounds_only ) {
 
- for( Index t = 0 ; t < f_time_horizon ; ++t ) {
+  min_power_Const.resize( f_time_horizon );
 
-  vars.push_back( std::make_pair( &v_active_power[ t ] , 1.0 ) );
+  for( Index t = 0 ; t < f_time_horizon ; ++t ) {
 
-  if( f_gamma != 0 ) {  // if unit produces any reserve
-   if( reserve_vars & 1u )  // if UCBlock has primary demand variables
-    vars.push_back( std::make_pair( &v_primary_spinning_reserve[ t ] ,
-                                              -1.0 ) );
-   if( reserve_vars & 2u )  // if UCBlock has secondary demand variables
-    vars.push_back( std::make_pair( &v_secondary_spinning_reserve[ t ] ,
-                                              -1.0 ) );
+   vars.push_back( std::make_pair( &v_active_power[ t ] , 1.0 ) );
+
+   if( f_gamma != 0 ) {  // if unit produces any reserve
+    if( reserve_vars & 1u )  // if UCBlock has primary demand variables
+     vars.push_back( std::make_pair( &v_primary_spinning_reserve[ t ] ,
+                                               -1.0 ) );
+    if( reserve_vars & 2u )  // if UCBlock has secondary demand variables
+     vars.push_back( std::make_pair( &v_secondary_spinning_reserve[ t ] ,
+                                               -1.0 ) );
+   }
+
+   min_power_Const[ t ].set_lhs( f_kappa * v_MinPower[ t ] );
+   min_power_Const[ t ].set_rhs( Inf< double >() );
+   min_power_Const[ t ].set_function( new_LinearFunction( vars ) );
   }
 
-  min_power_Const[ t ].set_lhs( f_kappa * v_MinPower[ t ] );
-  min_power_Const[ t ].set_rhs( Inf< double >() );
-  min_power_Const[ t ].set_function( new LinearFunction( std::move( vars ) ) );
+  add_static_constraint( min_power_Const , "MinPower_Intermittent" );
  }
 
- add_static_constraint( min_power_Const , "MinPower_Intermittent" );
-
  // Maximum power constraints
 
- if( f_gamma != 0 ) {  // if unit produces any reserve
+ if( ( f_gamma != 0 ) && ( ! bounds_only ) ) {  // if unit produces reserve
 
   max_power_Const.resize( f_time_horizon );
 
@@ -273,7 +316,7 @@ void IntermittentUnitBlock::generate_abstract_constraints( Configuration * stcc
 
    max_power_Const[ t ].set_lhs( -Inf< double >() );
    max_power_Const[ t ].set_rhs( f_gamma * f_kappa * v_MaxPower[ t ] );
-   max_power_Const[ t ].set_function( new LinearFunction( std::move( vars ) ) );
+   max_power_Const[ t ].set_function( new_LinearFunction( vars ) );
   }
 
   add_static_constraint( max_power_Const , "MaxPower_Intermittent" );
@@ -315,7 +358,7 @@ void IntermittentUnitBlock::generate_abstract_constraints( Configuration * stcc
    active_power_bounds_design_Const[ 0 ][ t ].set_lhs( 0.0 );
    active_power_bounds_design_Const[ 0 ][ t ].set_rhs( Inf< double >() );
    active_power_bounds_design_Const[ 0 ][ t ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
 
    // Upper bound of the active power design constraints:
    //
@@ -328,7 +371,7 @@ void IntermittentUnitBlock::generate_abstract_constraints( Configuration * stcc
    active_power_bounds_design_Const[ 1 ][ t ].set_lhs( -Inf< double >() );
    active_power_bounds_design_Const[ 1 ][ t ].set_rhs( 0.0 );
    active_power_bounds_design_Const[ 1 ][ t ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
   }
 
   add_static_constraint( active_power_bounds_design_Const ,
@@ -343,6 +386,8 @@ void IntermittentUnitBlock::generate_abstract_constraints( Configuration * stcc
 
 void IntermittentUnitBlock::generate_objective( Configuration * objc )
 {
+ UCBLOCK_TRACE_SPAN( "IntermittentUnitBlock::generate_objective" );
+
  if( objective_generated() )  // Objective has already been generated
   return;                     // nothing to do
 
@@ -481,6 +526,15 @@ void IntermittentUnitBlock::serialize( netCDF::NcGroup & group ) const
 
 }  // end( IntermittentUnitBlock::serialize )
 
+/*--------------------------------------------------------------------------*/
+
+MemoryUsage IntermittentUnitBlock::get_memory_usage( void ) const
+{
+ auto usage = UnitBlock::get_memory_usage();
+ usage.add_data( v_MinPower , v_MaxPower , v_InertiaPower );
+ return( usage );
+}  // end( IntermittentUnitBlock::get_memory_usage )
+
 /*--------------------------------------------------------------------------*/
 /*------------------------ METHODS FOR CHANGING DATA -----------------------*/
 /*--------------------------------------------------------------------------*/
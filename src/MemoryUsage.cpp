@@ -0,0 +1,145 @@
+/*--------------------------------------------------------------------------*/
+/*------------------------ File MemoryUsage.cpp ----------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ * Implementation of the MemoryUsage struct.
+ *
+ * \author The UCBlock contributors
+ *
+ * \copyright &copy; by the UCBlock contributors
+ */
+/*--------------------------------------------------------------------------*/
+/*---------------------------- IMPLEMENTATION ------------------------------*/
+/*--------------------------------------------------------------------------*/
+/*------------------------------ INCLUDES ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#include "MemoryUsage.h"
+
+#include "FRealObjective.h"
+
+#include "FRowConstraint.h"
+
+#include "LinearFunction.h"
+
+#include "OneVarConstraint.h"
+
+/*--------------------------------------------------------------------------*/
+/*------------------------- NAMESPACE AND USING ----------------------------*/
+/*--------------------------------------------------------------------------*/
+
+using namespace SMSpp_di_unipi_it;
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------- FUNCTIONS --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+namespace {
+
+/// calls f on each element of a group of static Constraint / Variable
+/** A group, as stored in a boost::any by Block::add_static_constraint()
+ * and Block::add_static_variable(), is a pointer to either a single T, a
+ * std::vector of T, a std::vector of std::vector of T, a std::list of T or
+ * a boost::multi_array of T with up to three dimensions. Returns false if
+ * the group has none of these forms. */
+
+template< class T , class F >
+bool for_each_in( const boost::any & group , F f )
+{
+ if( auto p = boost::any_cast< T * >( & group ) ) {
+  f( **p );
+  return( true );
+  }
+ if( auto p = boost::any_cast< std::vector< T > * >( & group ) ) {
+  for( const auto & e : **p )
+   f( e );
+  return( true );
+  }
+ if( auto p = boost::any_cast< std::vector< std::vector< T > > * >(
+      & group ) ) {
+  for( const auto & v : **p )
+   for( const auto & e : v )
+    f( e );
+  return( true );
+  }
+ if( auto p = boost::any_cast< std::list< T > * >( & group ) ) {
+  for( const auto & e : **p )
+   f( e );
+  return( true );
+  }
+
+ auto each = [ & f ]( const auto * a ) {
+  for( auto e = a->data() ; e != a->data() + a->num_elements() ; ++e )
+   f( *e );
+  };
+ if( auto p = boost::any_cast< boost::multi_array< T , 1 > * >( & group ) ) {
+  each( *p );
+  return( true );
+  }
+ if( auto p = boost::any_cast< boost::multi_array< T , 2 > * >( & group ) ) {
+  each( *p );
+  return( true );
+  }
+ if( auto p = boost::any_cast< boost::multi_array< T , 3 > * >( & group ) ) {
+  each( *p );
+  return( true );
+  }
+ return( false );
+ }
+
+/*--------------------------------------------------------------------------*/
+
+/// the memory of a LinearFunction, 0 if f is not one
+std::size_t linear_function_size( const Function * f )
+{
+ if( ! dynamic_cast< const LinearFunction * >( f ) )
+  return( 0 );
+ return( sizeof( LinearFunction ) + f->get_num_active_var() *
+         ( sizeof( double ) + sizeof( ColVariable * ) ) );
+ }
+
+}  // end( unnamed namespace )
+
+/*--------------------------------------------------------------------------*/
+/*------------------------ METHODS OF MemoryUsage --------------------------*/
+/*--------------------------------------------------------------------------*/
+
+void MemoryUsage::add_abstract( const Block * b )
+{
+ auto row = [ this ]( const FRowConstraint & c ) {
+  constraints += sizeof( FRowConstraint );
+  coefficients += linear_function_size( c.get_function() );
+  };
+ auto bound = [ this ]( const auto & c ) { constraints += sizeof( c ); };
+
+ for( const auto & group : b->get_static_constraints() )
+  if( ! for_each_in< FRowConstraint >( group , row ) )
+   if( ! for_each_in< BoxConstraint >( group , bound ) )
+    if( ! for_each_in< LB0Constraint >( group , bound ) )
+     for_each_in< ZOConstraint >( group , bound );
+
+ auto column = [ this ]( const ColVariable & ) {
+  variables += sizeof( ColVariable );
+  };
+
+ for( const auto & group : b->get_static_variables() )
+  for_each_in< ColVariable >( group , column );
+
+ if( auto obj = dynamic_cast< const FRealObjective * >( b->get_objective() ) )
+  coefficients += linear_function_size( obj->get_function() );
+ }
+
+/*--------------------------------------------------------------------------*/
+
+MemoryUsage MemoryUsage::of_abstract( const Block * b )
+{
+ MemoryUsage usage;
+ usage.add_abstract( b );
+ for( auto sub : b->get_nested_Blocks() )
+  usage += of_abstract( sub );
+ return( usage );
+ }
+
+/*--------------------------------------------------------------------------*/
+/*---------------------- End File MemoryUsage.cpp --------------------------*/
+/*--------------------------------------------------------------------------*/
@@ -42,10 +42,14 @@
 
 #include "RowConstraintSolution.h"
 
+#include "UCBlock.h"
+
 #include "ColRowSolution.h"
 
 #include "ColVariableSolution.h"
 
+#include "UCTrace.h"
+
 /*--------------------------------------------------------------------------*/
 /*------------------------- NAMESPACE AND USING ----------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -58,6 +62,8 @@ using namespace SMSpp_di_unipi_it;
 
 void NetworkBlock::generate_abstract_variables( Configuration * stvv )
 {
+ UCBLOCK_TRACE_SPAN( "NetworkBlock::generate_abstract_variables" );
+
  const auto number_nodes = get_number_nodes();
  const auto number_intervals = get_number_intervals();
 
@@ -71,6 +77,42 @@ void NetworkBlock::generate_abstract_variables( Configuration * stvv )
  }
 }  // end( NetworkBlock::generate_abstract_variables )
 
+/*--------------------------------------------------------------------------*/
+
+NetworkBlock * NetworkBlock::clone( Block * ) const
+{
+ throw( std::logic_error( classname() + "::clone: not implemented" ) );
+}
+
+/*--------------------------------------------------------------------------*/
+
+void NetworkBlock::clone_data( const NetworkBlock & from )
+{
+ if( from.f_BlockConfig )
+  f_BlockConfig = static_cast< BlockConfig * >( from.f_BlockConfig->clone() );
+ f_number_intervals = from.f_number_intervals;
+ f_ConstTerm = from.f_ConstTerm;
+ UCBlock::copy_multi_array( v_MinNodeInjection , from.v_MinNodeInjection );
+ UCBlock::copy_multi_array( v_MaxNodeInjection , from.v_MaxNodeInjection );
+}
+
+/*--------------------------------------------------------------------------*/
+
+MemoryUsage NetworkBlock::get_memory_usage( void ) const
+{
+ MemoryUsage usage;
+ usage.add_abstract( this );
+ usage.add_data( v_MinNodeInjection , v_MaxNodeInjection );
+
+ if( f_local_NetworkData && get_NetworkData() )
+  usage += get_NetworkData()->get_memory_usage();
+
+ for( auto sub : get_nested_Blocks() )
+  usage += MemoryUsage::of_abstract( sub );
+
+ return( usage );
+}
+
 /*--------------------------------------------------------------------------*/
 /*----------------------- Methods for handling Solution --------------------*/
 /*--------------------------------------------------------------------------*/
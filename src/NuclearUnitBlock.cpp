@@ -20,6 +20,8 @@
 
 #include "NuclearUnitBlock.h"
 
+#include "UCTrace.h"
+
 /*--------------------------------------------------------------------------*/
 /*------------------------- NAMESPACE AND USING ----------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -38,6 +40,18 @@ using v_coeff_pair = LinearFunction::v_coeff_pair;
 
 SMSpp_insert_in_factory_cpp_1( NuclearUnitBlock );
 
+/*--------------------------------------------------------------------------*/
+/*-------------------------------- CONSTANTS -------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+// bit of "wf" selecting the compact formulation of the modulation constraints
+static constexpr int ModCmpct = 16;
+
+// minimum modulation interval for which the sliding-sum form is used: with
+// tau^M < 6 the O( T tau^M ) window rows have no more nonzeros than the
+// O( T ) ones of the sliding-sum form (and half the rows)
+static constexpr int ModSumMin = 6;
+
 /*--------------------------------------------------------------------------*/
 /*------------------------------- FUNCTIONS --------------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -80,6 +94,7 @@ static void assign( std::vector< T > & vec , const Block::Subset sbst ,
 
 NuclearUnitBlock::~NuclearUnitBlock()
 {
+ Constraint::clear( ModulationSumConst );
  Constraint::clear( ModulationConst );
  Constraint::clear( NoStartUpModulation );
  Constraint::clear( NoDownModulation );
@@ -93,17 +108,21 @@ NuclearUnitBlock::~NuclearUnitBlock()
 
 void NuclearUnitBlock::deserialize( const netCDF::NcGroup & group )
 {
+ UCBLOCK_TRACE_SPAN( "NuclearUnitBlock::deserialize" );
+
 #ifndef NDEBUG
- // check all expected variables, comprised those of the base class: see
- // ThermalUnitBlock::deserialize() for the rationale
- const std::vector< std::string > expected_vars = { "MinPower" , "MaxPower" ,
-  "DeltaRampUp" , "DeltaRampDown" , "PrimaryRho" , "SecondaryRho" ,
-  "LinearTerm" , "QuadTerm" , "ConstTerm" , "StartUpCost" ,
-  "FixedConsumption" , "InertiaCommitment" , "InitialPower" , "MinUpTime" ,
-  "MinDownTime" , "InitUpDownTime" , "Availability" , "ModulationTime" ,
-  "InitModulation" , "ModulationDeltaRampUp" , "ModulationDeltaRampDown" };
-
- check_variables( group , expected_vars , std::cerr );
+ if( ! validated_data() ) {
+  // check all expected variables, comprised those of the base class: see
+  // ThermalUnitBlock::deserialize() for the rationale
+  const std::vector< std::string > expected_vars = { "MinPower" , "MaxPower" ,
+   "DeltaRampUp" , "DeltaRampDown" , "PrimaryRho" , "SecondaryRho" ,
+   "LinearTerm" , "QuadTerm" , "ConstTerm" , "StartUpCost" ,
+   "FixedConsumption" , "InertiaCommitment" , "InitialPower" , "MinUpTime" ,
+   "MinDownTime" , "InitUpDownTime" , "Availability" , "ModulationTime" ,
+   "InitModulation" , "ModulationDeltaRampUp" , "ModulationDeltaRampDown" };
+
+  check_variables( group , expected_vars , std::cerr );
+ }
 #endif
 
  // call the method of the base class 
@@ -124,6 +143,9 @@ void NuclearUnitBlock::deserialize( const netCDF::NcGroup & group )
  if( ! ::deserialize( group , f_modulation_interval , "ModulationTime" ) )
   f_modulation_interval = 2;
 
+ // the formulation is only decided by generate_abstract_variables()
+ f_compact_modulation = false;
+
  if( f_modulation_interval < 2 )
   throw( std::invalid_argument(
 		    "NuclearUnitBlock::deserialize: ModulationTime < 2" ) );
@@ -154,6 +176,22 @@ void NuclearUnitBlock::deserialize( const netCDF::NcGroup & group )
 
 /*--------------------------------------------------------------------------*/
 
+UnitBlock * NuclearUnitBlock::clone( Block * father ) const
+{
+ auto unit = std::make_unique< NuclearUnitBlock >( father );
+ unit->clone_data( *this );
+
+ unit->v_modulation_ramp_up = v_modulation_ramp_up;
+ unit->v_modulation_ramp_down = v_modulation_ramp_down;
+ unit->f_initial_modulation = f_initial_modulation;
+ unit->f_modulation_interval = f_modulation_interval;
+ unit->f_compact_modulation = f_compact_modulation;
+
+ return( unit.release() );
+}
+
+/*--------------------------------------------------------------------------*/
+
 void NuclearUnitBlock::check_modulation_consistency( void ) const
 {
  static const std::string fn =
@@ -195,6 +233,7 @@ void NuclearUnitBlock::check_modulation_consistency( void ) const
 /*--------------------------------------------------------------------------*/
 
 void NuclearUnitBlock::generate_abstract_variables( Configuration * stvv ) {
+ UCBLOCK_TRACE_SPAN( "NuclearUnitBlock::generate_abstract_variables" );
 
  if( variables_generated() )
   return; // variables have already been generated
@@ -207,6 +246,15 @@ void NuclearUnitBlock::generate_abstract_variables( Configuration * stvv ) {
  // - v_shut_down[ f_time_horizon - init_t ]
  ThermalUnitBlock::generate_abstract_variables( stvv );
 
+ // the base class has already read wf, but it only looks at wf & 15; the
+ // formulation is decided anew each time, as the Configuration may have
+ // been changed or removed since the last time
+ f_compact_modulation = false;
+ if( ( ! stvv ) && f_BlockConfig )
+  stvv = f_BlockConfig->f_static_variables_Configuration;
+ if( auto sci = dynamic_cast< SimpleConfiguration< int > * >( stvv ) )
+  f_compact_modulation = sci->f_value & ModCmpct;
+
  // Modulation Variable- - - - - - - - - - - - - - - - - - - - - - - - - - -
  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
  // resize v_modulation to f_time_horizon, thereby creating the ColVariable
@@ -237,12 +285,27 @@ void NuclearUnitBlock::generate_abstract_variables( Configuration * stvv ) {
    v_modulation[ t ].set_value( 0.0 );
    v_modulation[ t++ ].is_fixed( true , eNoMod );
    }
+
+ // Cumulative Modulation Variable - - - - - - - - - - - - - - - - - - - - -
+ // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ // s_t = sum_{h = 0}^t m_h, only in the compact formulation and if the
+ // modulation interval is long enough for the sliding-sum form to pay off
+
+ if( f_compact_modulation && ( f_modulation_interval >= ModSumMin ) ) {
+  v_modulation_sum.resize( f_time_horizon );
+
+  for( auto & var : v_modulation_sum )
+   var.set_type( ColVariable::kNonNegative );
+
+  add_static_variable( v_modulation_sum , "s_modulation_sum" );
+  }
  
  } // end( NuclearUnitBlock::generate_abstract_variables )
 
 /*--------------------------------------------------------------------------*/
 
 void NuclearUnitBlock::generate_abstract_constraints( Configuration * stcc ) {
+ UCBLOCK_TRACE_SPAN( "NuclearUnitBlock::generate_abstract_constraints" );
 
  if( constraints_generated() )
   return; // constraints have already been generated
@@ -362,14 +425,20 @@ void NuclearUnitBlock::generate_abstract_constraints( Configuration * stcc ) {
  // note: these only have to be constructed for t >= init_t, as for
  // t < init_t either u_t is fixed to 1, and the constraint is redundant, or
  // u_t is fixed to 0 and m_t has been fixed in generate_abstract_variables()
+ // in the compact formulation the constraint becomes m_t + v_t - u_t \leq 0,
+ // which has the same integer solutions (v_t = 1 ==> u_t = 1) but dominates
+ // both m_t \leq u_t and m_t + v_t \leq 1 in the continuous relaxation, so
+ // that the NoStartUpModulation ones need not be constructed
  
  NoDownModulation.resize( f_time_horizon - init_t );
 
  for( Index t = init_t ; t < f_time_horizon ; ++t ) {
-  LinearFunction::v_coeff_pair cf( 2 );
+  LinearFunction::v_coeff_pair cf( f_compact_modulation ? 3 : 2 );
 
   cf[ 0 ] = coeff_pair( & v_modulation[ t ] , 1.0 );
   cf[ 1 ] = coeff_pair( & v_commitment[ t ] , -1.0 );
+  if( f_compact_modulation )
+   cf[ 2 ] = coeff_pair( & v_start_up[ t - init_t ] , 1.0 );
  
   NoDownModulation[ t - init_t ].set_lhs( - Inf< double >() );
   NoDownModulation[ t - init_t ].set_rhs( 0 );
@@ -379,34 +448,36 @@ void NuclearUnitBlock::generate_abstract_constraints( Configuration * stcc ) {
 
  add_static_constraint( NoDownModulation , "NoDownModulation_Nuclear" );
 
- // construct the logical constraints m_t + v_t \leq 1  - - - - - - - - - - -
- // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
- // the unit is not modulating while starting up
- // note: these only have to be constructed for t >= init_t, as for
- // t < init_t u_t is fixed (no matter if to 0 or 1) and therefore no
- // start-up can ever occur; in facy, the start-up variables are not even
- // defined for t < init_t. it may also be that the m_t are fixed for those
- // t: this happens if u_t is fixed to 0, but not if u_t is fixed to 1, in
- // which case modulations can occur within the first init_t periods unless
- // forbidden by the initial state (f_initial_modulation), but the latter
- // case is already taken care of in generate_abstract_variables()
-
- NoStartUpModulation.resize( f_time_horizon - init_t );
-
- for( Index t = init_t ; t < f_time_horizon ; ++t ) {
-  LinearFunction::v_coeff_pair cf( 2 );
-
-  cf[ 0 ] = coeff_pair( & v_modulation[ t ] , 1.0 );
-  cf[ 1 ] = coeff_pair( & v_start_up[ t - init_t ] , -1.0 );
+ if( ! f_compact_modulation ) {
+  // construct the logical constraints m_t + v_t \leq 1 - - - - - - - - - -
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // the unit is not modulating while starting up
+  // note: these only have to be constructed for t >= init_t, as for
+  // t < init_t u_t is fixed (no matter if to 0 or 1) and therefore no
+  // start-up can ever occur; in facy, the start-up variables are not even
+  // defined for t < init_t. it may also be that the m_t are fixed for those
+  // t: this happens if u_t is fixed to 0, but not if u_t is fixed to 1, in
+  // which case modulations can occur within the first init_t periods unless
+  // forbidden by the initial state (f_initial_modulation), but the latter
+  // case is already taken care of in generate_abstract_variables()
+
+  NoStartUpModulation.resize( f_time_horizon - init_t );
+
+  for( Index t = init_t ; t < f_time_horizon ; ++t ) {
+   LinearFunction::v_coeff_pair cf( 2 );
+
+   cf[ 0 ] = coeff_pair( & v_modulation[ t ] , 1.0 );
+   cf[ 1 ] = coeff_pair( & v_start_up[ t - init_t ] , -1.0 );
  
-  NoStartUpModulation[ t - init_t ].set_lhs( - Inf< double >() );
-  NoStartUpModulation[ t - init_t ].set_rhs( 1.0 );
-  NoStartUpModulation[ t - init_t ].set_function(
+   NoStartUpModulation[ t - init_t ].set_lhs( - Inf< double >() );
+   NoStartUpModulation[ t - init_t ].set_rhs( 1.0 );
+   NoStartUpModulation[ t - init_t ].set_function(
 				    new LinearFunction( std::move( cf ) ) );
-  }
+   }
 
- add_static_constraint( NoStartUpModulation ,
+  add_static_constraint( NoStartUpModulation ,
 			"NoStartUpModulation_Nuclear" );
+  }
 
  // construct the modulation constraint proper- - - - - - - - - - - - - - - -
  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -429,18 +500,55 @@ void NuclearUnitBlock::generate_abstract_constraints( Configuration * stcc ) {
 
  ModulationConst.resize( f_time_horizon - first_c );
 
- for( Index t = first_c ; t < f_time_horizon ; ++t ) {
-  Index h = std::max( int( 0 ) , int( t ) - f_modulation_interval + 1 );
-  LinearFunction::v_coeff_pair cf( t - h + 1 );
+ if( ! v_modulation_sum.empty() ) {
+  // sliding-sum form: s_t - s_{t-1} - m_t = 0 for all t (s_{-1} = 0), and
+  // then s_t - s_{t - \tau^M} \leq 1, where the second term is absent if
+  // t < \tau^M; this has O( T ) nonzeros rather than O( T \tau^M )
+  ModulationSumConst.resize( f_time_horizon );
+
+  for( Index t = 0 ; t < f_time_horizon ; ++t ) {
+   LinearFunction::v_coeff_pair cf( t ? 3 : 2 );
+
+   cf[ 0 ] = coeff_pair( & v_modulation_sum[ t ] , 1.0 );
+   cf[ 1 ] = coeff_pair( & v_modulation[ t ] , -1.0 );
+   if( t )
+    cf[ 2 ] = coeff_pair( & v_modulation_sum[ t - 1 ] , -1.0 );
+
+   ModulationSumConst[ t ].set_both( 0 );
+   ModulationSumConst[ t ].set_function(
+				    new LinearFunction( std::move( cf ) ) );
+   }
+
+  add_static_constraint( ModulationSumConst ,
+			 "ModulationSumConst_Nuclear" );
+
+  for( Index t = first_c ; t < f_time_horizon ; ++t ) {
+   Index tau = f_modulation_interval;
+   LinearFunction::v_coeff_pair cf( t >= tau ? 2 : 1 );
 
-  for( auto cfit = cf.begin() ; h <= t ; )
-   *(cfit++) = coeff_pair( & v_modulation[ h++ ] , 1.0 );
+   cf[ 0 ] = coeff_pair( & v_modulation_sum[ t ] , 1.0 );
+   if( t >= tau )
+    cf[ 1 ] = coeff_pair( & v_modulation_sum[ t - tau ] , -1.0 );
 
-  ModulationConst[ t - first_c ].set_lhs( - Inf< double >() );
-  ModulationConst[ t - first_c ].set_rhs( 1.0 );
-  ModulationConst[ t - first_c ].set_function(
+   ModulationConst[ t - first_c ].set_lhs( - Inf< double >() );
+   ModulationConst[ t - first_c ].set_rhs( 1.0 );
+   ModulationConst[ t - first_c ].set_function(
 				    new LinearFunction( std::move( cf ) ) );
+   }
   }
+ else
+  for( Index t = first_c ; t < f_time_horizon ; ++t ) {
+   Index h = std::max( int( 0 ) , int( t ) - f_modulation_interval + 1 );
+   LinearFunction::v_coeff_pair cf( t - h + 1 );
+
+   for( auto cfit = cf.begin() ; h <= t ; )
+    *(cfit++) = coeff_pair( & v_modulation[ h++ ] , 1.0 );
+
+   ModulationConst[ t - first_c ].set_lhs( - Inf< double >() );
+   ModulationConst[ t - first_c ].set_rhs( 1.0 );
+   ModulationConst[ t - first_c ].set_function(
+				    new LinearFunction( std::move( cf ) ) );
+   }
 
  add_static_constraint( ModulationConst , "ModulationConst_Nuclear" );
 
@@ -479,6 +587,7 @@ bool NuclearUnitBlock::is_feasible( bool useabstract , Configuration * fsbc )
  return( ThermalUnitBlock::is_feasible( useabstract )
 	 // Variable
 	 && ColVariable::is_feasible( v_modulation , tol )
+	 && ColVariable::is_feasible( v_modulation_sum , tol )
 	 // Constraints
 	 && RowConstraint::is_feasible( Modulation_RampUp_Constraints ,
 					tol , rel_viol )
@@ -487,6 +596,7 @@ bool NuclearUnitBlock::is_feasible( bool useabstract , Configuration * fsbc )
 	 && RowConstraint::is_feasible( NoDownModulation , tol , rel_viol )
 	 && RowConstraint::is_feasible( NoStartUpModulation , tol , rel_viol )
 	 && RowConstraint::is_feasible( ModulationConst , tol , rel_viol )
+	 && RowConstraint::is_feasible( ModulationSumConst , tol , rel_viol )
 	 );
 
  }  // end( NuclearUnitBlock::is_feasible )
@@ -542,6 +652,15 @@ void NuclearUnitBlock::serialize( netCDF::NcGroup & group ) const
 
  }  // end( NuclearUnitBlock::serialize )
 
+/*--------------------------------------------------------------------------*/
+
+MemoryUsage NuclearUnitBlock::get_memory_usage( void ) const
+{
+ auto usage = ThermalUnitBlock::get_memory_usage();
+ usage.add_data( v_modulation_ramp_up , v_modulation_ramp_down );
+ return( usage );
+ }  // end( NuclearUnitBlock::get_memory_usage )
+
 /*--------------------------------------------------------------------------*/
 /*------------------------ METHODS FOR CHANGING DATA -----------------------*/
 /*----------------------------------------------------------------------------
@@ -613,7 +732,7 @@ void NuclearUnitBlock::set_modulation_ramp_up( MF_dbl_it values ,
   // since several "abstract Modification" will be issued, pack them all into
   // a single GroupModification
   auto nAM = un_ModBlock( make_par( par2mod( issueAMod ) ,
-				    open_channel( par2chnl( issueAMod ) ) ) );
+				    open_packing_channel( issueAMod ) ) );
 
   // TODO: make it more efficient by treating the t == 0 case offline
   for( auto t : subset ) {
@@ -631,7 +750,8 @@ void NuclearUnitBlock::set_modulation_ramp_up( MF_dbl_it values ,
 	       f_InitialPower + ( f_InitUpDownTime > 0 ? mrut : 0 ) , nAM );
    }
 
-  close_channel( par2chnl( nAM ) );  // at the end close the channel
+  // at the end close the channel
+  close_packing_channel( par2chnl( nAM ) , issueAMod );
   }
 
  if( issue_pmod( issuePMod ) )  // issue a physical Modification
@@ -695,7 +815,7 @@ void NuclearUnitBlock::set_modulation_ramp_up( MF_dbl_it values , Range rng ,
   // since several "abstract Modification" will be issued, pack them all into
   // a single GroupModification
   auto nAM = un_ModBlock( make_par( par2mod( issueAMod ) ,
-				    open_channel( par2chnl( issueAMod ) ) ) );
+				    open_packing_channel( issueAMod ) ) );
 
   // TODO: make it more efficient by treating the t == 0 case offline
   for( auto t = rng.first ; t < rng.second ; ++t ) {
@@ -713,7 +833,8 @@ void NuclearUnitBlock::set_modulation_ramp_up( MF_dbl_it values , Range rng ,
 	       f_InitialPower + ( f_InitUpDownTime > 0 ? mrut : 0 ) , nAM );
    }
 
-  close_channel( par2chnl( nAM ) );  // at the end close the channel
+  // at the end close the channel
+  close_packing_channel( par2chnl( nAM ) , issueAMod );
   }
 
  if( issue_pmod( issuePMod ) )
@@ -776,7 +897,7 @@ void NuclearUnitBlock::set_modulation_ramp_down( MF_dbl_it values ,
   // since several "abstract Modification" will be issued, pack them all into
   // a single GroupModification
   auto nAM = un_ModBlock( make_par( par2mod( issueAMod ) ,
-				    open_channel( par2chnl( issueAMod ) ) ) );
+				    open_packing_channel( issueAMod ) ) );
   for( auto t : subset ) {
    auto mrdt = *(values++);
    auto lf = LF( Modulation_RampDown_Constraints[ t ].get_function() );
@@ -788,7 +909,8 @@ void NuclearUnitBlock::set_modulation_ramp_down( MF_dbl_it values ,
    lf->modify_coefficient( 2 , - ( v_DeltaRampDown[ t ] - mrdt ) , nAM );
    }
 
-  close_channel( par2chnl( nAM ) );  // at the end close the channel
+  // at the end close the channel
+  close_packing_channel( par2chnl( nAM ) , issueAMod );
   }
 
  if( issue_pmod( issuePMod ) )  // issue a physical Modification
@@ -849,7 +971,7 @@ void NuclearUnitBlock::set_modulation_ramp_down( MF_dbl_it values ,
   // since several "abstract Modification" will be issued, pack them all into
   // a single GroupModification
   auto nAM = un_ModBlock( make_par( par2mod( issueAMod ) ,
-				    open_channel( par2chnl( issueAMod ) ) ) );
+				    open_packing_channel( issueAMod ) ) );
 
   for( auto t = rng.first ; t < rng.second ; ++t ) {
    auto mrdt = *(values++);
@@ -862,7 +984,8 @@ void NuclearUnitBlock::set_modulation_ramp_down( MF_dbl_it values ,
    lf->modify_coefficient( 2 , - ( v_DeltaRampDown[ t ] - mrdt ) , nAM );
    }
 
-  close_channel( par2chnl( nAM ) );  // at the end close the channel
+  // at the end close the channel
+  close_packing_channel( par2chnl( nAM ) , issueAMod );
   }
 
  if( issue_pmod( issuePMod ) )
@@ -36,6 +36,8 @@
 
 #include "FRealObjective.h"
 
+#include "UCTrace.h"
+
 /*--------------------------------------------------------------------------*/
 /*------------------------- NAMESPACE AND USING ----------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -71,21 +73,24 @@ SlackUnitBlock::~SlackUnitBlock()
 
 void SlackUnitBlock::deserialize( const netCDF::NcGroup & group )
 {
+ UCBLOCK_TRACE_SPAN( "SlackUnitBlock::deserialize" );
 
 #ifndef NDEBUG
- static std::vector< std::string > expected_dims = { "TimeHorizon" ,
-                                                     "NumberIntervals" };
- check_dimensions( group , expected_dims , std::cerr );
-
- static std::vector< std::string > expected_vars = { "MaxPower" ,
-                                                     "MaxPrimaryPower" ,
-                                                     "MaxSecondaryPower" ,
-                                                     "ActivePowerCost" ,
-                                                     "PrimaryCost" ,
-                                                     "SecondaryCost" ,
-                                                     "InertiaCost" ,
-                                                     "MaxInertia" };
- check_variables( group , expected_vars , std::cerr );
+ if( ! validated_data() ) {
+  static std::vector< std::string > expected_dims = { "TimeHorizon" ,
+                                                      "NumberIntervals" };
+  check_dimensions( group , expected_dims , std::cerr );
+
+  static std::vector< std::string > expected_vars = { "MaxPower" ,
+                                                      "MaxPrimaryPower" ,
+                                                      "MaxSecondaryPower" ,
+                                                      "ActivePowerCost" ,
+                                                      "PrimaryCost" ,
+                                                      "SecondaryCost" ,
+                                                      "InertiaCost" ,
+                                                      "MaxInertia" };
+  check_variables( group , expected_vars , std::cerr );
+ }
 #endif
 
  // Optional variables
@@ -115,8 +120,29 @@ void SlackUnitBlock::deserialize( const netCDF::NcGroup & group )
 
 /*--------------------------------------------------------------------------*/
 
+UnitBlock * SlackUnitBlock::clone( Block * father ) const
+{
+ auto unit = std::make_unique< SlackUnitBlock >( father );
+ unit->clone_data( *this );
+
+ unit->v_MaxPower = v_MaxPower;
+ unit->v_ActivePowerCost = v_ActivePowerCost;
+ unit->v_MaxPrimaryPower = v_MaxPrimaryPower;
+ unit->v_PrimaryCost = v_PrimaryCost;
+ unit->v_MaxSecondaryPower = v_MaxSecondaryPower;
+ unit->v_SecondaryCost = v_SecondaryCost;
+ unit->v_MaxInertia = v_MaxInertia;
+ unit->v_InertiaCost = v_InertiaCost;
+
+ return( unit.release() );
+}
+
+/*--------------------------------------------------------------------------*/
+
 void SlackUnitBlock::generate_abstract_variables( Configuration * stvv )
 {
+ UCBLOCK_TRACE_SPAN( "SlackUnitBlock::generate_abstract_variables" );
+
  if( variables_generated() )  // variables have already been generated
   return;                     // nothing to do
 
@@ -164,6 +190,8 @@ void SlackUnitBlock::generate_abstract_variables( Configuration * stvv )
 
 void SlackUnitBlock::generate_abstract_constraints( Configuration * stcc )
 {
+ UCBLOCK_TRACE_SPAN( "SlackUnitBlock::generate_abstract_constraints" );
+
  if( constraints_generated() )  // constraints have already been generated
   return;                       // nothing to do
 
@@ -267,6 +295,8 @@ void SlackUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
 void SlackUnitBlock::generate_objective( Configuration * objc )
 {
+ UCBLOCK_TRACE_SPAN( "SlackUnitBlock::generate_objective" );
+
  if( objective_generated() )  // Objective has already been generated
   return;                     // nothing to do
 
@@ -438,6 +468,17 @@ void SlackUnitBlock::serialize( netCDF::NcGroup & group ) const
 
 }  // end( SlackUnitBlock::serialize )
 
+/*--------------------------------------------------------------------------*/
+
+MemoryUsage SlackUnitBlock::get_memory_usage( void ) const
+{
+ auto usage = UnitBlock::get_memory_usage();
+ usage.add_data( v_MaxPower , v_ActivePowerCost , v_MaxPrimaryPower ,
+                 v_PrimaryCost , v_MaxSecondaryPower , v_SecondaryCost ,
+                 v_MaxInertia , v_InertiaCost );
+ return( usage );
+}  // end( SlackUnitBlock::get_memory_usage )
+
 /*--------------------------------------------------------------------------*/
 /*----------------------- End File SlackUnitBlock.cpp ----------------------*/
 /*--------------------------------------------------------------------------*/
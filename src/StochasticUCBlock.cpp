@@ -0,0 +1,621 @@
+/*--------------------------------------------------------------------------*/
+/*---------------------- File StochasticUCBlock.cpp ------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ * Implementation of the StochasticUCBlock class, which implements the Block
+ * concept [see Block.h] for a two-stage stochastic Unit Commitment problem
+ * whose scenarios only differ in the active power demand and in the maximum
+ * power of the intermittent units.
+ *
+ * \author The UCBlock contributors
+ *
+ * \copyright &copy; by the UCBlock contributors
+ */
+/*--------------------------------------------------------------------------*/
+/*---------------------------- IMPLEMENTATION ------------------------------*/
+/*--------------------------------------------------------------------------*/
+/*------------------------------ INCLUDES ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#include "StochasticUCBlock.h"
+
+#include "IntermittentUnitBlock.h"
+
+#include "LinearFunction.h"
+
+#include "Solver.h"
+
+#include "ThermalUnitBlock.h"
+
+#include "UCTrace.h"
+
+#include <atomic>
+
+#include <cmath>
+
+#include <mutex>
+
+#include <thread>
+
+#include <typeinfo>
+
+/*--------------------------------------------------------------------------*/
+/*------------------------- NAMESPACE AND USING ----------------------------*/
+/*--------------------------------------------------------------------------*/
+
+using namespace SMSpp_di_unipi_it;
+
+/*--------------------------------------------------------------------------*/
+/*----------------------------- STATIC MEMBERS -----------------------------*/
+/*--------------------------------------------------------------------------*/
+
+// register StochasticUCBlock to the Block factory
+
+SMSpp_insert_in_factory_cpp_1( StochasticUCBlock );
+
+/*--------------------------------------------------------------------------*/
+/*--------------------- METHODS OF StochasticUCBlock -----------------------*/
+/*--------------------------------------------------------------------------*/
+
+StochasticUCBlock::~StochasticUCBlock()
+{
+ Constraint::clear( v_NonAnticipativity_Const );
+
+ for( auto & block : v_Block )
+  delete( block );
+}
+
+/*--------------------------------------------------------------------------*/
+/*-------------------------- OTHER INITIALIZATIONS -------------------------*/
+/*--------------------------------------------------------------------------*/
+
+void StochasticUCBlock::deserialize( const netCDF::NcGroup & group )
+{
+ UCBLOCK_TRACE_SPAN( "StochasticUCBlock::deserialize" );
+
+ Block::deserialize( group );
+
+ // read a scenario-dependent variable, whose first dimension must be
+ // NumberScenarios and with size values for each scenario
+ auto read = [ this ]( const netCDF::NcVar & var , Index size ) {
+  if( ( var.getDimCount() < 1 ) ||
+      ( var.getDim( 0 ).getName() != "NumberScenarios" ) )
+   throw( std::invalid_argument( "StochasticUCBlock::deserialize: first "
+                                 "dimension of " + var.getName() +
+                                 " is not NumberScenarios" ) );
+  std::size_t n = 1;
+  for( const auto & d : var.getDims() )
+   n *= d.getSize();
+  if( n != std::size_t( f_number_scenarios ) * size )
+   throw( std::invalid_argument( "StochasticUCBlock::deserialize: "
+                                 + var.getName() + " must have " +
+                                 std::to_string( size ) +
+                                 " values per scenario" ) );
+  std::vector< double > data( n );
+  var.getVar( data.data() );
+  return( data );
+ };
+
+ auto int_att = [ & group ]( const std::string & name , int value ) {
+  if( auto att = group.getAtt( name ) ; ! att.isNull() )
+   att.getValues( & value );
+  return( value );
+ };
+
+ ::deserialize_dim( group , "NumberScenarios" , f_number_scenarios );
+ if( ! f_number_scenarios )
+  throw( std::invalid_argument( "StochasticUCBlock::deserialize: "
+                                "NumberScenarios must be positive" ) );
+
+ const int number_copies = int_att( "NumberCopies" , 1 );
+ if( ( number_copies < 1 ) || ( Index( number_copies ) > f_number_scenarios ) )
+  throw( std::invalid_argument( "StochasticUCBlock::deserialize: "
+                                "NumberCopies must be between 1 and "
+                                "NumberScenarios" ) );
+ f_non_anticipative = ( int_att( "NonAnticipative" , 1 ) != 0 );
+
+ v_probability.assign( f_number_scenarios , 1.0 / f_number_scenarios );
+ if( auto var = group.getVar( "Probability" ) ; ! var.isNull() )
+  v_probability = read( var , 1 );
+
+ // the copies of the base UCBlock
+ auto base = group.getGroup( "UCBlock" );
+ if( base.isNull() )
+  throw( std::invalid_argument( "StochasticUCBlock::deserialize: UCBlock "
+                                "not present" ) );
+
+ for( auto & block : v_Block )
+  delete( block );
+ v_Block.assign( number_copies , nullptr );
+ auto b = new_Block( base , this );
+ if( ! dynamic_cast< UCBlock * >( b ) ) {
+  delete( b );
+  throw( std::invalid_argument( "StochasticUCBlock::deserialize: UCBlock "
+                                "is not an UCBlock" ) );
+ }
+ v_Block.front() = b;
+
+ // the other copies are cloned out of the first one, which is much faster
+ // than reading them again, unless the base is of a class derived from
+ // UCBlock, which UCBlock::clone() does not know about
+ const bool plain = ( typeid( *b ) == typeid( UCBlock ) );
+ for( Index k = 1 ; k < Index( number_copies ) ; ++k )
+  v_Block[ k ] = plain ? get_copy( 0 )->clone( this )
+                       : new_Block( base , this );
+
+ // the scenario-dependent data
+ const auto uc = get_copy( 0 );
+ const auto T = uc->get_time_horizon();
+
+ v_active_power_demand.clear();
+ if( auto var = group.getVar( "ActivePowerDemand" ) ; ! var.isNull() )
+  v_active_power_demand = read( var , uc->get_number_nodes() * T );
+
+ v_max_power.clear();
+ const std::string prefix = "UnitBlock_";
+ for( const auto & [ group_name , unit_group ] : group.getGroups() ) {
+  if( group_name.compare( 0 , prefix.size() , prefix ) != 0 )
+   continue;
+  const auto u = std::strtoul( group_name.c_str() + prefix.size() ,
+                               nullptr , 10 );
+  if( ( u >= uc->get_number_units() ) ||
+      ( ! dynamic_cast< IntermittentUnitBlock * >(
+           uc->get_unit_block( u ) ) ) )
+   throw( std::invalid_argument( "StochasticUCBlock::deserialize: " +
+                                 group_name + " is not an "
+                                 "IntermittentUnitBlock" ) );
+  auto var = unit_group.getVar( "MaxPower" );
+  if( var.isNull() )
+   throw( std::invalid_argument( "StochasticUCBlock::deserialize: no "
+                                 "MaxPower in " + group_name ) );
+  v_max_power.emplace_back( u , read( var , T ) );
+ }
+
+ // load scenario k into copy k
+ v_scenario.assign( number_copies , Inf< Index >() );
+ for( Index k = 0 ; k < v_scenario.size() ; ++k )
+  set_scenario( k , k , eNoMod , eNoMod );
+
+}  // end( StochasticUCBlock::deserialize )
+
+/*--------------------------------------------------------------------------*/
+
+void StochasticUCBlock::generate_abstract_constraints( Configuration * stcc )
+{
+ UCBLOCK_TRACE_SPAN( "StochasticUCBlock::generate_abstract_constraints" );
+
+ if( constraints_generated() )  // constraints have already been generated
+  return;                       // nothing to do
+
+ // generate abstract constraints in all the copies
+
+ Block::generate_abstract_constraints( stcc );
+
+ // generate the non-anticipativity constraints, which only make sense if
+ // copy s is scenario s
+
+ if( f_non_anticipative && ( v_Block.size() == f_number_scenarios ) &&
+     ( f_number_scenarios > 1 ) ) {
+  const auto units = thermal_units();
+  const auto T = get_copy( 0 )->get_time_horizon();
+
+  v_NonAnticipativity_Const.resize( boost::extents[ f_number_scenarios - 1 ]
+                                    [ units.size() ][ T ] );
+
+  for( Index s = 1 ; s < f_number_scenarios ; ++s )
+   for( Index j = 0 ; j < units.size() ; ++j ) {
+    auto u0 = get_copy( 0 )->get_unit_block( units[ j ] )->get_commitment( 0 );
+    auto us = get_copy( s )->get_unit_block( units[ j ] )->get_commitment( 0 );
+    if( ( ! u0 ) || ( ! us ) )
+     throw( std::logic_error( "StochasticUCBlock::generate_abstract_"
+                              "constraints: commitment variables of unit "
+                              + std::to_string( units[ j ] ) +
+                              " not generated" ) );
+    for( Index t = 0 ; t < T ; ++t ) {
+     LinearFunction::v_coeff_pair vars = { { & us[ t ] , 1.0 } ,
+                                           { & u0[ t ] , -1.0 } };
+     auto & row = v_NonAnticipativity_Const[ s - 1 ][ j ][ t ];
+     row.set_both( 0 , eNoMod );
+     row.set_function( new LinearFunction( std::move( vars ) ) , eNoMod );
+    }
+   }
+
+  add_static_constraint( v_NonAnticipativity_Const ,
+                         "non_anticipativity_c" );
+ }
+
+ set_constraints_generated();
+
+}  // end( StochasticUCBlock::generate_abstract_constraints )
+
+/*--------------------------------------------------------------------------*/
+/*------------------- METHODS FOR HANDLING THE SCENARIOS -------------------*/
+/*--------------------------------------------------------------------------*/
+
+void StochasticUCBlock::set_scenario( Index copy , Index scenario ,
+                                      ModParam issuePMod ,
+                                      ModParam issueAMod )
+{
+ if( copy >= v_Block.size() )
+  throw( std::invalid_argument( "StochasticUCBlock::set_scenario: invalid "
+                                "copy " + std::to_string( copy ) ) );
+ if( scenario >= f_number_scenarios )
+  throw( std::invalid_argument( "StochasticUCBlock::set_scenario: invalid "
+                                "scenario " + std::to_string( scenario ) ) );
+ if( v_scenario[ copy ] == scenario )
+  return;
+ if( v_NonAnticipativity_Const.num_elements() )
+  throw( std::logic_error( "StochasticUCBlock::set_scenario: copy " +
+                           std::to_string( copy ) + " is bound to its "
+                           "scenario by the non-anticipativity "
+                           "constraints" ) );
+
+ const auto uc = get_copy( copy );
+ const auto T = uc->get_time_horizon();
+
+ if( ! v_active_power_demand.empty() ) {
+  const Index size = uc->get_number_nodes() * T;
+  uc->set_active_power_demand( v_active_power_demand.cbegin() +
+                               scenario * size , Range( 0 , size ) ,
+                               issuePMod , issueAMod );
+ }
+
+ for( const auto & [ u , max_power ] : v_max_power )
+  static_cast< IntermittentUnitBlock * >( uc->get_unit_block( u ) )
+   ->set_maximum_power( max_power.cbegin() + scenario * T , Range( 0 , T ) ,
+                        issuePMod , issueAMod );
+
+ v_scenario[ copy ] = scenario;
+
+}  // end( StochasticUCBlock::set_scenario )
+
+/*--------------------------------------------------------------------------*/
+
+StochasticUCBlock::PHResult StochasticUCBlock::progressive_hedging(
+ double rho , Index max_iterations , double tolerance ,
+ unsigned int threads )
+{
+ const auto S = f_number_scenarios;
+ const Index K = v_Block.size();
+ const auto units = thermal_units();
+ const Index J = units.size();
+ const auto T = get_copy( 0 )->get_time_horizon();
+
+ auto thermal = [ this , & units ]( Index k , Index j ) {
+  return( static_cast< ThermalUnitBlock * >(
+           get_copy( k )->get_unit_block( units[ j ] ) ) );
+ };
+
+ for( Index k = 0 ; k < K ; ++k )
+  if( get_copy( k )->get_registered_solvers().empty() )
+   throw( std::logic_error( "StochasticUCBlock::progressive_hedging: no "
+                            "Solver registered to copy " +
+                            std::to_string( k ) ) );
+
+ // the original constant terms, the same in all the copies
+ std::vector< std::vector< double > > const_term( J );
+ for( Index j = 0 ; j < J ; ++j ) {
+  const_term[ j ] = thermal( 0 , j )->get_const_term();
+  const_term[ j ].resize( T , const_term[ j ].size() == 1 ?
+                              const_term[ j ].front() : 0 );
+ }
+
+ // the commitments u^s_t, the multipliers w^s_t, both [ S ][ J ][ T ], the
+ // average commitments ubar_t, [ J ][ T ], and the cost of each scenario
+ std::vector< double > u( S * J * T , 0 );
+ std::vector< double > w( S * J * T , 0 );
+ std::vector< double > average( J * T , 0 );
+ std::vector< double > cost( S , 0 );
+ bool penalize = false;
+
+ // the changes to the copies issue Modification that reach (via the
+ // father of the copies, i.e., this) the shared add_Modification() of this
+ // StochasticUCBlock and of its ancestors, which is not thread-safe: they
+ // are therefore done one thread at a time, only the solves run in parallel
+ std::mutex change_mutex;
+
+ // solves scenario s on copy k with the current penalties
+ auto solve = [ & ]( Index k , Index s ) {
+  std::vector< double > c( T );
+  {
+   std::lock_guard< std::mutex > lock( change_mutex );
+   if( K < S )
+    set_scenario( k , s );
+
+   for( Index j = 0 ; j < J ; ++j ) {
+    const auto unit = thermal( k , j );
+    const auto scale = unit->get_scale();
+    for( Index t = 0 ; t < T ; ++t ) {
+     c[ t ] = const_term[ j ][ t ];
+     if( penalize )
+      c[ t ] += ( w[ ( s * J + j ) * T + t ] +
+                  rho / 2 * ( 1 - 2 * average[ j * T + t ] ) ) / scale;
+    }
+    unit->set_const_term( c.cbegin() , Range( 0 , T ) );
+   }
+  }
+
+  auto solver = get_copy( k )->get_registered_solvers().front();
+  solver->compute();
+  if( ! solver->has_var_solution() )
+   throw( std::runtime_error( "StochasticUCBlock::progressive_hedging: no "
+                              "solution found for scenario " +
+                              std::to_string( s ) ) );
+  solver->get_var_solution();
+
+  // the cost of the scenario, without the added terms
+  double value = solver->get_var_value();
+  for( Index j = 0 ; j < J ; ++j ) {
+   const auto commitment = thermal( k , j )->get_commitment( 0 );
+   for( Index t = 0 ; t < T ; ++t ) {
+    const double ust = commitment[ t ].get_value();
+    u[ ( s * J + j ) * T + t ] = ust;
+    if( penalize )
+     value -= ( w[ ( s * J + j ) * T + t ] +
+                rho / 2 * ( 1 - 2 * average[ j * T + t ] ) ) * ust;
+   }
+  }
+  cost[ s ] = value;
+ };
+
+ // restores the original constant terms in all the copies
+ auto restore = [ & ]() {
+  for( Index k = 0 ; k < K ; ++k )
+   for( Index j = 0 ; j < J ; ++j )
+    thermal( k , j )->set_const_term( const_term[ j ].cbegin() ,
+                                      Range( 0 , T ) );
+ };
+
+ PHResult result;
+
+ try {
+  for( ; result.iterations < std::max< Index >( max_iterations , 1 ) ; ) {
+   ++result.iterations;
+
+   // solve all the scenarios with the current penalties
+   solve_scenarios( solve , threads );
+
+   // the expected cost and the average commitments
+   result.expected_cost = 0;
+   std::fill( average.begin() , average.end() , 0 );
+   for( Index s = 0 ; s < S ; ++s ) {
+    result.expected_cost += v_probability[ s ] * cost[ s ];
+    for( Index i = 0 ; i < J * T ; ++i )
+     average[ i ] += v_probability[ s ] * u[ s * J * T + i ];
+   }
+
+   // the deviation from the average, and the multipliers update
+   result.deviation = 0;
+   for( Index s = 0 ; s < S ; ++s )
+    for( Index i = 0 ; i < J * T ; ++i ) {
+     const auto dev = u[ s * J * T + i ] - average[ i ];
+     result.deviation = std::max( result.deviation , std::abs( dev ) );
+     w[ s * J * T + i ] += rho * dev;
+    }
+
+   result.converged = ( result.deviation <= tolerance );
+   if( result.converged || ( ! f_non_anticipative ) )
+    break;
+   penalize = true;
+  }
+ } catch( ... ) {
+  restore();
+  throw;
+ }
+
+ restore();
+
+ result.commitment = std::move( average );
+ return( result );
+
+}  // end( StochasticUCBlock::progressive_hedging )
+
+/*--------------------------------------------------------------------------*/
+
+double StochasticUCBlock::evaluate_commitment(
+ const std::vector< double > & commitment , unsigned int threads )
+{
+ const auto S = f_number_scenarios;
+ const Index K = v_Block.size();
+ const auto units = thermal_units();
+ const Index J = units.size();
+ const auto T = get_copy( 0 )->get_time_horizon();
+
+ if( commitment.size() != J * T )
+  throw( std::invalid_argument( "StochasticUCBlock::evaluate_commitment: "
+                                "commitment must have " +
+                                std::to_string( J * T ) + " elements" ) );
+
+ for( Index k = 0 ; k < K ; ++k )
+  if( get_copy( k )->get_registered_solvers().empty() )
+   throw( std::logic_error( "StochasticUCBlock::evaluate_commitment: no "
+                            "Solver registered to copy " +
+                            std::to_string( k ) ) );
+
+ // the commitment variables that have been fixed here, for each copy, so
+ // that those that were already fixed are left alone
+ std::vector< std::vector< ColVariable * > > fixed( K );
+
+ auto fix = [ & ]( Index k ) {
+  for( Index j = 0 ; j < J ; ++j ) {
+   const auto u = get_copy( k )->get_unit_block( units[ j ] )
+                   ->get_commitment( 0 );
+   if( ! u )
+    throw( std::logic_error( "StochasticUCBlock::evaluate_commitment: "
+                             "commitment variables of unit " +
+                             std::to_string( units[ j ] ) +
+                             " not generated" ) );
+   for( Index t = 0 ; t < T ; ++t )
+    if( ! u[ t ].is_fixed() ) {
+     u[ t ].set_value( commitment[ j * T + t ] >= 0.5 ? 1 : 0 );
+     u[ t ].fix();
+     fixed[ k ].push_back( & u[ t ] );
+    }
+  }
+ };
+
+ auto unfix = [ & ]( Index k ) {
+  for( auto var : fixed[ k ] )
+   var->unfix();
+  fixed[ k ].clear();
+ };
+
+ // as in progressive_hedging(), the changes to the copies are done one
+ // thread at a time, only the solves run in parallel
+ std::mutex change_mutex;
+ std::vector< double > cost( S , 0 );
+
+ auto solve = [ & ]( Index k , Index s ) {
+  {
+   std::lock_guard< std::mutex > lock( change_mutex );
+   if( K < S )
+    set_scenario( k , s );
+   fix( k );
+  }
+
+  auto solver = get_copy( k )->get_registered_solvers().front();
+  solver->compute();
+  cost[ s ] = solver->has_var_solution() ? solver->get_var_value()
+                                         : Inf< double >();
+
+  std::lock_guard< std::mutex > lock( change_mutex );
+  unfix( k );
+ };
+
+ try {
+  solve_scenarios( solve , threads );
+ } catch( ... ) {
+  for( Index k = 0 ; k < K ; ++k )
+   unfix( k );
+  throw;
+ }
+
+ double expected_cost = 0;
+ for( Index s = 0 ; s < S ; ++s ) {
+  if( cost[ s ] == Inf< double >() )
+   return( Inf< double >() );
+  expected_cost += v_probability[ s ] * cost[ s ];
+ }
+ return( expected_cost );
+
+}  // end( StochasticUCBlock::evaluate_commitment )
+
+/*--------------------------------------------------------------------------*/
+/*----------------- METHODS FOR SAVING THE StochasticUCBlock ---------------*/
+/*--------------------------------------------------------------------------*/
+
+void StochasticUCBlock::serialize( netCDF::NcGroup & group ) const
+{
+ Block::serialize( group );
+
+ const auto uc = get_copy( 0 );
+ const auto T = uc->get_time_horizon();
+
+ auto NumberScenarios = group.addDim( "NumberScenarios" ,
+                                      f_number_scenarios );
+
+ if( v_Block.size() > 1 )
+  group.putAtt( "NumberCopies" , netCDF::NcInt() , int( v_Block.size() ) );
+ if( ! f_non_anticipative )
+  group.putAtt( "NonAnticipative" , netCDF::NcInt() , 0 );
+
+ group.addVar( "Probability" , netCDF::NcDouble() ,
+               NumberScenarios ).putVar( v_probability.data() );
+
+ netCDF::NcDim TimeHorizon;
+ if( ( ! v_active_power_demand.empty() ) || ( ! v_max_power.empty() ) )
+  TimeHorizon = group.addDim( "TimeHorizon" , T );
+
+ if( ! v_active_power_demand.empty() ) {
+  auto NumberNodes = group.addDim( "NumberNodes" , uc->get_number_nodes() );
+  group.addVar( "ActivePowerDemand" , netCDF::NcDouble() ,
+                { NumberScenarios , NumberNodes , TimeHorizon } ).putVar(
+                 v_active_power_demand.data() );
+ }
+
+ for( const auto & [ u , max_power ] : v_max_power )
+  group.addGroup( "UnitBlock_" + std::to_string( u ) ).addVar(
+   "MaxPower" , netCDF::NcDouble() , { NumberScenarios , TimeHorizon } )
+   .putVar( max_power.data() );
+
+ auto base = group.addGroup( "UCBlock" );
+ uc->serialize( base );
+
+}  // end( StochasticUCBlock::serialize )
+
+/*--------------------------------------------------------------------------*/
+/*---------------------- PRIVATE METHODS OF THE CLASS ----------------------*/
+/*--------------------------------------------------------------------------*/
+
+void StochasticUCBlock::solve_scenarios(
+ const std::function< void( Index , Index ) > & solve ,
+ unsigned int threads )
+{
+ const auto S = f_number_scenarios;
+ const Index K = v_Block.size();
+
+ if( ! threads )
+  threads = std::max( 1u , std::thread::hardware_concurrency() );
+ threads = std::min< std::size_t >( threads , K );
+
+ // each thread uses its own copy: if K == S copy s holds scenario s,
+ // otherwise the next scenario is picked
+ std::atomic< Index > next( 0 );
+ std::exception_ptr error;
+ std::mutex error_mutex;
+
+ auto record_error = [ & ]() {
+  std::lock_guard< std::mutex > lock( error_mutex );
+  if( ! error )
+   error = std::current_exception();
+  next = S;
+ };
+
+ auto work = [ & ]( Index k ) {
+  try {
+   if( K == S )
+    for( ; ( k < S ) && ( next < S ) ; k += threads )
+     solve( k , k );
+   else
+    while( true ) {
+     const auto s = next++;
+     if( s >= S )
+      break;
+     solve( k , s );
+    }
+  } catch( ... ) {
+   record_error();
+  }
+ };
+
+ std::vector< std::thread > pool;
+ try {
+  for( unsigned int i = 1 ; i < threads ; ++i )
+   pool.emplace_back( work , i );
+ } catch( ... ) {
+  record_error();
+ }
+ work( 0 );
+ for( auto & thread : pool )
+  thread.join();
+
+ if( error )
+  std::rethrow_exception( error );
+
+}  // end( StochasticUCBlock::solve_scenarios )
+
+/*--------------------------------------------------------------------------*/
+
+std::vector< Block::Index > StochasticUCBlock::thermal_units( void ) const
+{
+ std::vector< Index > units;
+ const auto uc = get_copy( 0 );
+ for( Index i = 0 ; i < uc->get_number_units() ; ++i )
+  if( dynamic_cast< ThermalUnitBlock * >( uc->get_unit_block( i ) ) )
+   units.push_back( i );
+ return( units );
+}
+
+/*--------------------------------------------------------------------------*/
+/*--------------------- End File StochasticUCBlock.cpp ---------------------*/
+/*--------------------------------------------------------------------------*/
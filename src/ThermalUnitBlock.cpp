@@ -35,10 +35,17 @@
 
 #include "LinearFunction.h"
 
+#include "NewLinearFunction.h"
+
+
 #include "DQuadFunction.h"
 
 #include "ThermalUnitBlock.h"
 
+#include "ThermalUnitDPSolver.h"
+
+#include "UCTrace.h"
+
 /*--------------------------------------------------------------------------*/
 /*------------------------- NAMESPACE AND USING ----------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -177,36 +184,40 @@ ThermalUnitBlock::~ThermalUnitBlock()
 
 void ThermalUnitBlock::deserialize( const netCDF::NcGroup & group )
 {
+ UCBLOCK_TRACE_SPAN( "ThermalUnitBlock::deserialize" );
 
 #ifndef NDEBUG
- std::vector< std::string > expected_dims = { "TimeHorizon" ,
-                                              "NumberIntervals" };
- check_dimensions( group , expected_dims , std::cerr );
-
- // we only check for unexpected fields if "this" is a "true"
- // ThermalUnitBlock, i.e., not any derived class. this is because derived
- // classes will likely *have* other fields that tha base class does not
- // know about, and therefore it would complain about them. the idea is that
- // derived classes will then have to check for all expected fields,
- // comprised those of the base class
- // we don't do the same for dimensions as it's unlikely that derived
- // classes will introduce entirely new dimensions
- if( typeid( ThermalUnitBlock ) == typeid( *this ) ) {
-  std::vector< std::string > expected_vars = { "InvestmentCost" , "Capacity" ,
-                                               "MinPower" , "MaxPower" ,
-                                               "DeltaRampUp" , "DeltaRampDown" ,
-                                               "PrimaryRho" , "SecondaryRho" ,
-                                               "LinearTerm" , "QuadTerm" ,
-                                               "ConstTerm" , "StartUpCost" ,
-                                               "FixedConsumption" ,
-                                               "InertiaCommitment" ,
-                                               "InitialPower" , "MinUpTime" ,
-                                               "MinDownTime" ,
-                                               "InitUpDownTime" ,
-                                               "Availability" ,
-                                               "StartUpLimit" ,
-                                               "ShutDownLimit" };
-  check_variables( group , expected_vars , std::cerr );
+ if( ! validated_data() ) {
+  std::vector< std::string > expected_dims = { "TimeHorizon" ,
+                                               "NumberIntervals" };
+  check_dimensions( group , expected_dims , std::cerr );
+
+  // we only check for unexpected fields if "this" is a "true"
+  // ThermalUnitBlock, i.e., not any derived class. this is because derived
+  // classes will likely *have* other fields that tha base class does not
+  // know about, and therefore it would complain about them. the idea is that
+  // derived classes will then have to check for all expected fields,
+  // comprised those of the base class
+  // we don't do the same for dimensions as it's unlikely that derived
+  // classes will introduce entirely new dimensions
+  if( typeid( ThermalUnitBlock ) == typeid( *this ) ) {
+   std::vector< std::string > expected_vars = { "InvestmentCost" , "Capacity" ,
+                                                "MinPower" , "MaxPower" ,
+                                                "DeltaRampUp" ,
+                                                "DeltaRampDown" ,
+                                                "PrimaryRho" , "SecondaryRho" ,
+                                                "LinearTerm" , "QuadTerm" ,
+                                                "ConstTerm" , "StartUpCost" ,
+                                                "FixedConsumption" ,
+                                                "InertiaCommitment" ,
+                                                "InitialPower" , "MinUpTime" ,
+                                                "MinDownTime" ,
+                                                "InitUpDownTime" ,
+                                                "Availability" ,
+                                                "StartUpLimit" ,
+                                                "ShutDownLimit" };
+   check_variables( group , expected_vars , std::cerr );
+  }
  }
 #endif
 
@@ -301,12 +312,55 @@ void ThermalUnitBlock::deserialize( const netCDF::NcGroup & group )
  decompress_vector( v_StartUpLimit );
  decompress_vector( v_ShutDownLimit );
 
- check_data_consistency();
+ if( ! validated_data() )
+  check_data_consistency();
 
 }  // end( ThermalUnitBlock::deserialize )
 
 /*--------------------------------------------------------------------------*/
 
+UnitBlock * ThermalUnitBlock::clone( Block * father ) const
+{
+ auto unit = std::make_unique< ThermalUnitBlock >( father );
+ unit->clone_data( *this );
+ return( unit.release() );
+}
+
+/*--------------------------------------------------------------------------*/
+
+void ThermalUnitBlock::clone_data( const ThermalUnitBlock & from )
+{
+ UnitBlock::clone_data( from );
+
+ v_MinPower = from.v_MinPower;
+ v_MaxPower = from.v_MaxPower;
+ v_Availability = from.v_Availability;
+ v_PrimaryRho = from.v_PrimaryRho;
+ v_SecondaryRho = from.v_SecondaryRho;
+ v_DeltaRampUp = from.v_DeltaRampUp;
+ v_DeltaRampDown = from.v_DeltaRampDown;
+ v_QuadTerm = from.v_QuadTerm;
+ v_LinearTerm = from.v_LinearTerm;
+ v_ConstTerm = from.v_ConstTerm;
+ v_StartUpCost = from.v_StartUpCost;
+ v_PrimarySpinningReserveCost = from.v_PrimarySpinningReserveCost;
+ v_SecondarySpinningReserveCost = from.v_SecondarySpinningReserveCost;
+ v_FixedConsumption = from.v_FixedConsumption;
+ v_InertiaCommitment = from.v_InertiaCommitment;
+ v_StartUpLimit = from.v_StartUpLimit;
+ v_ShutDownLimit = from.v_ShutDownLimit;
+
+ f_InvestmentCost = from.f_InvestmentCost;
+ f_Capacity = from.f_Capacity;
+ f_InitialPower = from.f_InitialPower;
+ f_InitUpDownTime = from.f_InitUpDownTime;
+ f_MinUpTime = from.f_MinUpTime;
+ f_MinDownTime = from.f_MinDownTime;
+ f_scale = from.f_scale;
+}
+
+/*--------------------------------------------------------------------------*/
+
 void ThermalUnitBlock::check_data_consistency( void ) const
 {
  // InvestmentCost- - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -427,6 +481,8 @@ void ThermalUnitBlock::check_data_consistency( void ) const
 
 void ThermalUnitBlock::generate_abstract_variables( Configuration * stvv )
 {
+ UCBLOCK_TRACE_SPAN( "ThermalUnitBlock::generate_abstract_variables" );
+
  if( variables_generated() )  // variables have already been generated
   return;                     // nothing to do
 
@@ -509,6 +565,14 @@ void ThermalUnitBlock::generate_abstract_variables( Configuration * stvv )
    }
   }
 
+  // if the unit is forced to be on, then the commitment design constraints
+  // u_t <= x for t < init_t read 1 <= x: rather than having them as rows,
+  // the design variable is directly fixed to 1
+  if( ( f_InvestmentCost != 0 ) && ( init_t > 0 ) ) {
+   design.set_value( 1.0 );
+   design.is_fixed( true );
+  }
+
   for( Index t = init_t ;
        t < std::min( init_t + f_MinDownTime , f_time_horizon ) ; ++t ) {
    v_start_up[ t - init_t ].set_value( 0.0 );
@@ -765,6 +829,8 @@ void ThermalUnitBlock::generate_abstract_variables( Configuration * stvv )
 
 void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 {
+ UCBLOCK_TRACE_SPAN( "ThermalUnitBlock::generate_abstract_constraints" );
+
  if( constraints_generated() )  // constraints have already been generated
   return;                       // nothing to do
 
@@ -781,17 +847,21 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
  if( f_InvestmentCost != 0 ) {
 
-  CommitmentDesign_Const.resize( f_time_horizon );
+  // the constraints are only needed for t >= init_t: for t < init_t the
+  // commitment is fixed, either to 0 (and u_t <= x is redundant) or to 1
+  // (and then x has been fixed to 1 in generate_abstract_variables())
 
-  for( Index t = 0 ; t < f_time_horizon ; ++t ) {
+  CommitmentDesign_Const.resize( f_time_horizon - init_t );
+
+  for( Index t = init_t ; t < f_time_horizon ; ++t ) {
 
    vars.push_back( std::make_pair( &v_commitment[ t ] , 1.0 ) );
    vars.push_back( std::make_pair( &design , -1.0 ) );
 
-   CommitmentDesign_Const[ t ].set_lhs( -Inf< double >() );
-   CommitmentDesign_Const[ t ].set_rhs( 0.0 );
-   CommitmentDesign_Const[ t ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+   CommitmentDesign_Const[ t - init_t ].set_lhs( -Inf< double >() );
+   CommitmentDesign_Const[ t - init_t ].set_rhs( 0.0 );
+   CommitmentDesign_Const[ t - init_t ].set_function(
+    new_LinearFunction( vars ) );
   }
 
   add_static_constraint( CommitmentDesign_Const ,
@@ -828,7 +898,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
      else
       StartUp_ShutDown_Variables_Const[ cnstr_idx ].set_both( 0.0 );
      StartUp_ShutDown_Variables_Const[ cnstr_idx ].set_function(
-      new LinearFunction( std::move( vars ) ) );
+      new_LinearFunction( vars ) );
     }
 
     add_static_constraint( StartUp_ShutDown_Variables_Const ,
@@ -856,7 +926,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
      StartUp_Const[ cnstr_idx ].set_lhs( 0.0 );
      StartUp_Const[ cnstr_idx ].set_rhs( Inf< double >() );
      StartUp_Const[ cnstr_idx ].set_function(
-      new LinearFunction( std::move( vars ) ) );
+      new_LinearFunction( vars ) );
     }
 
     add_static_constraint( StartUp_Const , "StartUp_Commitment_Const_Thermal" );
@@ -883,7 +953,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
      ShutDown_Const[ cnstr_idx ].set_lhs( -Inf< double >() );
      ShutDown_Const[ cnstr_idx ].set_rhs( 1.0 );
      ShutDown_Const[ cnstr_idx ].set_function(
-      new LinearFunction( std::move( vars ) ) );
+      new_LinearFunction( vars ) );
     }
 
     add_static_constraint( ShutDown_Const ,
@@ -923,7 +993,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
       Eq_ActivePower_Const[ t ].set_both( 0.0 );
       Eq_ActivePower_Const[ t ].set_function(
-       new LinearFunction( std::move( vars ) ) );
+       new_LinearFunction( vars ) );
      }
 
     } else if( ( AR & FormMsk ) == SUForm ) {  // SU formulation- - - - - - -
@@ -938,7 +1008,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
       Eq_ActivePower_Const[ t ].set_both( 0.0 );
       Eq_ActivePower_Const[ t ].set_function(
-       new LinearFunction( std::move( vars ) ) );
+       new_LinearFunction( vars ) );
      }
 
     } else if( ( AR & FormMsk ) == SDForm ) {  // SD formulation- - - - - - -
@@ -953,7 +1023,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
       Eq_ActivePower_Const[ t ].set_both( 0.0 );
       Eq_ActivePower_Const[ t ].set_function(
-       new LinearFunction( std::move( vars ) ) );
+       new_LinearFunction( vars ) );
      }
     }
 
@@ -977,7 +1047,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
     Eq_Commitment_Const[ t ].set_both( 0.0 );
     Eq_Commitment_Const[ t ].set_function(
-     new LinearFunction( std::move( vars ) ) );
+     new_LinearFunction( vars ) );
    }
 
    add_static_constraint( Eq_Commitment_Const , "Eq_Commitment_Const_Thermal" );
@@ -999,7 +1069,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
     Eq_StartUp_Const[ cnstr_idx ].set_both( 0.0 );
     Eq_StartUp_Const[ cnstr_idx ].set_function(
-     new LinearFunction( std::move( vars ) ) );
+     new_LinearFunction( vars ) );
    }
 
    add_static_constraint( Eq_StartUp_Const , "Eq_StartUp_Const_Thermal" );
@@ -1021,7 +1091,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
     Eq_ShutDown_Const[ cnstr_idx ].set_both( 0.0 );
     Eq_ShutDown_Const[ cnstr_idx ].set_function(
-     new LinearFunction( std::move( vars ) ) );
+     new_LinearFunction( vars ) );
    }
 
    add_static_constraint( Eq_ShutDown_Const , "Eq_ShutDown_Const_Thermal" );
@@ -1047,7 +1117,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
     Network_Const[ cnstr_idx ].set_both( -1.0 );
     Network_Const[ cnstr_idx ].set_function(
-     new LinearFunction( std::move( vars ) ) );
+     new_LinearFunction( vars ) );
    }
 
    for( Index t = 0 ; t < v_nodes_plus.size() ; ++t , ++cnstr_idx ) {
@@ -1062,7 +1132,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
     Network_Const[ cnstr_idx ].set_both( 0.0 );
     Network_Const[ cnstr_idx ].set_function(
-     new LinearFunction( std::move( vars ) ) );
+     new_LinearFunction( vars ) );
    }
 
    for( Index t = 0 ; t < v_nodes_minus.size() ; ++t , ++cnstr_idx ) {
@@ -1077,7 +1147,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
     Network_Const[ cnstr_idx ].set_both( 0.0 );
     Network_Const[ cnstr_idx ].set_function(
-     new LinearFunction( std::move( vars ) ) );
+     new_LinearFunction( vars ) );
    }
 
    for( Index t = f_time_horizon + 1 ;
@@ -1093,7 +1163,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
     Network_Const[ cnstr_idx ].set_both( 1.0 );
     Network_Const[ cnstr_idx ].set_function(
-     new LinearFunction( std::move( vars ) ) );
+     new_LinearFunction( vars ) );
    }
 
    add_static_constraint( Network_Const , "Network_Const_Thermal" );
@@ -1153,7 +1223,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
      RampUp_Const[ t ].set_rhs( f_InitialPower + v_DeltaRampUp[ t ] );
     else if( ( t > 0 ) || ( ( t == 0 ) && ( f_InitUpDownTime <= 0 ) ) )
      RampUp_Const[ t ].set_rhs( 0.0 );
-    RampUp_Const[ t ].set_function( new LinearFunction( std::move( vars ) ) );
+    RampUp_Const[ t ].set_function( new_LinearFunction( vars ) );
    }
 
   } else if( ( AR & FormMsk ) == TForm ) {  // T formulation- - - - - - - - -
@@ -1186,7 +1256,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
       f_InitialPower - get_operational_min_power( t ) );
     else if( ( t > 0 ) || ( ( t == 0 ) && ( f_InitUpDownTime <= 0 ) ) )
      RampUp_Const[ t ].set_rhs( 0.0 );
-    RampUp_Const[ t ].set_function( new LinearFunction( std::move( vars ) ) );
+    RampUp_Const[ t ].set_function( new_LinearFunction( vars ) );
    }
 
   } else if( ( AR & FormMsk ) == ptForm ) {  // pt formulation- - - - - - - -
@@ -1229,7 +1299,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
      RampUp_Const[ cnstr_idx ].set_lhs( -Inf< double >() );
      RampUp_Const[ cnstr_idx ].set_rhs( 0.0 );
      RampUp_Const[ cnstr_idx ].set_function(
-      new LinearFunction( std::move( vars ) ) );
+      new_LinearFunction( vars ) );
 
      cnstr_idx++;
     }
@@ -1283,7 +1353,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
       RampUp_Const[ cnstr_idx ].set_lhs( -Inf< double >() );
       RampUp_Const[ cnstr_idx ].set_rhs( 0.0 );
       RampUp_Const[ cnstr_idx ].set_function(
-       new LinearFunction( std::move( vars ) ) );
+       new_LinearFunction( vars ) );
 
       cnstr_idx++;
      }
@@ -1324,7 +1394,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
        RampUp_Const[ cnstr_idx ].set_lhs( -Inf< double >() );
        RampUp_Const[ cnstr_idx ].set_rhs( 0.0 );
        RampUp_Const[ cnstr_idx ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
 
        cnstr_idx++;
       }
@@ -1350,7 +1420,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
        RampUp_Const[ cnstr_idx ].set_lhs( -Inf< double >() );
        RampUp_Const[ cnstr_idx ].set_rhs( 0.0 );
        RampUp_Const[ cnstr_idx ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
 
        cnstr_idx++;
       }
@@ -1390,7 +1460,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
        RampUp_Const[ cnstr_idx ].set_lhs( -Inf< double >() );
        RampUp_Const[ cnstr_idx ].set_rhs( 0.0 );
        RampUp_Const[ cnstr_idx ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
 
        cnstr_idx++;
       }
@@ -1415,7 +1485,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
        RampUp_Const[ cnstr_idx ].set_lhs( -Inf< double >() );
        RampUp_Const[ cnstr_idx ].set_rhs( 0.0 );
        RampUp_Const[ cnstr_idx ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
 
        cnstr_idx++;
       }
@@ -1452,7 +1522,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
      RampDown_Const[ t ].set_rhs( -f_InitialPower );
     else if( ( t > 0 ) || ( ( t == 0 ) && ( f_InitUpDownTime <= 0 ) ) )
      RampDown_Const[ t ].set_rhs( 0.0 );
-    RampDown_Const[ t ].set_function( new LinearFunction( std::move( vars ) ) );
+    RampDown_Const[ t ].set_function( new_LinearFunction( vars ) );
    }
 
   } else if( ( AR & FormMsk ) == TForm ) {  // T formulation- - - - - - - - -
@@ -1487,7 +1557,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
          get_operational_min_power( t ) ) );
     else if( ( t > 0 ) || ( ( t == 0 ) && ( f_InitUpDownTime <= 0 ) ) )
      RampDown_Const[ t ].set_rhs( 0.0 );
-    RampDown_Const[ t ].set_function( new LinearFunction( std::move( vars ) ) );
+    RampDown_Const[ t ].set_function( new_LinearFunction( vars ) );
    }
 
   } else if( ( AR & FormMsk ) == ptForm ) {  // pt formulation- - - - - - - -
@@ -1530,7 +1600,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
      RampDown_Const[ cnstr_idx ].set_lhs( -Inf< double >() );
      RampDown_Const[ cnstr_idx ].set_rhs( 0.0 );
      RampDown_Const[ cnstr_idx ].set_function(
-      new LinearFunction( std::move( vars ) ) );
+      new_LinearFunction( vars ) );
 
      cnstr_idx++;
     }
@@ -1584,7 +1654,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
       RampDown_Const[ cnstr_idx ].set_lhs( -Inf< double >() );
       RampDown_Const[ cnstr_idx ].set_rhs( 0.0 );
       RampDown_Const[ cnstr_idx ].set_function(
-       new LinearFunction( std::move( vars ) ) );
+       new_LinearFunction( vars ) );
 
       cnstr_idx++;
      }
@@ -1625,7 +1695,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
        RampDown_Const[ cnstr_idx ].set_lhs( -Inf< double >() );
        RampDown_Const[ cnstr_idx ].set_rhs( 0.0 );
        RampDown_Const[ cnstr_idx ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
 
        cnstr_idx++;
       }
@@ -1651,7 +1721,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
        RampDown_Const[ cnstr_idx ].set_lhs( -Inf< double >() );
        RampDown_Const[ cnstr_idx ].set_rhs( 0.0 );
        RampDown_Const[ cnstr_idx ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
 
        cnstr_idx++;
       }
@@ -1690,7 +1760,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
        RampDown_Const[ cnstr_idx ].set_lhs( -Inf< double >() );
        RampDown_Const[ cnstr_idx ].set_rhs( 0.0 );
        RampDown_Const[ cnstr_idx ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
 
        cnstr_idx++;
       }
@@ -1716,7 +1786,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
        RampDown_Const[ cnstr_idx ].set_lhs( -Inf< double >() );
        RampDown_Const[ cnstr_idx ].set_rhs( 0.0 );
        RampDown_Const[ cnstr_idx ].set_function(
-        new LinearFunction( std::move( vars ) ) );
+        new_LinearFunction( vars ) );
 
        cnstr_idx++;
       }
@@ -1752,7 +1822,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
    MinPower_Const[ t ].set_lhs( 0.0 );
    MinPower_Const[ t ].set_rhs( Inf< double >() );
-   MinPower_Const[ t ].set_function( new LinearFunction( std::move( vars ) ) );
+   MinPower_Const[ t ].set_function( new_LinearFunction( vars ) );
   }
 
  } else if( ( AR & FormMsk ) == ptForm ) {  // pt formulation - - - - - - - -
@@ -1783,7 +1853,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
    MinPower_Const[ constraint_index ].set_lhs( 0.0 );
    MinPower_Const[ constraint_index ].set_rhs( Inf< double >() );
    MinPower_Const[ constraint_index ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
   }
 
  } else if( ( AR & FormMsk ) == DPForm ) {  // DP formulation - - - - - - - -
@@ -1803,7 +1873,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
    MinPower_Const[ j ].set_lhs( 0.0 );
    MinPower_Const[ j ].set_rhs( Inf< double >() );
-   MinPower_Const[ j ].set_function( new LinearFunction( std::move( vars ) ) );
+   MinPower_Const[ j ].set_function( new_LinearFunction( vars ) );
   }
 
  } else if( ( AR & FormMsk ) == SUForm ) {  // SU formulation - - - - - - - -
@@ -1823,7 +1893,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
    MinPower_Const[ j ].set_lhs( 0.0 );
    MinPower_Const[ j ].set_rhs( Inf< double >() );
-   MinPower_Const[ j ].set_function( new LinearFunction( std::move( vars ) ) );
+   MinPower_Const[ j ].set_function( new_LinearFunction( vars ) );
   }
 
  } else if( ( AR & FormMsk ) == SDForm ) {  // SD formulation - - - - - - - -
@@ -1843,7 +1913,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
    MinPower_Const[ j ].set_lhs( 0.0 );
    MinPower_Const[ j ].set_rhs( Inf< double >() );
-   MinPower_Const[ j ].set_function( new LinearFunction( std::move( vars ) ) );
+   MinPower_Const[ j ].set_function( new_LinearFunction( vars ) );
   }
  }
 
@@ -1911,7 +1981,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
    MaxPower_Const[ cnstr_idx ].set_lhs( 0.0 );
    MaxPower_Const[ cnstr_idx ].set_rhs( Inf< double >() );
    MaxPower_Const[ cnstr_idx ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
 
    if( t >= init_t ) {
     if( f_MinUpTime == 1 ) {
@@ -1944,7 +2014,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
       MaxPower_Const[ cnstr_idx ].set_lhs( 0.0 );
       MaxPower_Const[ cnstr_idx ].set_rhs( Inf< double >() );
       MaxPower_Const[ cnstr_idx ].set_function(
-       new LinearFunction( std::move( vars ) ) );
+       new_LinearFunction( vars ) );
      }
     }
    }
@@ -2027,7 +2097,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
    MaxPower_Const[ cnstr_idx ].set_lhs( 0.0 );
    MaxPower_Const[ cnstr_idx ].set_rhs( Inf< double >() );
    MaxPower_Const[ cnstr_idx ].set_function(
-    new LinearFunction( std::move( vars ) ) );
+    new_LinearFunction( vars ) );
   }
 
   // Bound constraints 1- - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -2062,7 +2132,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
     MaxPower_Const[ cnstr_idx ].set_lhs( 0.0 );
     MaxPower_Const[ cnstr_idx ].set_rhs( Inf< double >() );
     MaxPower_Const[ cnstr_idx ].set_function(
-     new LinearFunction( std::move( vars ) ) );
+     new_LinearFunction( vars ) );
    }
 
   if( f_MinUpTime == 1 ) {
@@ -2100,7 +2170,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
     MaxPower_Const[ cnstr_idx ].set_lhs( 0.0 );
     MaxPower_Const[ cnstr_idx ].set_rhs( Inf< double >() );
     MaxPower_Const[ cnstr_idx ].set_function(
-     new LinearFunction( std::move( vars ) ) );
+     new_LinearFunction( vars ) );
    }
 
    // Bound constraints 3 - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -2136,7 +2206,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
     MaxPower_Const[ cnstr_idx ].set_lhs( 0.0 );
     MaxPower_Const[ cnstr_idx ].set_rhs( Inf< double >() );
     MaxPower_Const[ cnstr_idx ].set_function(
-     new LinearFunction( std::move( vars ) ) );
+     new_LinearFunction( vars ) );
    }
   }
 
@@ -2180,7 +2250,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
     MaxPower_Const[ cnstr_idx ].set_lhs( 0.0 );
     MaxPower_Const[ cnstr_idx ].set_rhs( Inf< double >() );
     MaxPower_Const[ cnstr_idx ].set_function(
-     new LinearFunction( std::move( vars ) ) );
+     new_LinearFunction( vars ) );
    }
 
    // Bound constraints 5 - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -2217,7 +2287,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
      MaxPower_Const[ cnstr_idx ].set_lhs( 0.0 );
      MaxPower_Const[ cnstr_idx ].set_rhs( Inf< double >() );
      MaxPower_Const[ cnstr_idx ].set_function(
-      new LinearFunction( std::move( vars ) ) );
+      new_LinearFunction( vars ) );
 
      cnstr_idx++;
     }
@@ -2263,7 +2333,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
      MaxPower_Const[ cnstr_idx ].set_lhs( 0.0 );
      MaxPower_Const[ cnstr_idx ].set_rhs( Inf< double >() );
      MaxPower_Const[ cnstr_idx ].set_function(
-      new LinearFunction( std::move( vars ) ) );
+      new_LinearFunction( vars ) );
 
      cnstr_idx++;
     }
@@ -2294,7 +2364,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
    MaxPower_Const[ j ].set_lhs( 0.0 );
    MaxPower_Const[ j ].set_rhs( Inf< double >() );
-   MaxPower_Const[ j ].set_function( new LinearFunction( std::move( vars ) ) );
+   MaxPower_Const[ j ].set_function( new_LinearFunction( vars ) );
   }
 
  } else {  // pt, SU or SD formulations - - - - - - - - - - - - - - - - - - -
@@ -2388,7 +2458,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
     MaxPower_Const[ t ].set_lhs( 0.0 );
     MaxPower_Const[ t ].set_rhs( Inf< double >() );
-    MaxPower_Const[ t ].set_function( new LinearFunction( std::move( vars ) ) );
+    MaxPower_Const[ t ].set_function( new_LinearFunction( vars ) );
    }
 
   } else if( ( AR & FormMsk ) == SUForm ) {  // SU formulation- - - - - - - -
@@ -2433,7 +2503,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
     MaxPower_Const[ j ].set_lhs( 0.0 );
     MaxPower_Const[ j ].set_rhs( Inf< double >() );
-    MaxPower_Const[ j ].set_function( new LinearFunction( std::move( vars ) ) );
+    MaxPower_Const[ j ].set_function( new_LinearFunction( vars ) );
    }
 
   } else if( ( AR & FormMsk ) == SDForm ) {  // SD formulation- - - - - - - -
@@ -2478,7 +2548,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
 
     MaxPower_Const[ j ].set_lhs( 0.0 );
     MaxPower_Const[ j ].set_rhs( Inf< double >() );
-    MaxPower_Const[ j ].set_function( new LinearFunction( std::move( vars ) ) );
+    MaxPower_Const[ j ].set_function( new_LinearFunction( vars ) );
    }
   }
  }
@@ -2506,7 +2576,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
     PrimaryRho_Const[ t ].set_lhs( 0.0 );
     PrimaryRho_Const[ t ].set_rhs( Inf< double >() );
     PrimaryRho_Const[ t ].set_function(
-     new LinearFunction( std::move( vars ) ) );
+     new_LinearFunction( vars ) );
    }
 
    add_static_constraint( PrimaryRho_Const , "PrimaryRho_Const_Thermal" );
@@ -2534,7 +2604,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
     SecondaryRho_Const[ t ].set_lhs( 0.0 );
     SecondaryRho_Const[ t ].set_rhs( Inf< double >() );
     SecondaryRho_Const[ t ].set_function(
-     new LinearFunction( std::move( vars ) ) );
+     new_LinearFunction( vars ) );
    }
 
    add_static_constraint( SecondaryRho_Const , "SecondaryRho_Const_Thermal" );
@@ -2618,7 +2688,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
      Init_PC_Const[ cnstr_idx ].set_lhs( -Inf< double >() );
      Init_PC_Const[ cnstr_idx ].set_rhs( 0.0 );
      Init_PC_Const[ cnstr_idx ].set_function(
-      new LinearFunction( std::move( vars ) ) );
+      new_LinearFunction( vars ) );
 
      cnstr_idx++;
     }
@@ -2645,7 +2715,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
      Init_PC_Const[ cnstr_idx ].set_lhs( -Inf< double >() );
      Init_PC_Const[ cnstr_idx ].set_rhs( 0.0 );
      Init_PC_Const[ cnstr_idx ].set_function(
-      new LinearFunction( std::move( vars ) ) );
+      new_LinearFunction( vars ) );
 
      cnstr_idx++;
     }
@@ -2678,7 +2748,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
      Init_PC_Const[ cnstr_idx ].set_lhs( -Inf< double >() );
      Init_PC_Const[ cnstr_idx ].set_rhs( 0.0 );
      Init_PC_Const[ cnstr_idx ].set_function(
-      new LinearFunction( std::move( vars ) ) );
+      new_LinearFunction( vars ) );
 
      cnstr_idx++;
     }
@@ -2710,7 +2780,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
      Init_PC_Const[ cnstr_idx ].set_lhs( -Inf< double >() );
      Init_PC_Const[ cnstr_idx ].set_rhs( 0.0 );
      Init_PC_Const[ cnstr_idx ].set_function(
-      new LinearFunction( std::move( vars ) ) );
+      new_LinearFunction( vars ) );
 
      cnstr_idx++;
     }
@@ -2742,7 +2812,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
      Init_PC_Const[ cnstr_idx ].set_lhs( -Inf< double >() );
      Init_PC_Const[ cnstr_idx ].set_rhs( 0.0 );
      Init_PC_Const[ cnstr_idx ].set_function(
-      new LinearFunction( std::move( vars ) ) );
+      new_LinearFunction( vars ) );
 
      cnstr_idx++;
     }
@@ -2773,7 +2843,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
        vars.push_back( std::make_pair( &v_cut_h_k[ j ] , -1.0 ) );
 
      Eq_PC_Const[ t ].set_both( 0.0 );
-     Eq_PC_Const[ t ].set_function( new LinearFunction( std::move( vars ) ) );
+     Eq_PC_Const[ t ].set_function( new_LinearFunction( vars ) );
     }
 
    } else if( ( AR & FormMsk ) == SUForm ) {  // SU formulation - - - - - - -
@@ -2787,7 +2857,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
        vars.push_back( std::make_pair( &v_cut_h[ j ] , -1.0 ) );
 
      Eq_PC_Const[ t ].set_both( 0.0 );
-     Eq_PC_Const[ t ].set_function( new LinearFunction( std::move( vars ) ) );
+     Eq_PC_Const[ t ].set_function( new_LinearFunction( vars ) );
     }
 
    } else if( ( AR & FormMsk ) == SDForm ) {  // SD formulation - - - - - - -
@@ -2801,7 +2871,7 @@ void ThermalUnitBlock::generate_abstract_constraints( Configuration * stcc )
        vars.push_back( std::make_pair( &v_cut_k[ j ] , -1.0 ) );
 
      Eq_PC_Const[ t ].set_both( 0.0 );
-     Eq_PC_Const[ t ].set_function( new LinearFunction( std::move( vars ) ) );
+     Eq_PC_Const[ t ].set_function( new_LinearFunction( vars ) );
     }
    }
   }
@@ -2878,6 +2948,8 @@ void ThermalUnitBlock::generate_dynamic_constraints( Configuration * dycc )
 
 void ThermalUnitBlock::generate_objective( Configuration * objc )
 {
+ UCBLOCK_TRACE_SPAN( "ThermalUnitBlock::generate_objective" );
+
  if( objective_generated() )  // Objective has already been generated
   return;                     // nothing to do
 
@@ -3135,12 +3207,33 @@ void ThermalUnitBlock::serialize( netCDF::NcGroup & group ) const
 
 }  // end( ThermalUnitBlock::serialize )
 
+/*--------------------------------------------------------------------------*/
+
+MemoryUsage ThermalUnitBlock::get_memory_usage( void ) const
+{
+ auto usage = UnitBlock::get_memory_usage();
+ usage.add_data( v_MinPower , v_MaxPower , v_Availability , v_PrimaryRho ,
+                 v_SecondaryRho , v_DeltaRampUp , v_DeltaRampDown ,
+                 v_QuadTerm , v_LinearTerm , v_ConstTerm , v_StartUpCost ,
+                 v_PrimarySpinningReserveCost ,
+                 v_SecondarySpinningReserveCost , v_FixedConsumption ,
+                 v_InertiaCommitment , v_StartUpLimit , v_ShutDownLimit ,
+                 v_P_h_k , v_Z_h_k , v_P_h , v_Z_h , v_P_k , v_Z_k ,
+                 v_nodes_plus , v_nodes_minus , v_Y_plus , v_Y_minus );
+ for( auto solver : get_registered_solvers() )
+  if( auto dps = dynamic_cast< const ThermalUnitDPSolver * >( solver ) )
+   usage.solver += dps->get_memory_usage();
+ return( usage );
+}  // end( ThermalUnitBlock::get_memory_usage )
+
 /*--------------------------------------------------------------------------*/
 /*------------------------ METHODS FOR CHANGING DATA -----------------------*/
 /*--------------------------------------------------------------------------*/
 
 void ThermalUnitBlock::add_Modification( sp_Mod mod , ChnlName chnl )
 {
+ UCBLOCK_TRACE_SPAN( "ThermalUnitBlock::add_Modification" );
+
  if( mod->concerns_Block() ) {
   mod->concerns_Block( false );
   guts_of_add_Modification( mod.get() , chnl );
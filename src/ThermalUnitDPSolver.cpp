@@ -39,10 +39,14 @@
 /*------------------------------ INCLUDES ----------------------------------*/
 /*--------------------------------------------------------------------------*/
 
+#include <array>
+
 #include "ThermalUnitDPSolver.h"
 
 #include "ThermalUnitBlock.h"
 
+#include "UCTrace.h"
+
 /*--------------------------------------------------------------------------*/
 /*------------------------- NAMESPACE AND USING ----------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -57,6 +61,8 @@ using namespace SMSpp_di_unipi_it;
 
 SMSpp_insert_in_factory_cpp_0( ThermalUnitDPSolver );
 
+std::atomic< bool > ThermalUnitDPSolver::f_fixed_horizon_kernels{ true };
+
 /*--------------------------------------------------------------------------*/
 /*--------------------------- Solver INTERFACE -----------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -89,6 +95,8 @@ void ThermalUnitDPSolver::set_Block( Block * block )
 
 int ThermalUnitDPSolver::compute( bool changedvars )
 {
+ UCBLOCK_TRACE_SPAN( "ThermalUnitDPSolver::compute" );
+
  lock();  // lock the mutex
 
  process_modifications();
@@ -158,12 +166,43 @@ void ThermalUnitDPSolver::get_var_solution( Configuration * solc )
 
  }  // end( ThermalUnitDPSolver::get_var_solution )
 
+/*--------------------------------------------------------------------------*/
+
+std::size_t ThermalUnitDPSolver::get_memory_usage( void ) const
+{
+ std::size_t bytes = sizeof( *this );
+ for( auto vec : { &startup_costs , &delta_ramp_up , &delta_ramp_down ,
+                   &min_power , &max_power , &bound_on , &bound_down ,
+                   &quad_term , &linear_term , &const_term , &P } )
+  bytes += vec->capacity() * sizeof( double );
+ bytes += U.capacity() / 8;
+
+ auto of_node = [ & bytes ]( const node & nde ) {
+  bytes += nde.v_arcs.capacity() * sizeof( arc );
+  if( nde.DPS )
+   bytes += sizeof( DPEDSolver ) + nde.DPS->get_memory_usage();
+  };
+
+ of_node( f_start );
+ of_node( f_end );
+ bytes += ( v_on_nodes.capacity() + v_off_nodes.capacity() ) * sizeof( node );
+ for( const auto & nde : v_on_nodes )
+  of_node( nde );
+ for( const auto & nde : v_off_nodes )
+  of_node( nde );
+
+ return( bytes );
+
+ }  // end( ThermalUnitDPSolver::get_memory_usage )
+
 /*--------------------------------------------------------------------------*/
 /*------------------ BUILDING AND SOLVING THE DP PROBLEM -------------------*/
 /*--------------------------------------------------------------------------*/
 
 void ThermalUnitDPSolver::build_graph( void )
 {
+ UCBLOCK_TRACE_SPAN( "ThermalUnitDPSolver::build_graph" );
+
  // first reset any existing graph; note that node labels will be set to 0,
  // which we use as a way to indicate that the node has not been proved
  // reachable from s yet
@@ -403,6 +442,8 @@ void ThermalUnitDPSolver::build_graph( void )
 
 void ThermalUnitDPSolver::compute_EDPs( void )
 {
+ UCBLOCK_TRACE_SPAN( "ThermalUnitDPSolver::compute_EDPs" );
+
  if( stage < graph_OK )
   throw( std::logic_error(
    "ThermalUnitDPSolver::compute_EDPs: graph not ready." ) );
@@ -460,6 +501,8 @@ void ThermalUnitDPSolver::compute_EDPs( void )
 
 void ThermalUnitDPSolver::min_path( void )
 {
+ UCBLOCK_TRACE_SPAN( "ThermalUnitDPSolver::min_path" );
+
  if( stage < edps_OK )
   throw( std::logic_error(
    "ThermalUnitDPSolver::min_path: graph and/or EDPs not ready." ) );
@@ -493,6 +536,8 @@ void ThermalUnitDPSolver::min_path( void )
 
 void ThermalUnitDPSolver::compute_solutions( void )
 {
+ UCBLOCK_TRACE_SPAN( "ThermalUnitDPSolver::compute_solutions" );
+
  if( stage < edps_OK )
   throw( std::logic_error(
    "ThermalUnitDPSolver::compute_solutions: graph and/or path not ready." ) );
@@ -619,6 +664,8 @@ void ThermalUnitDPSolver::load_parameters( void )
 
 void ThermalUnitDPSolver::process_modifications( void )
 {
+ UCBLOCK_TRACE_SPAN( "ThermalUnitDPSolver::process_modifications" );
+
  bool reload = false;
 
  // note: since processing the Modification is fast, we don't bother with
@@ -661,8 +708,12 @@ bool ThermalUnitDPSolver::guts_of_process_modifications( const p_Mod mod )
   return( reload );
   }
 
- // ThermalUnitBlockMod
- if( const auto tubm = dynamic_cast< ThermalUnitBlockMod * >( mod ) ) {
+ // ThermalUnitBlockMod: told apart from the other UnitBlockMod by its
+ // family, rather than by a further dynamic_cast
+ const auto ubm = dynamic_cast< UnitBlockMod * >( mod );
+ if( ubm &&
+     ( ubm->family() == UnitBlockMod::eThermalUnitBlockModFamily ) ) {
+   const auto tubm = static_cast< ThermalUnitBlockMod * >( ubm );
    auto b = static_cast< ThermalUnitBlock * >( f_Block );
 
    switch( tubm->type() ) {
@@ -763,34 +814,35 @@ ThermalUnitDPSolver::DPEDSolver::DPEDSolver( Index h ,
  #if( COMPUTE_DUALS )
   Index coeffsize = time_horizon * time_horizon +f_h * f_h -
                     2 * f_h * time_horizon;
- #else
-  // Index coeffsize = 4 * ( time_horizon - f_h + 1 );
-  // the theory says it should work, but it does not
-  Index coeffsize = 4 * time_horizon;
- #endif
- if( coeffsize != coeffs.size() ) {
   coeffs.resize( coeffsize );
-  #if( COMPUTE_DUALS )
-   m.resize( coeffsize + time_horizon - f_h );
-   v.resize( time_horizon );
-   pos.resize( time_horizon );
-  #else
+  m.resize( coeffsize + time_horizon - f_h );
+  v.resize( time_horizon );
+  pos.resize( time_horizon );
+ #else
+  // with a fixed horizon coeffs[] and m[] live on the stack of
+  // compute_costs(), see compute_costs_fixed(), and are left empty here
+  if( ! ( get_fixed_horizon_kernels() && is_fixed_horizon( time_horizon ) ) ) {
+   // Index coeffsize = 4 * ( time_horizon - f_h + 1 );
+   // the theory says it should work, but it does not
+   Index coeffsize = 4 * time_horizon;
+   coeffs.resize( coeffsize );
    m.resize( coeffsize + 2 );
-   v.resize( 2 );
-   pos.resize( 2 );
-  #endif
-  unc_p.resize( time_horizon );
-  con_p.resize( time_horizon );
-  }
+   }
+  v.resize( 2 );
+  pos.resize( 2 );
+ #endif
+ unc_p.resize( time_horizon );
+ con_p.resize( time_horizon );
  }
 
 /*--------------------------------------------------------------------------*/
 
-void ThermalUnitDPSolver::DPEDSolver::compute_costs(
- std::vector< double > & costs )
+template< ThermalUnitDPSolver::Index T >
+void ThermalUnitDPSolver::DPEDSolver::compute_costs_T(
+ std::vector< double > & costs , coeff_t * cf , double * mp )
 {
- // scalar values
- auto time_horizon = f_solver->time_horizon;
+ // scalar values; with T > 0 the time horizon is a compile-time constant
+ const Index time_horizon = T ? T : f_solver->time_horizon;
  auto init_up_down_time = f_solver->init_up_down_time;
  auto initial_power = f_solver->initial_power;
 
@@ -808,9 +860,9 @@ void ThermalUnitDPSolver::DPEDSolver::compute_costs(
 
  Index k = f_h;
 
- coeffs[ 0 ].alfa = quad_term[ k ];
- coeffs[ 0 ].beta = linear_term[ k ];
- coeffs[ 0 ].gamma = 0;
+ cf[ 0 ].alfa = quad_term[ k ];
+ cf[ 0 ].beta = linear_term[ k ];
+ cf[ 0 ].gamma = 0;
 
  /* Initialize the vector m containing the endpoints of the pieces.
   * At first, it contains the two endpoints of the individual piece.
@@ -820,12 +872,12 @@ void ThermalUnitDPSolver::DPEDSolver::compute_costs(
   * to take it into account. */
 
  if( ( f_h == 0 ) && ( init_up_down_time > 0 ) ) {
-  m[ 0 ] = std::max( min_power[ k ] , initial_power - delta_ramp_down[ k ] );
-  m[ 1 ] = std::min( max_power[ k ] , initial_power + delta_ramp_up[ k ] );
+  mp[ 0 ] = std::max( min_power[ k ] , initial_power - delta_ramp_down[ k ] );
+  mp[ 1 ] = std::min( max_power[ k ] , initial_power + delta_ramp_up[ k ] );
   }
  else {
-  m[ 0 ] = min_power[ k ];
-  m[ 1 ] = std::min( bound_on[ k ] , max_power[ k ] );  // \bar{l}_k
+  mp[ 0 ] = min_power[ k ];
+  mp[ 1 ] = std::min( bound_on[ k ] , max_power[ k ] );  // \bar{l}_k
   }
 
  #if ( COMPUTE_DUALS )
@@ -836,9 +888,9 @@ void ThermalUnitDPSolver::DPEDSolver::compute_costs(
   pos[ k ].begt = 0;
  #else
   Index coeffcnt = 2 * ( time_horizon - f_h );
-  // next free position in coeffs[]
+  // next free position in cf[]
   Index mcnt = 2 * ( time_horizon - f_h ) + 1;
-  // next free position in m[]
+  // next free position in mp[]
   Index nextk = 1;     // next free position in v[], pos[]
   // since there are only two positions, nextk ping-pongs between 1 and 0
 
@@ -850,12 +902,12 @@ void ThermalUnitDPSolver::DPEDSolver::compute_costs(
 
  // initialize the vector of unconstrained power values, i.e.,
  // power values are not constrained by bound_down[ k ]
- if( std::abs( coeffs[ 0 ].alfa ) <= 1e-16 )
-  unc_p[ k ] = ( coeffs[ 0 ].beta <= 0 ? m[ 1 ] : m[ 0 ] );
+ if( std::abs( cf[ 0 ].alfa ) <= 1e-16 )
+  unc_p[ k ] = ( cf[ 0 ].beta <= 0 ? mp[ 1 ] : mp[ 0 ] );
  else
-  unc_p[ k ] = std::min( m[ 1 ] ,
-			 std::max( m[ 0 ] ,
-				   -coeffs[ 0 ].beta / ( 2 * coeffs[ 0 ].alfa )
+  unc_p[ k ] = std::min( mp[ 1 ] ,
+			 std::max( mp[ 0 ] ,
+				   -cf[ 0 ].beta / ( 2 * cf[ 0 ].alfa )
 				   ) );
 
  /* Initialize the vector of constrained power values, that will be
@@ -867,8 +919,8 @@ void ThermalUnitDPSolver::DPEDSolver::compute_costs(
  else
   con_p[ k ] = unc_p[ k ];
 
- costs[ k ] = coeffs[ 0 ].alfa * con_p[ k ] * con_p[ k ] +
-              coeffs[ 0 ].beta * con_p[ k ];
+ costs[ k ] = cf[ 0 ].alfa * con_p[ k ] * con_p[ k ] +
+              cf[ 0 ].beta * con_p[ k ];
 
  // outermost loop - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
  //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -881,18 +933,18 @@ void ThermalUnitDPSolver::DPEDSolver::compute_costs(
    pos[ k ].begm = mcnt;
    pos[ k ].begt = coeffcnt;
 
-   m[ mcnt ] = std::max( min_power[ k ] ,
-			 m[ pos[ k - 1 ].begm ] - delta_ramp_down[ k - 1 ] );
+   mp[ mcnt ] = std::max( min_power[ k ] ,
+			 mp[ pos[ k - 1 ].begm ] - delta_ramp_down[ k - 1 ] );
   #else
    pos[ nextk ].begm = mcnt;
    pos[ nextk ].begt = coeffcnt;
 
-   m[ mcnt ] = std::max( min_power[ k ] ,
-			 m[ pos[ 1 - nextk ].begm ] - delta_ramp_down[ k - 1 ]
+   mp[ mcnt ] = std::max( min_power[ k ] ,
+			 mp[ pos[ 1 - nextk ].begm ] - delta_ramp_down[ k - 1 ]
 			 );
   #endif
 
-  double p_bar = m[ mcnt ];  // \bar{m}_0
+  double p_bar = mp[ mcnt ];  // \bar{m}_0
   Index v_bar = 0;           // after the case 3 will contain v[ k ]
 
   // compute q, the index of the piece where p^*(\bar{p}) belongs.
@@ -907,20 +959,20 @@ void ThermalUnitDPSolver::DPEDSolver::compute_costs(
   #if( COMPUTE_DUALS )
    Index qm = pos[ k - 1 ].begm;
 
-   while( ( pstar >= m[ qm + 1 ] ) && ( qm < pos[ k ].begm - 2 ) )
+   while( ( pstar >= mp[ qm + 1 ] ) && ( qm < pos[ k ].begm - 2 ) )
     ++qm;
 
    Index q = qm - pos[ k - 1 ].begm + pos[ k - 1 ].begt;
 
    // compute the last endpoint of the piece, \bar{u}
    double u_bar = std::min( max_power[ k ] ,
-			    m[ mcnt - 1 ] + delta_ramp_up[ k - 1 ] );
+			    mp[ mcnt - 1 ] + delta_ramp_up[ k - 1 ] );
   #else
    Index qm = pos[ 1 - nextk ].begm;
    /*!!
    Index poslim = pos[ 1 - nextk ].begm + ( v[ 1 - nextk ] + 1 ) + 1 - 2;
 
-   while( ( pstar >= m[ qm + 1 ] ) && ( qm < poslim ) )
+   while( ( pstar >= mp[ qm + 1 ] ) && ( qm < poslim ) )
     ++qm;
     !!*/
 
@@ -928,7 +980,7 @@ void ThermalUnitDPSolver::DPEDSolver::compute_costs(
        ( pos[ 1 - nextk ].begm > - v[ 1 - nextk ] ) ) {
     Index poslim = pos[ 1 - nextk ].begm + v[ 1 - nextk ];
 
-    while( ( pstar >= m[ qm + 1 ] ) && ( qm < poslim ) )
+    while( ( pstar >= mp[ qm + 1 ] ) && ( qm < poslim ) )
      ++qm;
     }
 
@@ -936,7 +988,7 @@ void ThermalUnitDPSolver::DPEDSolver::compute_costs(
 
    // compute the last endpoint of the piece, \bar{u}
    double u_bar = std::min( max_power[ k ] ,
-			    m[ pos[ 1 - nextk ].begm + v[ 1 - nextk ] + 1 ]
+			    mp[ pos[ 1 - nextk ].begm + v[ 1 - nextk ] + 1 ]
 			    + delta_ramp_up[ k - 1 ] );
   #endif
   ++mcnt;
@@ -948,21 +1000,21 @@ void ThermalUnitDPSolver::DPEDSolver::compute_costs(
   {
    // set coeffs fields to compute \bar{z}^{\bar{v}}(p)
 
-   coeffs[ coeffcnt ].alfa = quad_term[ k ] + coeffs[ q ].alfa;
-   coeffs[ coeffcnt ].beta = linear_term[ k ] + coeffs[ q ].beta +
-                             2 * delta_ramp_down[ k - 1 ] * coeffs[ q ].alfa;
-   coeffs[ coeffcnt ].gamma = coeffs[ q ].gamma +
-    coeffs[ q ].alfa * delta_ramp_down[ k - 1 ] * delta_ramp_down[ k - 1 ] +
-    coeffs[ q ].beta * delta_ramp_down[ k - 1 ];
+   cf[ coeffcnt ].alfa = quad_term[ k ] + cf[ q ].alfa;
+   cf[ coeffcnt ].beta = linear_term[ k ] + cf[ q ].beta +
+                             2 * delta_ramp_down[ k - 1 ] * cf[ q ].alfa;
+   cf[ coeffcnt ].gamma = cf[ q ].gamma +
+    cf[ q ].alfa * delta_ramp_down[ k - 1 ] * delta_ramp_down[ k - 1 ] +
+    cf[ q ].beta * delta_ramp_down[ k - 1 ];
 
    /* Compute the maximum value for \bar{p} such that:
     * - p^*_k(\bar{p}) stays in the q-th interval;
     * - unc_p stays out of the admissible range;
     * - \bar{p} stays admissible. */
 
-   if( m[ qm + 1 ] - delta_ramp_down[ k - 1 ] <
+   if( mp[ qm + 1 ] - delta_ramp_down[ k - 1 ] <
        unc_p[ k - 1 ] - delta_ramp_down[ k - 1 ] - f_solver->eps ) {
-    p_bar = m[ qm + 1 ] - delta_ramp_down[ k - 1 ];
+    p_bar = mp[ qm + 1 ] - delta_ramp_down[ k - 1 ];
     ++q;
     ++qm;
     }
@@ -973,20 +1025,20 @@ void ThermalUnitDPSolver::DPEDSolver::compute_costs(
     p_bar = u_bar;
 
    ++v_bar;
-   m[ mcnt++ ] = p_bar;
+   mp[ mcnt++ ] = p_bar;
 
    // compute unc_p, unconstrained optimal value for z_{hk}
 
    if( firstTime &&
-       ( 2 * coeffs[ coeffcnt ].alfa * p_bar + coeffs[ coeffcnt ].beta > 0 ) ) {
-    if( std::abs( coeffs[ coeffcnt ].alfa ) <= 1e-16 ) {
-     if( coeffs[ coeffcnt ].beta >= 0 )
-      unc_p[ k ] = m[ mcnt - 2 ];
+       ( 2 * cf[ coeffcnt ].alfa * p_bar + cf[ coeffcnt ].beta > 0 ) ) {
+    if( std::abs( cf[ coeffcnt ].alfa ) <= 1e-16 ) {
+     if( cf[ coeffcnt ].beta >= 0 )
+      unc_p[ k ] = mp[ mcnt - 2 ];
      // else do nothing, the function is still decreasing in the next interval
      }
     else
-     unc_p[ k ] = std::max( m[ mcnt - 2 ] ,
-	        - coeffs[ coeffcnt ].beta / ( 2 * coeffs[ coeffcnt ].alfa ) );
+     unc_p[ k ] = std::max( mp[ mcnt - 2 ] ,
+	        - cf[ coeffcnt ].beta / ( 2 * cf[ coeffcnt ].alfa ) );
     firstTime = false;
     }
 
@@ -999,11 +1051,11 @@ void ThermalUnitDPSolver::DPEDSolver::compute_costs(
 
    // set coeffs fields to compute \bar{z}^{\bar{v}}(p)
 
-   coeffs[ coeffcnt ].alfa = quad_term[ k ];
-   coeffs[ coeffcnt ].beta = linear_term[ k ];
-   coeffs[ coeffcnt ].gamma =
-    coeffs[ q ].alfa * unc_p[ k - 1 ] * unc_p[ k - 1 ] +
-    coeffs[ q ].beta * unc_p[ k - 1 ] + coeffs[ q ].gamma;
+   cf[ coeffcnt ].alfa = quad_term[ k ];
+   cf[ coeffcnt ].beta = linear_term[ k ];
+   cf[ coeffcnt ].gamma =
+    cf[ q ].alfa * unc_p[ k - 1 ] * unc_p[ k - 1 ] +
+    cf[ q ].beta * unc_p[ k - 1 ] + cf[ q ].gamma;
 
    /* compute the maximum value for \bar{p} such that:
     * - unc_p stays out of the admissible range;
@@ -1012,18 +1064,18 @@ void ThermalUnitDPSolver::DPEDSolver::compute_costs(
    p_bar = std::min( u_bar , unc_p[ k - 1 ] + delta_ramp_up[ k - 1 ] );
 
    ++v_bar;
-   m[ mcnt++ ] = p_bar;
+   mp[ mcnt++ ] = p_bar;
 
    if( firstTime &&
-       ( 2 * coeffs[ coeffcnt ].alfa * p_bar + coeffs[ coeffcnt ].beta > 0 ) ) {
-    if( std::abs( coeffs[ coeffcnt ].alfa ) <= 1e-16 ) {
-     if( coeffs[ coeffcnt ].beta >= 0 )
-      unc_p[ k ] = m[ mcnt - 2 ];
+       ( 2 * cf[ coeffcnt ].alfa * p_bar + cf[ coeffcnt ].beta > 0 ) ) {
+    if( std::abs( cf[ coeffcnt ].alfa ) <= 1e-16 ) {
+     if( cf[ coeffcnt ].beta >= 0 )
+      unc_p[ k ] = mp[ mcnt - 2 ];
      // else do nothing, the function is still decreasing in the next interval
      }
     else
-     unc_p[ k ] = std::max( m[ mcnt - 2 ] ,
-		- coeffs[ coeffcnt ].beta / ( 2 * coeffs[ coeffcnt ].alfa ) );
+     unc_p[ k ] = std::max( mp[ mcnt - 2 ] ,
+		- cf[ coeffcnt ].beta / ( 2 * cf[ coeffcnt ].alfa ) );
     firstTime = false;
     }
 
@@ -1035,34 +1087,34 @@ void ThermalUnitDPSolver::DPEDSolver::compute_costs(
   while( p_bar < u_bar ) {
    // set coeffs fields to compute \bar{z}^{\bar{v}}(p)
 
-   coeffs[ coeffcnt ].alfa = quad_term[ k ] + coeffs[ q ].alfa;
-   coeffs[ coeffcnt ].beta = linear_term[ k ] + coeffs[ q ].beta -
-                              2 * delta_ramp_up[ k - 1 ] * coeffs[ q ].alfa;
-   coeffs[ coeffcnt ].gamma = coeffs[ q ].gamma +
-    coeffs[ q ].alfa * delta_ramp_up[ k - 1 ] * delta_ramp_up[ k - 1 ] -
-    coeffs[ q ].beta * delta_ramp_up[ k - 1 ];
+   cf[ coeffcnt ].alfa = quad_term[ k ] + cf[ q ].alfa;
+   cf[ coeffcnt ].beta = linear_term[ k ] + cf[ q ].beta -
+                              2 * delta_ramp_up[ k - 1 ] * cf[ q ].alfa;
+   cf[ coeffcnt ].gamma = cf[ q ].gamma +
+    cf[ q ].alfa * delta_ramp_up[ k - 1 ] * delta_ramp_up[ k - 1 ] -
+    cf[ q ].beta * delta_ramp_up[ k - 1 ];
 
    /* Compute the maximum value for \bar{p} such that:
     * - p^*_k(\bar{p}) stays in the q-th interval;
     * - \bar{p} stays admissible. */
 
-   p_bar = std::min( m[ qm + 1 ] + delta_ramp_up[ k - 1 ] , u_bar );
+   p_bar = std::min( mp[ qm + 1 ] + delta_ramp_up[ k - 1 ] , u_bar );
 
    ++v_bar;
-   m[ mcnt++ ] = p_bar;
+   mp[ mcnt++ ] = p_bar;
    ++q;
    ++qm;
 
    if( firstTime &&
-       ( 2 * coeffs[ coeffcnt ].alfa * p_bar + coeffs[ coeffcnt ].beta > 0 ) ) {
-    if( std::abs( coeffs[ coeffcnt ].alfa ) <= 1e-16 ) {
-     if( coeffs[ coeffcnt ].beta >= 0 )
-      unc_p[ k ] = m[ mcnt - 2 ];
+       ( 2 * cf[ coeffcnt ].alfa * p_bar + cf[ coeffcnt ].beta > 0 ) ) {
+    if( std::abs( cf[ coeffcnt ].alfa ) <= 1e-16 ) {
+     if( cf[ coeffcnt ].beta >= 0 )
+      unc_p[ k ] = mp[ mcnt - 2 ];
      // else do nothing, the function is still decreasing in the next interval
      }
     else
-     unc_p[ k ] = std::max( m[ mcnt - 2 ] ,
-		- coeffs[ coeffcnt ].beta / ( 2 * coeffs[ coeffcnt ].alfa ) );
+     unc_p[ k ] = std::max( mp[ mcnt - 2 ] ,
+		- cf[ coeffcnt ].beta / ( 2 * cf[ coeffcnt ].alfa ) );
     firstTime = false;
     }
 
@@ -1102,8 +1154,8 @@ void ThermalUnitDPSolver::DPEDSolver::compute_costs(
     qm = pos[ nextk ].begm;
   #endif
 
-  //?? while( ( con_p[ k ] > m[ qm + 1 ] ) && ( m[ qm + 1 ] != 0 ) )
-  while( con_p[ k ] > m[ qm + 1 ] )
+  //?? while( ( con_p[ k ] > mp[ qm + 1 ] ) && ( mp[ qm + 1 ] != 0 ) )
+  while( con_p[ k ] > mp[ qm + 1 ] )
    ++qm;
 
   #if( COMPUTE_DUALS )
@@ -1115,10 +1167,47 @@ void ThermalUnitDPSolver::DPEDSolver::compute_costs(
    mcnt     = nextk * ( ( 2 * time_horizon - f_h ) + 1 );
   #endif
 
-  costs[ k ] = coeffs[ q ].alfa * con_p[ k ] * con_p[ k ] +
-               coeffs[ q ].beta * con_p[ k ] + coeffs[ q ].gamma;
+  costs[ k ] = cf[ q ].alfa * con_p[ k ] * con_p[ k ] +
+               cf[ q ].beta * con_p[ k ] + cf[ q ].gamma;
 
   }  // end( for( k ) )
+ }  // end( ThermalUnitDPSolver::compute_costs_T )
+
+/*--------------------------------------------------------------------------*/
+
+template< ThermalUnitDPSolver::Index T >
+void ThermalUnitDPSolver::DPEDSolver::compute_costs_fixed(
+ std::vector< double > & costs )
+{
+ // the same sizes as those of coeffs[] and m[] in DPEDSolver()
+ std::array< coeff_t , 4 * T > cf;
+ std::array< double , 4 * T + 2 > mp;
+
+ compute_costs_T< T >( costs , cf.data() , mp.data() );
+ }
+
+/*--------------------------------------------------------------------------*/
+
+void ThermalUnitDPSolver::DPEDSolver::compute_costs(
+ std::vector< double > & costs )
+{
+ if( ! coeffs.empty() ) {  // the generic code, see DPEDSolver()
+  compute_costs_T< 0 >( costs , coeffs.data() , m.data() );
+  return;
+  }
+
+ #if( ! COMPUTE_DUALS )
+  switch( f_solver->time_horizon ) {
+   case( 24 ):  compute_costs_fixed< 24 >( costs );  return;
+   case( 48 ):  compute_costs_fixed< 48 >( costs );  return;
+   case( 96 ):  compute_costs_fixed< 96 >( costs );  return;
+   case( 168 ): compute_costs_fixed< 168 >( costs ); return;
+   }
+ #endif
+
+ throw( std::logic_error(
+  "ThermalUnitDPSolver::DPEDSolver::compute_costs: no work arrays" ) );
+
  }  // end( ThermalUnitDPSolver::compute_costs )
 
 /*--------------------------------------------------------------------------*/
@@ -1155,6 +1244,17 @@ void ThermalUnitDPSolver::DPEDSolver::compute_power_variables( Index k ,
   }
  }  // end( ThermalUnitDPSolver::compute_power_variables )
 
+/*--------------------------------------------------------------------------*/
+
+std::size_t ThermalUnitDPSolver::DPEDSolver::get_memory_usage( void ) const
+{
+ return( coeffs.capacity() * sizeof( coeff_t ) +
+         pos.capacity() * sizeof( pos_t ) +
+         ( unc_p.capacity() + con_p.capacity() + m.capacity() ) *
+         sizeof( double ) + v.capacity() * sizeof( int ) );
+
+ }  // end( ThermalUnitDPSolver::DPEDSolver::get_memory_usage )
+
 /*--------------------------------------------------------------------------*/
 /*----------------- End File ThermalUnitDPSolver.cpp -----------------------*/
 /*--------------------------------------------------------------------------*/
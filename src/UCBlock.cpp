@@ -37,14 +37,58 @@
 // TODO commented away until HeatBlock are properly managed
 // #include "HeatBlock.h"
 
+#include "BatteryUnitBlock.h"
+
 #include "BlockInspection.h"
 
+#include "DCNetworkBlock.h"
+
+#include "ECNetworkBlock.h"
+
+#include "HydroSystemUnitBlock.h"
+
+#include "HydroUnitBlock.h"
+
+#include "IntermittentUnitBlock.h"
+
 #include "LinearFunction.h"
 
+#include "NewLinearFunction.h"
+
 #include "Objective.h"
 
+#include "SlackUnitBlock.h"
+
+#include "ThermalUnitBlock.h"
+
 #include "UCBlock.h"
 
+#include "UCTrace.h"
+
+#include <netcdf.h>
+
+#include <algorithm>
+
+#include <atomic>
+
+#include <cmath>
+
+#include <cstdlib>
+
+#include <limits>
+
+#include <memory>
+
+#include <mutex>
+
+#include <thread>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+ #include <sys/wait.h>
+ #include <unistd.h>
+ #define UCBLOCK_SERIALIZE_PROCESSES 1  // fork() is available
+#endif
+
 /*--------------------------------------------------------------------------*/
 /*------------------------- NAMESPACE AND USING ----------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -59,6 +103,63 @@ using namespace SMSpp_di_unipi_it;
 
 SMSpp_insert_in_factory_cpp_1( UCBlock );
 
+bool UCBlock::f_trust_validated = true;
+
+// the netCDF library is not thread-safe: the scratch in-memory netCDF files
+// used by UCBlock (see create_nc_scratch()) are only handled while holding
+// this mutex, which is recursive so that their uses can nest (e.g., a
+// UCBlock serialized through a scratch inside that of another Block)
+
+static std::recursive_mutex nc_scratch_mutex;
+
+// creates a scratch in-memory netCDF-4 file with a name that is unique in
+// the process, so that the nested ones do not clash; nc_scratch_mutex must
+// be held until it is closed
+
+static int create_nc_scratch( int & ncid )
+{
+ static unsigned long counter = 0;
+ const auto name = "UCBlock_scratch_" + std::to_string( counter++ ) + ".nc4";
+ return( nc_create( name.c_str() , NC_NETCDF4 | NC_DISKLESS , & ncid ) );
+}
+
+// the per-generator Variable saved by UCBlock::serialize_solution(), with
+// the name of the corresponding netCDF variable
+
+using UnitVarGetter = ColVariable * ( UnitBlock::* )( Index );
+
+static const std::vector< std::pair< std::string , UnitVarGetter > >
+ solution_generator_vars = {
+  { "Commitment" , & UnitBlock::get_commitment } ,
+  { "ActivePower" , & UnitBlock::get_active_power } ,
+  { "PrimaryReserve" , & UnitBlock::get_primary_spinning_reserve } ,
+  { "SecondaryReserve" , & UnitBlock::get_secondary_spinning_reserve } };
+
+// the variables of each type of UnitBlock that can be changed by a delta
+// (see UCBlock::apply_delta()), each with the extent of its base array:
+// a scalar, a time profile (possibly given as a single value expanded to
+// the whole TimeHorizon) or one time profile per reservoir
+
+enum DeltaSize { eDeltaScalar , eDeltaProfile , eDeltaReservoirs };
+
+using DeltaVars = std::vector< std::pair< std::string , DeltaSize > >;
+
+static const DeltaVars thermal_delta_vars = {
+ { "MaxPower" , eDeltaProfile } , { "Availability" , eDeltaProfile } ,
+ { "LinearTerm" , eDeltaProfile } , { "QuadTerm" , eDeltaProfile } ,
+ { "ConstTerm" , eDeltaProfile } , { "StartUpCost" , eDeltaProfile } ,
+ { "InitialPower" , eDeltaScalar } };
+
+static const std::map< std::string , DeltaVars > delta_unit_vars = {
+ { "ThermalUnitBlock" , thermal_delta_vars } ,
+ { "NuclearUnitBlock" , thermal_delta_vars } ,
+ { "IntermittentUnitBlock" , { { "MaxPower" , eDeltaProfile } ,
+                               { "Kappa" , eDeltaScalar } } } ,
+ { "HydroUnitBlock" , { { "Inflows" , eDeltaReservoirs } } } ,
+ { "BatteryUnitBlock" , { { "InitialStorage" , eDeltaScalar } ,
+                          { "InitialPower" , eDeltaScalar } ,
+                          { "Kappa" , eDeltaScalar } } } };
+
 /*--------------------------------------------------------------------------*/
 /*--------------------------- METHODS OF UCBlock ---------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -93,7 +194,9 @@ void UCBlock::deserialize_sub_blocks( const netCDF::NcGroup & group ,
  v_Block.resize( sz + num_sub_blocks );
  for( Index i = 0 ; i < num_sub_blocks ; ++i ) {
   std::string sub_group_name = prefix + std::to_string( i );
-  auto sub_group = group.getGroup( sub_group_name );
+  auto it = f_nc_sub_groups.find( sub_group_name );
+  auto sub_group = ( it != f_nc_sub_groups.end() ) ? it->second :
+                   group.getGroup( sub_group_name );
   if( sub_group.isNull() )
    throw( std::invalid_argument( "UCBlock::deserialize: " +
                                  sub_group_name + " not present" ) );
@@ -115,7 +218,9 @@ void UCBlock::deserialize_network_blocks( const netCDF::NcGroup & group )
 
  for( Index i = 0 ; i < f_number_networks ; ++i ) {
   std::string sub_group_name = "NetworkBlock_" + std::to_string( i );
-  auto sub_group = group.getGroup( sub_group_name );
+  auto it = f_nc_sub_groups.find( sub_group_name );
+  auto sub_group = ( it != f_nc_sub_groups.end() ) ? it->second :
+                   group.getGroup( sub_group_name );
   if( sub_group.isNull() )
    continue;
 
@@ -147,6 +252,19 @@ void UCBlock::deserialize_network_blocks( const netCDF::NcGroup & group )
 
 void UCBlock::deserialize( const netCDF::NcGroup & group )
 {
+ UCBLOCK_TRACE_SPAN( "UCBlock::deserialize" );
+
+ // the checks on the data are skipped if the group has been validated
+ // and its structure has not been changed since then (this only reads the
+ // metadata of the group, see data_checksum())
+ f_validated = false;
+ if( f_trust_validated )
+  if( auto att = group.getAtt( "Validated" ) ; ( ! att.isNull() ) &&
+      ( att.getType().getTypeClass() == netCDF::NcType::nc_UINT64 ) ) {
+   unsigned long long checksum = 0;
+   att.getValues( & checksum );
+   f_validated = ( checksum == data_checksum( group ) );
+  }
 
 #ifndef NDEBUG
  static std::vector< std::string > expected_dims = { "TimeHorizon" ,
@@ -162,7 +280,8 @@ void UCBlock::deserialize( const netCDF::NcGroup & group )
                                                      "NumberElectricalGenerators" ,
                                                      "TotalNumberPollutantZones" ,
                                                      "NumberIntervals" };
- check_dimensions( group , expected_dims , std::cerr );
+ if( ! f_validated )
+  check_dimensions( group , expected_dims , std::cerr );
 
  static std::vector< std::string > expected_vars = { "ActivePowerDemand" ,
                                                      "GeneratorNode" ,
@@ -193,7 +312,8 @@ void UCBlock::deserialize( const netCDF::NcGroup & group )
                                                      "SellPrice" ,
                                                      "RewardPrice" ,
                                                      "PeakTariff" };
- check_variables( group , expected_vars , std::cerr );
+ if( ! f_validated )
+  check_variables( group , expected_vars , std::cerr );
 #endif
 
  // Mandatory variables
@@ -566,8 +686,436 @@ void UCBlock::deserialize( const netCDF::NcGroup & group )
 
 /*--------------------------------------------------------------------------*/
 
+void UCBlock::deserialize( const netCDF::NcGroup & group ,
+                           const NcSelection & selection )
+{
+ UCBLOCK_TRACE_SPAN( "UCBlock::deserialize(selection)" );
+
+ auto time_dim = group.getDim( "TimeHorizon" );
+ auto units_dim = group.getDim( "NumberUnits" );
+ if( time_dim.isNull() || units_dim.isNull() )
+  throw( std::invalid_argument( "UCBlock::deserialize: TimeHorizon or "
+                                "NumberUnits not present" ) );
+
+ const Index time_horizon = time_dim.getSize();
+ const Index t0 = selection.t0;
+ const Index t1 = std::min( selection.t1 , time_horizon );
+ if( t0 >= t1 )
+  throw( std::invalid_argument( "UCBlock::deserialize: empty time "
+                                "window" ) );
+
+ // the selected UnitBlock
+ const Index number_units = units_dim.getSize();
+ std::vector< netCDF::NcGroup > unit_groups( number_units );
+ std::vector< Index > units;
+ for( Index i = 0 ; i < number_units ; ++i ) {
+  std::string sub_group_name = "UnitBlock_" + std::to_string( i );
+  unit_groups[ i ] = group.getGroup( sub_group_name );
+  if( unit_groups[ i ].isNull() )
+   throw( std::invalid_argument( "UCBlock::deserialize: " +
+                                 sub_group_name + " not present" ) );
+
+  if( ( ! selection.units.empty() ) &&
+      ( std::find( selection.units.begin() , selection.units.end() , i ) ==
+        selection.units.end() ) )
+   continue;
+
+  if( ! selection.unit_types.empty() ) {
+   std::string type;
+   auto att = unit_groups[ i ].getAtt( "type" );
+   if( ! att.isNull() )
+    att.getValues( type );
+   if( std::find( selection.unit_types.begin() ,
+                  selection.unit_types.end() , type ) ==
+       selection.unit_types.end() )
+    continue;
+  }
+
+  units.push_back( i );
+ }
+
+ if( units.empty() )
+  throw( std::invalid_argument( "UCBlock::deserialize: no UnitBlock "
+                                "selected" ) );
+
+ // the initial conditions in the file hold before 0, not before t0
+ if( ( t0 > 0 ) && ( ! selection.initial_at_t0 ) )
+  for( auto i : units ) {
+   auto name = initial_condition( unit_groups[ i ] );
+   if( ! name.empty() )
+    throw( std::invalid_argument( "UCBlock::deserialize: UnitBlock_" +
+                                  std::to_string( i ) + " has initial "
+                                  "condition " + name + ", which holds "
+                                  "before time 0 and not before t0 = " +
+                                  std::to_string( t0 ) + "; update the "
+                                  "file and set initial_at_t0" ) );
+  }
+
+ // the electrical generators of the selected UnitBlock; the generators of
+ // UnitBlock i are first_gen[ i ] ... first_gen[ i + 1 ] - 1, and those of
+ // the selected ones are the runs of consecutive generators in gen_runs
+ // (first generator, number of generators)
+ auto gen_dim = group.getDim( "NumberElectricalGenerators" );
+ auto gen_node = group.getVar( "GeneratorNode" );
+ auto rho = group.getVar( "PollutantRho" );
+ const bool has_generators = ( ! gen_dim.isNull() ) ||
+                             ( ! gen_node.isNull() ) || ( ! rho.isNull() );
+ std::size_t selected_generators = 0;
+ std::vector< std::pair< std::size_t , std::size_t > > gen_runs;
+ if( has_generators ) {
+  std::vector< Index > first_gen( number_units + 1 );
+  if( ( ! gen_dim.isNull() ) && ( gen_dim.getSize() == number_units ) )
+   std::iota( first_gen.begin() , first_gen.end() , 0 );
+  else {
+   first_gen[ 0 ] = 0;
+   for( Index i = 0 ; i < number_units ; ++i )
+    first_gen[ i + 1 ] = first_gen[ i ] +
+                         number_generators( unit_groups[ i ] );
+   if( ( ! gen_dim.isNull() ) &&
+       ( first_gen[ number_units ] != gen_dim.getSize() ) )
+    throw( std::invalid_argument( "UCBlock::deserialize: the UnitBlock have "
+                                  "a total of " +
+                                  std::to_string( first_gen[ number_units ] )
+                                  + " generators, but "
+                                  "NumberElectricalGenerators is " +
+                                  std::to_string( gen_dim.getSize() ) ) );
+  }
+
+  for( auto i : units ) {
+   const std::size_t count = first_gen[ i + 1 ] - first_gen[ i ];
+   if( ! count )
+    continue;
+   if( ( ! gen_runs.empty() ) && ( gen_runs.back().first +
+                                   gen_runs.back().second == first_gen[ i ] ) )
+    gen_runs.back().second += count;
+   else
+    gen_runs.emplace_back( first_gen[ i ] , count );
+   selected_generators += count;
+  }
+ }
+
+ // the networks spanning the window, which must not split any of them
+ auto networks_dim = group.getDim( "NumberNetworks" );
+ auto start_var = group.getVar( "StartNetworkIntervals" );
+ auto constant_var = group.getVar( "NetworkConstantTerms" );
+ const Index number_networks = networks_dim.isNull() ? time_horizon :
+                               networks_dim.getSize();
+ std::vector< Index > start( number_networks );
+ if( start_var.isNull() )
+  std::iota( start.begin() , start.end() , 0 );
+ else
+  start_var.getVar( start.data() );
+ start.push_back( time_horizon );
+
+ std::vector< Index > networks;
+ for( Index n = 0 ; n < number_networks ; ++n )
+  if( ( start[ n ] >= t0 ) && ( start[ n + 1 ] <= t1 ) )
+   networks.push_back( n );
+  else if( ( start[ n ] < t1 ) && ( start[ n + 1 ] > t0 ) )
+   throw( std::invalid_argument( "UCBlock::deserialize: the time window "
+                                 "splits NetworkBlock " +
+                                 std::to_string( n ) ) );
+
+ // copy the selected part of group into a scratch in-memory netCDF-4 file
+ std::lock_guard< std::recursive_mutex > lock( nc_scratch_mutex );
+ int ncid;
+ if( create_nc_scratch( ncid ) != NC_NOERR )
+  throw( std::runtime_error( "UCBlock::deserialize: cannot create the "
+                             "scratch netCDF file" ) );
+ try {
+  netCDF::NcGroup root( ncid );
+  const NcStorage storage;
+
+  copy_nc_items( group , root , storage , t0 , t1 ,
+                 { "NumberUnits" , "NumberElectricalGenerators" ,
+                   "GeneratorNode" , "PollutantRho" , "NumberNetworks" ,
+                   "StartNetworkIntervals" , "NetworkConstantTerms" } );
+
+  root.addDim( "NumberUnits" , units.size() );
+
+  if( has_generators ) {
+   auto new_gen_dim = root.addDim( "NumberElectricalGenerators" ,
+                                   selected_generators );
+
+   if( ! gen_node.isNull() ) {
+    // read the runs of generators one after the other
+    std::vector< Index > new_node( selected_generators );
+    std::size_t pos = 0;
+    for( const auto & [ first , count ] : gen_runs ) {
+     gen_node.getVar( { first } , { count } , new_node.data() + pos );
+     pos += count;
+    }
+    root.addVar( "GeneratorNode" , gen_node.getType() ,
+                 new_gen_dim ).putVar( new_node.data() );
+   }
+
+   if( ! rho.isNull() ) {
+    // read the window of each run of generators (the last dimension), and
+    // put it in its place among the selected ones
+    if( rho.getDimCount() != 3 )
+     throw( std::invalid_argument( "UCBlock::deserialize: PollutantRho "
+                                   "must have three dimensions" ) );
+    std::vector< netCDF::NcDim > dims;
+    std::vector< std::size_t > from( 3 , 0 );
+    std::vector< std::size_t > count( 3 );
+    for( Index i = 0 ; i < 3 ; ++i ) {
+     auto d = rho.getDim( i );
+     count[ i ] = d.getSize();
+     if( ( d.getName() == "TimeHorizon" ) && ( count[ i ] > 1 ) ) {
+      from[ i ] = t0;
+      count[ i ] = t1 - t0;
+     }
+     dims.push_back( i < 2 ? root.getDim( d.getName() ) : new_gen_dim );
+     if( dims.back().isNull() )
+      throw( std::invalid_argument( "UCBlock::deserialize: dimension " +
+                                    d.getName() + " not found" ) );
+    }
+
+    const std::size_t rows = count[ 0 ] * count[ 1 ];
+    std::vector< double > new_data( rows * selected_generators );
+    std::vector< double > data;
+    std::size_t pos = 0;
+    for( const auto & [ first , run ] : gen_runs ) {
+     from[ 2 ] = first;
+     count[ 2 ] = run;
+     data.resize( rows * run );
+     rho.getVar( from , count , data.data() );
+     for( std::size_t k = 0 ; k < rows ; ++k )
+      std::copy( data.begin() + k * run , data.begin() + ( k + 1 ) * run ,
+                 new_data.begin() + k * selected_generators + pos );
+     pos += run;
+    }
+
+    count[ 2 ] = selected_generators;
+    root.addVar( "PollutantRho" , netCDF::NcDouble() , dims ).putVar(
+     std::vector< std::size_t >( 3 , 0 ) , count , new_data.data() );
+   }
+  }
+
+  if( ! networks_dim.isNull() ) {
+   auto new_networks_dim = root.addDim( "NumberNetworks" , networks.size() );
+
+   if( ! start_var.isNull() ) {
+    std::vector< Index > new_start;
+    for( auto n : networks )
+     new_start.push_back( start[ n ] - t0 );
+    root.addVar( "StartNetworkIntervals" , netCDF::NcUint() ,
+                 new_networks_dim ).putVar( new_start.data() );
+   }
+
+   // the networks spanning the window are consecutive
+   if( ( ! constant_var.isNull() ) && ( ! networks.empty() ) ) {
+    std::vector< double > new_constant( networks.size() );
+    constant_var.getVar( { networks.front() } , { networks.size() } ,
+                         new_constant.data() );
+    root.addVar( "NetworkConstantTerms" , netCDF::NcDouble() ,
+                 new_networks_dim ).putVar( new_constant.data() );
+   }
+  }
+
+  // the sub-groups: the selected UnitBlock and NetworkBlock are renumbered;
+  // those that are kept whole are read in place out of group, the
+  // UnitBlock restricted to a proper window are copied, and anything else
+  // is copied as it is
+  const bool whole = ( t0 == 0 ) && ( t1 == time_horizon );
+  for( Index k = 0 ; k < units.size() ; ++k ) {
+   const auto name = "UnitBlock_" + std::to_string( k );
+   if( whole )
+    f_nc_sub_groups[ name ] = unit_groups[ units[ k ] ];
+   else {
+    auto sub_group = root.addGroup( name );
+    copy_nc_group( unit_groups[ units[ k ] ] , sub_group , storage ,
+                   t0 , t1 );
+   }
+  }
+
+  for( Index k = 0 ; k < networks.size() ; ++k ) {
+   auto network_group = group.getGroup( "NetworkBlock_" +
+                                        std::to_string( networks[ k ] ) );
+   if( ! network_group.isNull() )
+    f_nc_sub_groups[ "NetworkBlock_" + std::to_string( k ) ] = network_group;
+  }
+
+  for( const auto & [ name , sub_from ] : group.getGroups() )
+   if( ( name.rfind( "UnitBlock_" , 0 ) != 0 ) &&
+       ( name.rfind( "NetworkBlock_" , 0 ) != 0 ) ) {
+    auto sub_group = root.addGroup( name );
+    copy_nc_group( sub_from , sub_group , storage , t0 , t1 );
+   }
+
+  deserialize( root );
+ }
+ catch( ... ) {
+  f_nc_sub_groups.clear();
+  nc_close( ncid );
+  throw;
+ }
+ f_nc_sub_groups.clear();
+ nc_close( ncid );
+
+}  // end( UCBlock::deserialize( selection ) )
+
+/*--------------------------------------------------------------------------*/
+
+UCBlock::Index UCBlock::number_generators( const netCDF::NcGroup & group )
+{
+ if( auto dim = group.getDim( "NumberElectricalGenerators" ) ;
+     ! dim.isNull() )
+  return( dim.getSize() );
+
+ std::string type;
+ if( auto att = group.getAtt( "type" ) ; ! att.isNull() )
+  att.getValues( type );
+
+ if( type == "HydroSystemUnitBlock" ) {
+  Index number_hydro_units = 0;
+  ::deserialize_dim( group , "NumberHydroUnits" , number_hydro_units );
+  Index number = 0;
+  for( Index i = 0 ; i < number_hydro_units ; ++i ) {
+   auto sub_group = group.getGroup( "HydroUnitBlock_" + std::to_string( i ) );
+   if( sub_group.isNull() )
+    throw( std::invalid_argument( "UCBlock::number_generators: "
+                                  "HydroUnitBlock_" + std::to_string( i ) +
+                                  " not present" ) );
+   number += number_generators( sub_group );
+  }
+  return( number );
+ }
+
+ // see HydroUnitBlock::get_number_generators()
+ if( auto dim = group.getDim( "NumberArcs" ) ; ! dim.isNull() )
+  return( std::max( dim.getSize() , std::size_t( 1 ) ) );
+
+ return( 1 );
+
+}  // end( UCBlock::number_generators )
+
+/*--------------------------------------------------------------------------*/
+
+std::string UCBlock::initial_condition( const netCDF::NcGroup & group )
+{
+ for( const auto & [ name , var ] : group.getVars() )
+  if( name.rfind( "Init" , 0 ) == 0 )
+   return( name );
+
+ for( const auto & [ name , sub_group ] : group.getGroups() ) {
+  auto found = initial_condition( sub_group );
+  if( ! found.empty() )
+   return( name + "/" + found );
+ }
+
+ return( {} );
+
+}  // end( UCBlock::initial_condition )
+
+/*--------------------------------------------------------------------------*/
+
+std::uint64_t UCBlock::data_checksum( const netCDF::NcGroup & group ,
+                                      bool content )
+{
+ // 64-bit FNV-1a, fed with the names and the sizes of everything
+ std::uint64_t hash = 14695981039346656037ULL;
+ auto feed = [ & hash ]( const void * data , std::size_t size ) {
+  auto bytes = static_cast< const unsigned char * >( data );
+  for( std::size_t i = 0 ; i < size ; ++i ) {
+   hash ^= bytes[ i ];
+   hash *= 1099511628211ULL;
+   }
+  };
+ auto feed_size = [ & feed ]( std::uint64_t size ) {
+  feed( & size , sizeof( size ) );
+  };
+ auto feed_string = [ & feed , & feed_size ]( const std::string & str ) {
+  feed_size( str.size() );
+  feed( str.data() , str.size() );
+  };
+
+ // feed the count values of type out of getter( void * ), for all the
+ // types of the netCDF-4 data model
+ auto feed_values = [ & ]( const netCDF::NcType & type , std::size_t count ,
+                           auto getter ) {
+  feed_string( type.getName() );
+  if( ! count )
+   return;
+  switch( type.getTypeClass() ) {
+   case( netCDF::NcType::nc_STRING ): {
+    std::vector< char * > strings( count );
+    getter( strings.data() );
+    for( auto str : strings )
+     feed_string( str ? str : "" );
+    nc_free_string( count , strings.data() );
+    break;
+    }
+   case( netCDF::NcType::nc_VLEN ): {
+    // the values only hold pointers, it is what they point to that counts
+    const auto base = netCDF::NcVlenType( type ).getBaseType().getSize();
+    std::vector< nc_vlen_t > vlens( count );
+    getter( vlens.data() );
+    for( const auto & vlen : vlens ) {
+     feed_size( vlen.len );
+     feed( vlen.p , vlen.len * base );
+     }
+    nc_free_vlens( count , vlens.data() );
+    break;
+    }
+   default: {
+    std::vector< unsigned char > data( count * type.getSize() );
+    getter( data.data() );
+    feed( data.data() , data.size() );
+    }
+   }
+  };
+
+ // the attributes, but those written by the ucblock_validate tool
+ auto feed_atts = [ & ]( const auto & atts ) {
+  for( const auto & [ name , att ] : atts ) {
+   if( name.compare( 0 , 9 , "Validated" ) == 0 )
+    continue;
+   feed_string( name );
+   feed_values( att.getType() , att.getAttLength() ,
+                [ & att ]( void * data ) { att.getValues( data ); } );
+   }
+  };
+
+ // the std::multimap returned by netCDF are sorted by name, hence the
+ // checksum does not depend on the order of creation of the items
+ feed_atts( group.getAtts() );
+
+ for( const auto & [ name , dim ] : group.getDims() ) {
+  feed_string( name );
+  feed_size( dim.getSize() );
+  }
+
+ for( const auto & [ name , var ] : group.getVars() ) {
+  feed_string( name );
+  std::size_t count = 1;
+  for( const auto & dim : var.getDims() ) {
+   feed_string( dim.getName() );
+   count *= dim.getSize();
+   }
+  feed_atts( var.getAtts() );
+  if( content )
+   feed_values( var.getType() , count ,
+                [ & var ]( void * data ) { var.getVar( data ); } );
+  else
+   feed_string( var.getType().getName() );
+  }
+
+ for( const auto & [ name , sub ] : group.getGroups() ) {
+  feed_string( name );
+  feed_size( data_checksum( sub , content ) );
+  }
+
+ return( hash );
+
+}  // end( UCBlock::data_checksum )
+
+/*--------------------------------------------------------------------------*/
+
 void UCBlock::generate_abstract_constraints( Configuration * stcc )
 {
+ UCBLOCK_TRACE_SPAN( "UCBlock::generate_abstract_constraints" );
+
  if( constraints_generated() )  // constraints have already been generated
   return;                       // nothing to do
 
@@ -656,6 +1204,7 @@ void UCBlock::generate_node_injection_constraints( void )
 
    // Network needs GeneratorNode
 
+   LinearFunction::v_coeff_pair vars;
    Index t = 0;
    for( Index n = 0 ; n < f_number_networks ; ++n ) {
 
@@ -667,9 +1216,7 @@ void UCBlock::generate_node_injection_constraints( void )
 
      for( Index node_id = 0 ; node_id < number_nodes ; ++node_id ) {
 
-      auto lf = new LinearFunction();
-
-      lf->add_variable( &node_injection[ node_id ] , -1.0 , eNoMod );
+      vars.push_back( std::make_pair( &node_injection[ node_id ] , -1.0 ) );
 
       double rhs = 0.0;
 
@@ -687,22 +1234,21 @@ void UCBlock::generate_node_injection_constraints( void )
          continue;
 
         if( auto ap = unit_block->get_active_power( generator ) ) {
-         auto active_power = &ap[ t ];
-         lf->add_variable( active_power , scale , eNoMod );
+         vars.push_back( std::make_pair( &ap[ t ] , scale ) );
         }
 
         if( auto fc = unit_block->get_fixed_consumption( generator ) ) {
          if( auto c = unit_block->get_commitment( generator ) ) {
           auto fixed_consumption = fc[ t ] * scale;
-          auto commitment = &c[ t ];
-          lf->add_variable( commitment , -fixed_consumption , eNoMod );
+          vars.push_back( std::make_pair( &c[ t ] , -fixed_consumption ) );
           rhs -= fixed_consumption;
          }
         }
        }
       }
       v_node_injection_Const[ t ][ node_id ].set_both( rhs , eNoMod );
-      v_node_injection_Const[ t ][ node_id ].set_function( lf );
+      v_node_injection_Const[ t ][ node_id ].set_function(
+       new_LinearFunction( vars ) );
      }
     }
    }
@@ -902,108 +1448,103 @@ void UCBlock::generate_inertia_demand_constraints( void )
   boost::multi_array< FRowConstraint , 2 >::extent_gen()
   [ f_time_horizon ][ f_number_inertia_zones ] );
 
- // We assume that, if a generator has commitment variable, inertia
- // commitment, inertia power, or active power variable for some time instant,
- // then it has the same thing for all time instants.
- inertia_var_index.resize
-  ( boost::multi_array< Index , 2 >::
-    extent_gen()[ f_number_units ][ f_number_inertia_zones ] );
-
- std::fill( inertia_var_index.data() , inertia_var_index.data() +
-                                       inertia_var_index.num_elements() ,
-            Inf< Index >() );
-
- const auto number_nodes = get_number_nodes();
+ // Build the descriptor table of the terms of each zone, once and for all
+ // time instants: this is where the virtual methods of the UnitBlock are
+ // called, while all the T rows are then generated out of the table.
+ build_inertia_terms();
+
+ // For each term, the base of the vector of Variable, the base of the vector
+ // of coefficients, and the scale factor of the UnitBlock.
+ const auto num_terms = v_inertia_terms.size();
+ std::vector< ColVariable * > var( num_terms );
+ std::vector< const double * > coeff( num_terms );
+ std::vector< double > scale( num_terms );
+
+ for( Index i = 0 ; i < num_terms ; ++i ) {
+  const auto & term = v_inertia_terms[ i ];
+  const auto unit_block = get_unit_block( term.unit );
+  scale[ i ] = unit_block->get_scale();
+  if( term.power ) {
+   var[ i ] = unit_block->get_active_power( term.generator );
+   coeff[ i ] = unit_block->get_inertia_power( term.generator );
+  } else {
+   var[ i ] = unit_block->get_commitment( term.generator );
+   coeff[ i ] = unit_block->get_inertia_commitment( term.generator );
+  }
+ }
 
  for( Index t = 0 ; t < f_time_horizon ; ++t ) {
   for( Index zone_id = 0 ; zone_id < f_number_inertia_zones ; ++zone_id ) {
 
-   auto lf = new LinearFunction();
-
-   for( Index node_id = 0 ; node_id < number_nodes ; ++node_id ) {
-
-    if( ! node_belongs_to_inertia_zone( node_id , zone_id ) )
-     continue;
-
-    Index elc_generator = 0;
-    for( Index unit_id = 0 ; unit_id < f_number_units ; ++unit_id ) {
-
-     const auto unit_block = get_unit_block( unit_id );
-     const auto scale = unit_block->get_scale();
-
-     for( Index generator = 0 ;
-          generator < unit_block->get_number_generators() ;
-          ++generator , ++elc_generator ) {
-
-      if( ! generator_belongs_to_node( elc_generator , node_id ) )
-       continue;
+   const auto first = v_inertia_zone_start[ zone_id ];
+   const auto last = v_inertia_zone_start[ zone_id + 1 ];
 
-      auto commitment = unit_block->get_commitment( generator );
-      auto inertia_commitment = unit_block->get_inertia_commitment( generator );
+   LinearFunction::v_coeff_pair vars( last - first );
+   for( Index i = first ; i < last ; ++i )
+    vars[ i - first ] = std::make_pair( &var[ i ][ t ] ,
+                                        scale[ i ] * coeff[ i ][ t ] );
 
-      if( commitment && inertia_commitment ) {
+   const auto demand = get_inertia_demand()[ zone_id ][ t ];
+   v_InertiaDemand_Const[ t ][ zone_id ].set_lhs( demand );
+   v_InertiaDemand_Const[ t ][ zone_id ].set_rhs( Inf< double >() );
+   v_InertiaDemand_Const[ t ][ zone_id ].set_function(
+    new LinearFunction( std::move( vars ) ) );
 
-       // The term with the commitment variable will be added to the function.
+  }  // end( for( zone_id ) )
+ }  // end( for( t ) )
 
-       if( inertia_var_index[ unit_id ][ zone_id ] == Inf< Index >() ) {
-        // This is the first Variable of this unit to be added to the
-        // LinearFunction, so we store its index, which is given by the
-        // current number of active Variables of the LinearFunction (right
-        // before this Variable is added).
+ add_static_constraint( v_InertiaDemand_Const , "inertia_demand_c" );
 
-        // Since all time steps have the same structure, this must be the
-        // first time step.
-        assert( t == 0 );
+}  // end( UCBlock::generate_inertia_demand_constraints )
 
-        const auto num_active_var = lf->get_num_active_var();
-        inertia_var_index[ unit_id ][ zone_id ] = num_active_var;
-       }
+/*--------------------------------------------------------------------------*/
 
-       auto commitment_t = &commitment[ t ];
-       auto coefficient = scale * inertia_commitment[ t ];
-       lf->add_variable( commitment_t , coefficient );
-      }
+void UCBlock::build_inertia_terms( void )
+{
+ // The terms are first collected per zone and then concatenated. Within a
+ // zone, they are ordered by UnitBlock and generator, and for each generator
+ // the commitment term (if any) precedes the active power one (if any).
 
-      auto active_power = unit_block->get_active_power( generator );
-      auto inertia_power = unit_block->get_inertia_power( generator );
+ // Generators at nodes that belong to no zone have no term at all.
 
-      if( active_power && inertia_power ) {
-       // The term with the active power will be added to the function.
+ std::vector< std::vector< InertiaTerm > > zone_terms( f_number_inertia_zones );
 
-       if( inertia_var_index[ unit_id ][ zone_id ] == Inf< Index >() ) {
-        // This is the first Variable of this unit to be added to the
-        // LinearFunction, so we store its index, which is given by the
-        // current number of active Variables of the LinearFunction (right
-        // before this Variable is added).
+ Index elc_generator = 0;
+ for( Index unit_id = 0 ; unit_id < f_number_units ; ++unit_id ) {
+  const auto unit_block = get_unit_block( unit_id );
 
-        // Since all time steps have the same structure, this must be the
-        // first time step.
-        assert( t == 0 );
+  for( Index generator = 0 ;
+       generator < unit_block->get_number_generators() ;
+       ++generator , ++elc_generator ) {
 
-        const auto num_active_var = lf->get_num_active_var();
-        inertia_var_index[ unit_id ][ zone_id ] = num_active_var;
-       }
+   const auto zone = get_inertia_zone( elc_generator );
+   if( zone >= f_number_inertia_zones )
+    continue;
 
-       auto active_power_t = &active_power[ t ];
-       auto coefficient = scale * inertia_power[ t ];
-       lf->add_variable( active_power_t , coefficient );
-      }
+   auto & terms = zone_terms[ zone ];
 
-     }  // end( for( generator ) )
-    }  // end( for( unit_id ) )
-   }  // end( for( node_id ) )
+   if( unit_block->get_commitment( generator ) &&
+       unit_block->get_inertia_commitment( generator ) )
+    terms.push_back( { unit_id , generator , false } );
 
-   const auto demand = get_inertia_demand()[ zone_id ][ t ];
-   v_InertiaDemand_Const[ t ][ zone_id ].set_lhs( demand );
-   v_InertiaDemand_Const[ t ][ zone_id ].set_rhs( Inf< double >() );
-   v_InertiaDemand_Const[ t ][ zone_id ].set_function( lf );
+   if( unit_block->get_active_power( generator ) &&
+       unit_block->get_inertia_power( generator ) )
+    terms.push_back( { unit_id , generator , true } );
+  }
+ }
 
-  }  // end( for( zone_id ) )
- }  // end( for( t ) )
+ v_inertia_terms.clear();
+ v_inertia_zone_start.resize( f_number_inertia_zones + 1 );
 
- add_static_constraint( v_InertiaDemand_Const , "inertia_demand_c" );
+ for( Index zone_id = 0 ; zone_id < f_number_inertia_zones ; ++zone_id ) {
+  v_inertia_zone_start[ zone_id ] = v_inertia_terms.size();
+  v_inertia_terms.insert( v_inertia_terms.end() ,
+                          zone_terms[ zone_id ].begin() ,
+                          zone_terms[ zone_id ].end() );
+ }
+ v_inertia_zone_start[ f_number_inertia_zones ] = v_inertia_terms.size();
 
-}  // end( UCBlock::generate_inertia_demand_constraints )
+}  // end( UCBlock::build_inertia_terms )
 
 /*--------------------------------------------------------------------------*/
 
@@ -1084,7 +1625,7 @@ void UCBlock::generate_pollutant_budget_constraints( void )
        v_pollutant_budget[ v_number_pollutant_zones[ pollutant ] ][ pollutant ] );
       v_PollutantBudget_Const[ pollutant ][ zone ].set_lhs( -Inf< double >() );
       v_PollutantBudget_Const[ pollutant ][ zone ].set_function(
-       new LinearFunction( std::move( vars ) ) );
+       new_LinearFunction( vars ) );
      }
     }
    }
@@ -1170,7 +1711,7 @@ void UCBlock::generate_pollutant_budget_constraints( void )
        v_pollutant_budget[ v_number_pollutant_zones[ pollutant ] ][ pollutant ] );
       v_PollutantBudget_Const[ pollutant ][ zone ].set_lhs( -Inf< double >() );
       v_PollutantBudget_Const[ pollutant ][ zone ].set_function(
-       new LinearFunction( std::move( vars ) ) );
+       new_LinearFunction( vars ) );
      }
     }
    }
@@ -1274,7 +1815,7 @@ void UCBlock::generate_heat_constraints( void )
 /*------------ METHODS FOR LOADING, PRINTING & SAVING THE UCBlock ----------*/
 /*--------------------------------------------------------------------------*/
 
-void UCBlock::serialize( netCDF::NcGroup & group ) const
+void UCBlock::serialize_data( netCDF::NcGroup & group ) const
 {
  Block::serialize( group );
 
@@ -1392,6 +1933,14 @@ void UCBlock::serialize( netCDF::NcGroup & group ) const
  ::serialize( group , "GeneratorNode" , netCDF::NcUint() ,
               NumberElectricalGenerators , v_generator_node );
 
+}  // end( UCBlock::serialize_data )
+
+/*--------------------------------------------------------------------------*/
+
+void UCBlock::serialize( netCDF::NcGroup & group ) const
+{
+ serialize_data( group );
+
  // Serialize sub-blocks
 
  for( Index i = 0 ; i < f_number_units ; ++i ) {
@@ -1416,56 +1965,1870 @@ void UCBlock::serialize( netCDF::NcGroup & group ) const
 
 }  // end( UCBlock::serialize )
 
-/*--------------------------------------------------------------------------*/
-/*--------------- METHODS FOR READING THE DATA OF THE UCBlock --------------*/
 /*--------------------------------------------------------------------------*/
 
-int UCBlock::get_objective_sense( void ) const { return( Objective::eMin ); }
+void UCBlock::serialize( netCDF::NcGroup & group ,
+                         const NcStorage & storage ) const
+{
+ // serialize a piece of the UCBlock (by calling write) into a scratch
+ // in-memory netCDF-4 file and copy it into to; the root of the scratch file
+ // gets the dimensions currently visible from group, so that the piece can
+ // refer to them as it would do if it were serialized directly there
+
+ auto through_scratch = [ & group , & storage ]( auto write ,
+                                                 netCDF::NcGroup & to ) {
+  std::lock_guard< std::recursive_mutex > lock( nc_scratch_mutex );
+  int ncid;
+  if( create_nc_scratch( ncid ) != NC_NOERR )
+   throw( std::runtime_error( "UCBlock::serialize: cannot create the "
+                              "scratch netCDF file" ) );
+  try {
+   netCDF::NcGroup root( ncid );
+   for( const auto & [ name , dim ] :
+         group.getDims( netCDF::NcGroup::ParentsAndCurrent ) )
+    if( root.getDim( name ).isNull() )
+     root.addDim( name , dim.getSize() );
+
+   auto piece = root.addGroup( "piece" );
+   write( piece );
+   copy_nc_group( piece , to , storage );
+  }
+  catch( ... ) {
+   nc_close( ncid );
+   throw;
+  }
+  nc_close( ncid );
+ };
+
+ through_scratch( [ this ]( netCDF::NcGroup & g ) { serialize_data( g ); } ,
+                  group );
+
+ // the sub-Block, with the names of their groups, in the order in which
+ // they are written
+ std::vector< std::pair< const Block * , std::string > > pieces;
+ for( Index i = 0 ; i < f_number_units ; ++i )
+  pieces.emplace_back( get_unit_block( i ) ,
+                       "UnitBlock_" + std::to_string( i ) );
+ for( Index t = 0 ; t < f_time_horizon ; ++t )
+  if( auto sub_block = get_network_block( t ) )
+   pieces.emplace_back( sub_block , "NetworkBlock_" + std::to_string( t ) );
+
+#ifdef UCBLOCK_SERIALIZE_PROCESSES
+ if( ( storage.jobs > 1 ) && ( pieces.size() > 1 ) ) {
+  serialize_pieces( group , storage , pieces );
+  return;
+ }
+#endif
+
+ for( const auto & [ sub_block , name ] : pieces ) {
+  auto sub_group = group.addGroup( name );
+  through_scratch( [ sub_block = sub_block ]( netCDF::NcGroup & g ) {
+   sub_block->serialize( g );
+  } , sub_group );
+ }
+
+}  // end( UCBlock::serialize( storage ) )
 
-/*--------------------------------------------------------------------------*/
-/*------------------------ METHODS FOR CHANGING DATA -----------------------*/
 /*--------------------------------------------------------------------------*/
 
-void UCBlock::add_Modification( sp_Mod mod , ChnlName chnl )
+void UCBlock::serialize_pieces( netCDF::NcGroup & group ,
+                                const NcStorage & storage ,
+                                const std::vector< std::pair< const Block * ,
+                                std::string > > & pieces )
 {
- std::vector< Index > modified_units;
-
- // TODO Handle GroupModification in order to deal with multiple UnitBlockMod
- // at the same time.
+#ifdef UCBLOCK_SERIALIZE_PROCESSES
+ const std::string fn = "UCBlock::serialize";
+
+ // the dimensions visible from group, which the pieces may refer to, as
+ // they are given to the scratch files of the serial path
+ std::vector< std::pair< std::string , std::size_t > > dims;
+ for( const auto & [ name , dim ] :
+       group.getDims( netCDF::NcGroup::ParentsAndCurrent ) )
+  if( std::none_of( dims.begin() , dims.end() ,
+                    [ & name = name ]( const auto & d ) {
+                     return( d.first == name ); } ) )
+   dims.emplace_back( name , dim.getSize() );
+
+ // one temporary file per process, piece i going to file i % jobs
+ const std::size_t jobs = std::min< std::size_t >( storage.jobs ,
+                                                   pieces.size() );
+ const char * tmp_dir = std::getenv( "TMPDIR" );
+ std::vector< std::string > files;
+ auto remove_files = [ & files ]() {
+  for( const auto & file : files )
+   unlink( file.c_str() );
+ };
 
- if( const auto tmod = dynamic_cast< UnitBlockMod * >( mod.get() ) ) {
-  if( tmod->type() == UnitBlockMod::eScale ) {
-   auto unit_id = inspection::get_block_index( tmod->get_Block() );
-   modified_units.push_back( unit_id );
+ for( std::size_t j = 0 ; j < jobs ; ++j ) {
+  std::string file = std::string( tmp_dir ? tmp_dir : "/tmp" ) +
+                     "/UCBlock_XXXXXX";
+  const int fd = mkstemp( file.data() );
+  if( fd < 0 ) {
+   remove_files();
+   throw( std::runtime_error( fn + ": cannot create a temporary file" ) );
   }
+  close( fd );
+  files.push_back( file );
  }
 
- if( ! modified_units.empty() ) {
-  // Sort the IDs of the modified units
-  std::sort( modified_units.begin() , modified_units.end() );
+ // each child process serializes its pieces into its file, and leaves by
+ // _exit() so as not to run the atexit() handlers of netCDF and HDF5,
+ // which would touch the files that the parent has open
+ std::vector< pid_t > pids;
+ bool failed = false;
+ for( std::size_t j = 0 ; j < jobs ; ++j ) {
+  const pid_t pid = fork();
+  if( pid == 0 ) {
+   int status = 0;
+   try {
+    netCDF::NcFile f( files[ j ] , netCDF::NcFile::replace ,
+                      netCDF::NcFile::nc4 );
+    for( const auto & [ name , size ] : dims )
+     f.addDim( name , size );
+    for( std::size_t i = j ; i < pieces.size() ; i += jobs ) {
+     auto piece = f.addGroup( "piece_" + std::to_string( i ) );
+     pieces[ i ].first->serialize( piece );
+    }
+   } catch( ... ) {
+    status = 1;
+   }
+   _exit( status );
+  }
+  if( pid < 0 ) {
+   failed = true;
+   break;
+  }
+  pids.push_back( pid );
+ }
 
-  update_node_injection_constraints( modified_units );
-  update_primary_demand_constraints( modified_units );
-  update_secondary_demand_constraints( modified_units );
-  update_inertia_demand_constraints( modified_units );
+ for( auto pid : pids ) {
+  int status = 0;
+  if( ( waitpid( pid , & status , 0 ) != pid ) || ( ! WIFEXITED( status ) )
+      || WEXITSTATUS( status ) )
+   failed = true;
+ }
 
-  // TODO Implement the following methods when their constraints have been
-  // properly implemented.
+ if( failed ) {
+  remove_files();
+  throw( std::runtime_error( fn + ": the serialization of a sub-Block "
+                             "failed" ) );
+ }
 
-  // update_pollutant_budget_constraints( modified_units );
-  // update_heat_constraints( modified_units );
+ // the single writer: the pieces are copied in order into group, by the
+ // same netCDF calls as in the serial path
+ try {
+  std::vector< netCDF::NcFile > in( jobs );
+  for( std::size_t j = 0 ; j < jobs ; ++j )
+   in[ j ].open( files[ j ] , netCDF::NcFile::read );
+
+  for( std::size_t i = 0 ; i < pieces.size() ; ++i ) {
+   auto sub_group = group.addGroup( pieces[ i ].second );
+   copy_nc_group( in[ i % jobs ].getGroup( "piece_" + std::to_string( i ) ) ,
+                  sub_group , storage );
+  }
+ } catch( ... ) {
+  remove_files();
+  throw;
  }
+ remove_files();
+#else
+ throw( std::logic_error( "UCBlock::serialize: no processes available" ) );
+#endif
 
- Block::add_Modification( mod , chnl );
-}
+}  // end( UCBlock::serialize_pieces )
 
 /*--------------------------------------------------------------------------*/
 
-void UCBlock::update_node_injection_constraints(
- const std::vector< Index > & modified_units )
+MemoryUsage UCBlock::get_memory_usage( void ) const
 {
- if( ( ! constraints_generated() ) ||
-     ( v_node_injection_Const.empty() ) || modified_units.empty() )
+ MemoryUsage usage;
+ usage.add_abstract( this );
+ usage.add_data( v_start_network_intervals , v_network_constant_terms ,
+                 v_number_pollutant_zones , v_pollutant_zones ,
+                 v_active_power_demand , v_primary_zones , v_primary_demand ,
+                 v_secondary_zones , v_secondary_demand , v_inertia_zones ,
+                 v_inertia_demand , v_pollutant_budget , v_pollutant_rho ,
+                 v_generator_node , primary_var_index , secondary_var_index ,
+                 v_inertia_terms , v_inertia_zone_start , v_fixed_design );
+
+ if( f_NetworkData )
+  usage += f_NetworkData->get_memory_usage();
+
+ for( auto sub : get_nested_Blocks() )
+  if( auto unit = dynamic_cast< const UnitBlock * >( sub ) )
+   usage += unit->get_memory_usage();
+  else
+   if( auto network = dynamic_cast< const NetworkBlock * >( sub ) )
+    usage += network->get_memory_usage();
+   else
+    usage += MemoryUsage::of_abstract( sub );
+
+ return( usage );
+
+}  // end( UCBlock::get_memory_usage )
+
+/*--------------------------------------------------------------------------*/
+
+void UCBlock::copy_nc_group( const netCDF::NcGroup & from ,
+                             netCDF::NcGroup & to ,
+                             const NcStorage & storage ,
+                             Index t0 , Index t1 )
+{
+ copy_nc_items( from , to , storage , t0 , t1 , {} );
+
+ for( const auto & [ name , sub_from ] : from.getGroups() ) {
+  auto sub_to = to.addGroup( name );
+  copy_nc_group( sub_from , sub_to , storage , t0 , t1 );
+ }
+
+}  // end( UCBlock::copy_nc_group )
+
+/*--------------------------------------------------------------------------*/
+
+void UCBlock::copy_nc_items( const netCDF::NcGroup & from ,
+                             netCDF::NcGroup & to ,
+                             const NcStorage & storage , Index t0 , Index t1 ,
+                             const std::set< std::string > & skip )
+{
+ // copy the attributes of a group or variable
+ auto copy_atts = []( const auto & atts , auto & dest ) {
+  for( const auto & [ name , att ] : atts ) {
+   // the marks of the ucblock_validate tool do not hold for the copy
+   if( name.compare( 0 , 9 , "Validated" ) == 0 )
+    continue;
+   auto type = att.getType();
+   auto len = att.getAttLength();
+   if( type.getTypeClass() == netCDF::NcType::nc_CHAR ) {
+    std::string value;
+    att.getValues( value );
+    dest.putAtt( name , value );
+   } else if( type.getTypeClass() == netCDF::NcType::nc_STRING ) {
+    std::vector< char * > value( len );
+    att.getValues( value.data() );
+    dest.putAtt( name , len , const_cast< const char ** >( value.data() ) );
+    nc_free_string( len , value.data() );
+   } else {
+    std::vector< char > value( len * type.getSize() );
+    att.getValues( static_cast< void * >( value.data() ) );
+    dest.putAtt( name , type , len ,
+                 static_cast< const void * >( value.data() ) );
+   }
+  }
+ };
+
+ // the time window, if it does not span the whole horizon
+ Index horizon = 0;
+ auto th = from.getDim( "TimeHorizon" , netCDF::NcGroup::ParentsAndCurrent );
+ if( ! th.isNull() )
+  horizon = th.getSize();
+ t1 = std::min( t1 , horizon );
+ const bool window = ( horizon > 0 ) && ( ( t0 > 0 ) || ( t1 < horizon ) );
+ if( window && ( t0 >= t1 ) )
+  throw( std::invalid_argument( "UCBlock::copy_nc_group: empty time "
+                                "window" ) );
+
+ // tell whether a dimension is restricted to the window
+ auto in_window = [ & ]( const netCDF::NcDim & d ) {
+  if( ! window )
+   return( false );
+  if( d.getName() == "TimeHorizon" )
+   return( true );
+  if( d.getName() != "NumberIntervals" )
+   return( false );
+  if( d.getSize() == horizon )
+   return( true );
+  if( d.getSize() > 1 )
+   throw( std::invalid_argument( "UCBlock::copy_nc_group: cannot restrict "
+                                 "1 < NumberIntervals < TimeHorizon to a "
+                                 "time window" ) );
+  return( false );
+ };
+
+ copy_atts( from.getAtts() , to );
+
+ // the dimensions defined in from itself; "NC_UNLIMITED" is 0, hence an
+ // unlimited dimension (or one of size 0) is copied as such
+ for( const auto & [ name , dim ] : from.getDims() )
+  if( skip.find( name ) == skip.end() )
+   to.addDim( name , in_window( dim ) ? t1 - t0 :
+                     ( dim.isUnlimited() ? NC_UNLIMITED : dim.getSize() ) );
+
+ for( const auto & [ name , var ] : from.getVars() ) {
+  if( skip.find( name ) != skip.end() )
+   continue;
+
+  auto type = var.getType();
+  const auto string = ( type.getTypeClass() == netCDF::NcType::nc_STRING );
+
+  std::vector< netCDF::NcDim > dims;
+  std::vector< std::size_t > start;
+  std::vector< std::size_t > shape;
+  std::vector< bool > is_time;
+  for( const auto & d : var.getDims() ) {
+   auto nd = to.getDim( d.getName() , netCDF::NcGroup::ParentsAndCurrent );
+   if( nd.isNull() )
+    throw( std::invalid_argument( "UCBlock::copy_nc_group: dimension " +
+                                  d.getName() + " not found" ) );
+   dims.push_back( nd );
+   const bool w = in_window( d );
+   start.push_back( w ? t0 : 0 );
+   shape.push_back( w ? t1 - t0 : d.getSize() );
+   is_time.push_back( ( d.getName() == "TimeHorizon" ) ||
+                      ( d.getName() == "NumberIntervals" ) );
+  }
+
+  auto new_var = to.addVar( name , type , dims );
+  copy_atts( var.getAtts() , new_var );
+
+  if( ( ! dims.empty() ) && ( ! string ) ) {
+   // compute the chunk shape, see NcStorage
+   std::vector< std::size_t > chunk( dims.size() );
+   auto it = storage.chunks.find( name );
+   if( ( it != storage.chunks.end() ) && ( it->second.size() == dims.size() ) )
+    for( Index i = 0 ; i < dims.size() ; ++i )
+     chunk[ i ] = std::min( std::max( it->second[ i ] , std::size_t( 1 ) ) ,
+                            std::max( shape[ i ] , std::size_t( 1 ) ) );
+   else if( std::none_of( is_time.begin() , is_time.end() ,
+                          []( bool b ) { return( b ); } ) )
+    for( Index i = 0 ; i < dims.size() ; ++i )
+     chunk[ i ] = std::max( shape[ i ] , std::size_t( 1 ) );
+   else {
+    std::size_t size = 1;
+    for( Index i = 0 ; i < dims.size() ; ++i ) {
+     chunk[ i ] = 1;
+     if( is_time[ i ] ) {
+      chunk[ i ] = std::max( shape[ i ] , std::size_t( 1 ) );
+      if( storage.time_chunk )
+       chunk[ i ] = std::min( chunk[ i ] , std::size_t( storage.time_chunk ) );
+     }
+     size *= chunk[ i ];
+    }
+    // grow too small chunks along the non-time dimensions, last first
+    for( auto i = dims.size() ; ( i-- > 0 ) &&
+                                ( size < NcStorage::kMinChunk ) ; )
+     if( ! is_time[ i ] ) {
+      chunk[ i ] = std::min( std::max( shape[ i ] , std::size_t( 1 ) ) ,
+                             ( NcStorage::kMinChunk + size - 1 ) / size );
+      size *= chunk[ i ];
+     }
+   }
+
+   new_var.setChunking( netCDF::NcVar::nc_CHUNKED , chunk );
+   if( ( storage.deflate_level > 0 ) || storage.shuffle )
+    new_var.setCompression( storage.shuffle , storage.deflate_level > 0 ,
+                            storage.deflate_level );
+  }
+
+  // copy the data (of the window) in one go
+  const auto n = std::accumulate( shape.begin() , shape.end() ,
+                                  std::size_t( 1 ) ,
+                                  std::multiplies< std::size_t >() );
+  if( ! n )
+   continue;
+
+  const std::vector< std::size_t > zero( shape.size() , 0 );
+  if( string ) {
+   std::vector< char * > data( n );
+   if( dims.empty() ) {
+    var.getVar( data.data() );
+    new_var.putVar( const_cast< const char ** >( data.data() ) );
+   } else {
+    var.getVar( start , shape , data.data() );
+    new_var.putVar( zero , shape ,
+                    const_cast< const char ** >( data.data() ) );
+   }
+   nc_free_string( n , data.data() );
+  } else {
+   std::vector< char > data( n * type.getSize() );
+   if( dims.empty() ) {
+    var.getVar( static_cast< void * >( data.data() ) );
+    new_var.putVar( static_cast< const void * >( data.data() ) );
+   } else {
+    var.getVar( start , shape , static_cast< void * >( data.data() ) );
+    new_var.putVar( zero , shape ,
+                    static_cast< const void * >( data.data() ) );
+   }
+  }
+ }
+
+}  // end( UCBlock::copy_nc_items )
+
+/*--------------------------------------------------------------------------*/
+/*--------------- METHODS FOR READING THE DATA OF THE UCBlock --------------*/
+/*--------------------------------------------------------------------------*/
+
+int UCBlock::get_objective_sense( void ) const { return( Objective::eMin ); }
+
+/*--------------------------------------------------------------------------*/
+/*--------------- METHODS FOR HANDLING THE DESIGN VARIABLES ----------------*/
+/*--------------------------------------------------------------------------*/
+
+std::vector< ColVariable * > UCBlock::get_design_variables( void )
+{
+ std::vector< ColVariable * > design;
+
+ for( Index i = 0 ; i < f_number_units ; ++i ) {
+  auto unit = get_unit_block( i );
+  for( Index d = 0 ; d < unit->get_number_design_variables() ; ++d )
+   design.push_back( unit->get_design_variable( d ) );
+ }
+
+ return( design );
+
+}  // end( UCBlock::get_design_variables )
+
+/*--------------------------------------------------------------------------*/
+
+void UCBlock::fix_design_variables( const std::vector< double > & values ,
+                                   ModParam issueAMod )
+{
+ auto design = get_design_variables();
+
+ if( values.size() != design.size() )
+  throw( std::invalid_argument( "UCBlock::fix_design_variables: values has "
+                                "size " + std::to_string( values.size() ) +
+                                " but there are " +
+                                std::to_string( design.size() ) +
+                                " design variables" ) );
+
+ unfix_design_variables( issueAMod );
+
+ for( Index i = 0 ; i < design.size() ; ++i ) {
+  if( design[ i ]->is_fixed() )  // fixed by the UnitBlock itself
+   continue;                     // leave it alone
+
+  design[ i ]->set_value( values[ i ] );
+  design[ i ]->is_fixed( true , issueAMod );
+  v_fixed_design.push_back( design[ i ] );
+ }
+}  // end( UCBlock::fix_design_variables )
+
+/*--------------------------------------------------------------------------*/
+
+void UCBlock::unfix_design_variables( ModParam issueAMod )
+{
+ for( auto var : v_fixed_design )
+  var->is_fixed( false , issueAMod );
+
+ v_fixed_design.clear();
+
+}  // end( UCBlock::unfix_design_variables )
+
+/*--------------------------------------------------------------------------*/
+/*------------------- METHODS FOR COMPUTING A SOLUTION ---------------------*/
+/*--------------------------------------------------------------------------*/
+
+void UCBlock::merit_order_heuristic( void )
+{
+ const auto T = f_time_horizon;
+
+ // aggregated requirements - - - - - - - - - - - - - - - - - - - - - - - - -
+ // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+ std::vector< double > demand( T , 0.0 );
+ std::vector< double > primary( T , 0.0 );
+ std::vector< double > secondary( T , 0.0 );
+ std::vector< double > inertia( T , 0.0 );
+
+ if( ! v_network_blocks.empty() ) {
+  // the demand is in the NetworkBlock, one interval per time instant
+  const auto number_nodes = get_number_nodes();
+  Index t = 0;
+  for( auto nb : v_network_blocks )
+   for( Index i = 0 ; i < nb->get_number_intervals() ; ++i , ++t )
+    if( auto ad = nb->get_active_demand( i ) )
+     demand[ t ] = std::accumulate( ad , ad + number_nodes , 0.0 );
+ }
+ else
+  for( Index n = 0 ; n < v_active_power_demand.shape()[ 0 ] ; ++n )
+   for( Index t = 0 ; t < T ; ++t )
+    demand[ t ] += v_active_power_demand[ n ][ t ];
+
+ for( Index z = 0 ; z < v_primary_demand.shape()[ 0 ] ; ++z )
+  for( Index t = 0 ; t < T ; ++t )
+   primary[ t ] += v_primary_demand[ z ][ t ];
+
+ for( Index z = 0 ; z < v_secondary_demand.shape()[ 0 ] ; ++z )
+  for( Index t = 0 ; t < T ; ++t )
+   secondary[ t ] += v_secondary_demand[ z ][ t ];
+
+ for( Index z = 0 ; z < v_inertia_demand.shape()[ 0 ] ; ++z )
+  for( Index t = 0 ; t < T ; ++t )
+   inertia[ t ] += v_inertia_demand[ z ][ t ];
+
+ // intermittent units: produce as much as possible - - - - - - - - - - - - -
+ // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+ std::vector< IntermittentUnitBlock * > intermittent;
+ std::vector< ThermalUnitBlock * > thermal;
+
+ for( Index i = 0 ; i < f_number_units ; ++i ) {
+  auto unit = get_unit_block( i );
+  if( auto tub = dynamic_cast< ThermalUnitBlock * >( unit ) ) {
+   if( tub->get_commitment( 0 ) && tub->get_active_power( 0 ) )
+    thermal.push_back( tub );
+  }
+  else
+   if( auto iub = dynamic_cast< IntermittentUnitBlock * >( unit ) )
+    if( iub->get_active_power( 0 ) )
+     intermittent.push_back( iub );
+ }
+
+ std::vector< double > renewable( T , 0.0 );
+ for( auto iub : intermittent )
+  for( Index t = 0 ; t < T ; ++t )
+   renewable[ t ] += iub->get_scale() * iub->get_kappa() *
+                     iub->get_max_power( t );
+
+ for( Index t = 0 ; t < T ; ++t ) {
+  // the fraction of the available renewable production that is used
+  const double ratio = renewable[ t ] > demand[ t ] ?
+                       std::max( demand[ t ] , 0.0 ) / renewable[ t ] : 1.0;
+  for( auto iub : intermittent )
+   iub->get_active_power( 0 )[ t ].set_value(
+                           ratio * iub->get_kappa() * iub->get_max_power( t ) );
+  demand[ t ] = std::max( demand[ t ] - ratio * renewable[ t ] , 0.0 );
+ }
+
+ // thermal units: merit order - - - - - - - - - - - - - - - - - - - - - - -
+ // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ // all powers are in "scaled" units, i.e., as they appear in the demand
+ // constraints
+
+ const auto U = thermal.size();
+
+ std::vector< double > pmin( U * T );
+ std::vector< double > pmax( U * T );
+ std::vector< double > cost( U );
+
+ for( Index k = 0 ; k < U ; ++k ) {
+  auto tub = thermal[ k ];
+  const auto scale = tub->get_scale();
+  double ce = 0;
+  double en = 0;
+  for( Index t = 0 ; t < T ; ++t ) {
+   const auto mp = tub->get_operational_max_power( t );
+   pmin[ k * T + t ] = scale * tub->get_operational_min_power( t );
+   pmax[ k * T + t ] = scale * mp;
+   ce += tub->get_const_term( t ) + tub->get_linear_term( t ) * mp +
+         tub->get_quad_term( t ) * mp * mp;
+   en += mp;
+  }
+  if( ! tub->get_start_up_cost().empty() )
+   ce += T * tub->get_start_up_cost().front() /
+         std::max( tub->get_min_up_time() , Index( 1 ) );
+  cost[ k ] = en > 0 ? ce / en : Inf< double >();
+ }
+
+ std::vector< Index > order( U );
+ std::iota( order.begin() , order.end() , 0 );
+ std::stable_sort( order.begin() , order.end() ,
+                   [ & cost ]( Index a , Index b ) {
+                    return( cost[ a ] < cost[ b ] );
+                   } );
+
+ // initial state: first instant in which the commitment is free, and its
+ // value before that (see ThermalUnitBlock::generate_abstract_variables())
+
+ std::vector< Index > init_t( U );
+ for( Index k = 0 ; k < U ; ++k ) {
+  auto tub = thermal[ k ];
+  const auto iudt = tub->get_init_up_down_time();
+  if( iudt > 0 )
+   init_t[ k ] = std::min( T , Index( iudt ) >= tub->get_min_up_time() ? 0 :
+                           tub->get_min_up_time() - iudt );
+  else
+   init_t[ k ] = std::min( T , Index( -iudt ) >= tub->get_min_down_time() ?
+                           0 : tub->get_min_down_time() + iudt );
+ }
+
+ // greedy commitment - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+ std::vector< char > on( U * T , 0 );
+
+ auto inertia_of = [ & ]( Index k , Index t ) {
+  auto tub = thermal[ k ];
+  double in = 0;
+  if( auto ic = tub->get_inertia_commitment( 0 ) )
+   in += tub->get_scale() * ic[ t ];
+  if( auto ip = tub->get_inertia_power( 0 ) )
+   in += ip[ t ] * pmax[ k * T + t ];
+  return( in );
+ };
+
+ for( Index t = 0 ; t < T ; ++t ) {
+  double cap = 0;
+  double inr = 0;
+  for( Index k = 0 ; k < U ; ++k )
+   if( ( t < init_t[ k ] ) && ( thermal[ k ]->get_init_up_down_time() > 0 ) ) {
+    on[ k * T + t ] = 1;
+    cap += pmax[ k * T + t ];
+    inr += inertia_of( k , t );
+   }
+
+  const double need = demand[ t ] + primary[ t ] + secondary[ t ];
+  for( auto k : order ) {
+   if( ( cap >= need ) && ( inr >= inertia[ t ] ) )
+    break;
+   if( ( t < init_t[ k ] ) || on[ k * T + t ] || ( pmax[ k * T + t ] <= 0 ) )
+    continue;
+   on[ k * T + t ] = 1;
+   cap += pmax[ k * T + t ];
+   inr += inertia_of( k , t );
+  }
+ }
+
+ // minimum up- and down-time repair- - - - - - - - - - - - - - - - - - - -
+ // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+ for( Index k = 0 ; k < U ; ++k ) {
+  auto tub = thermal[ k ];
+  auto u = on.begin() + k * T;
+  const Index mut = tub->get_min_up_time();
+  const Index mdt = tub->get_min_down_time();
+
+  // extend the up periods shorter than the minimum up time
+  bool prev = tub->get_init_up_down_time() > 0;
+  for( Index t = init_t[ k ] ; t < T ; ++t ) {
+   if( u[ t ] && ( ! prev ) )  // start-up at t: stay up for mut instants
+    for( Index h = t ; h < std::min( t + mut , T ) ; ++h )
+     u[ h ] = 1;
+   prev = u[ t ];
+  }
+
+  // close the down periods shorter than the minimum down time; the unit is
+  // kept up rather than down, which keeps the capacity requirements
+  prev = tub->get_init_up_down_time() > 0;
+  for( Index t = init_t[ k ] ; t < T ; ++t ) {
+   if( ( ! u[ t ] ) && prev ) {  // shut-down at t: find the next start-up
+    Index h = t;
+    while( ( h < T ) && ( ! u[ h ] ) )
+     ++h;
+    if( ( h < T ) && ( h - t < mdt ) )
+     std::fill( u + t , u + h , 1 );
+    t = h - 1;
+    prev = u[ t ];
+    continue;
+   }
+   prev = u[ t ];
+  }
+ }
+
+ // economic dispatch and reserve allocation- - - - - - - - - - - - - - - -
+ // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+ std::vector< double > p( U );
+
+ for( Index t = 0 ; t < T ; ++t ) {
+  double residual = demand[ t ];
+  for( Index k = 0 ; k < U ; ++k ) {
+   p[ k ] = on[ k * T + t ] ? pmin[ k * T + t ] : 0;
+   residual -= p[ k ];
+  }
+
+  for( auto k : order ) {
+   if( residual <= 0 )
+    break;
+   if( ! on[ k * T + t ] )
+    continue;
+   const auto add = std::min( residual , pmax[ k * T + t ] - p[ k ] );
+   p[ k ] += add;
+   residual -= add;
+  }
+
+  double pr_need = primary[ t ];
+  double sc_need = secondary[ t ];
+
+  for( auto k : order ) {
+   auto tub = thermal[ k ];
+   const auto scale = tub->get_scale();
+   double headroom = on[ k * T + t ] ? pmax[ k * T + t ] - p[ k ] : 0;
+
+   if( auto pr = tub->get_primary_spinning_reserve( 0 ) ) {
+    double r = 0;
+    if( ! tub->get_primary_rho().empty() )
+     r = std::min( { pr_need , headroom ,
+                     tub->get_primary_rho()[ t ] * p[ k ] } );
+    r = std::max( r , 0.0 );
+    pr[ t ].set_value( r / scale );
+    pr_need -= r;
+    headroom -= r;
+   }
+
+   if( auto sc = tub->get_secondary_spinning_reserve( 0 ) ) {
+    double r = 0;
+    if( ! tub->get_secondary_rho().empty() )
+     r = std::min( { sc_need , headroom ,
+                     tub->get_secondary_rho()[ t ] * p[ k ] } );
+    r = std::max( r , 0.0 );
+    sc[ t ].set_value( r / scale );
+    sc_need -= r;
+   }
+
+   tub->get_active_power( 0 )[ t ].set_value( p[ k ] / scale );
+  }
+ }
+
+ // commitment, start-up and shut-down Variable - - - - - - - - - - - - - -
+ // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+ for( Index k = 0 ; k < U ; ++k ) {
+  auto tub = thermal[ k ];
+  auto u = tub->get_commitment( 0 );
+  bool prev = tub->get_init_up_down_time() > 0;
+  for( Index t = 0 ; t < T ; ++t ) {
+   const bool now = on[ k * T + t ];
+   u[ t ].set_value( now ? 1 : 0 );
+   if( auto su = tub->get_start_up( t ) )
+    su->set_value( ( now && ( ! prev ) ) ? 1 : 0 );
+   if( auto sd = tub->get_shut_down( t ) )
+    sd->set_value( ( ( ! now ) && prev ) ? 1 : 0 );
+   prev = now;
+  }
+ }
+}  // end( UCBlock::merit_order_heuristic )
+
+/*--------------------------------------------------------------------------*/
+/*-------------- METHODS FOR CHECKING SOLUTION INFORMATION -----------------*/
+/*--------------------------------------------------------------------------*/
+
+bool UCBlock::is_feasible( bool useabstract , Configuration * fsbc )
+{
+ return( check_feasibility( nullptr , fsbc , 1 , useabstract ) );
+}
+
+/*--------------------------------------------------------------------------*/
+
+bool UCBlock::check_feasibility( std::vector< ViolationSummary > * summary ,
+                                 Configuration * fsbc ,
+                                 unsigned int threads ,
+                                 bool useabstract )
+{
+ // Retrieve the tolerance and the type of violation.
+ double tol = 0;
+ bool rel_viol = true;
+
+ // Try to extract, from "c", the parameters that determine feasibility.
+ // If it succeeds, it sets the values of the parameters and returns
+ // true. Otherwise, it returns false.
+ auto extract_parameters = [ & tol , & rel_viol ]( Configuration * c )
+  -> bool {
+  if( auto tc = dynamic_cast< SimpleConfiguration< double > * >( c ) ) {
+   tol = tc->f_value;
+   return( true );
+  }
+  if( auto tc = dynamic_cast< SimpleConfiguration<
+                 std::pair< double , int > > * >( c ) ) {
+   tol = tc->f_value.first;
+   rel_viol = tc->f_value.second;
+   return( true );
+  }
+  return( false );
+ };
+
+ if( ( ! extract_parameters( fsbc ) ) && f_BlockConfig )
+  // if the given Configuration is not valid, try the one from the BlockConfig
+  extract_parameters( f_BlockConfig->f_is_feasible_Configuration );
+
+ if( summary )
+  summary->clear();
+
+ // cleared as soon as a violation is found; without a summary, this stops
+ // all the threads
+ std::atomic< bool > feasible( true );
+ auto go_on = [ & feasible , summary ]() {
+  return( summary || feasible.load( std::memory_order_relaxed ) );
+ };
+
+ // the sub-Block, checked by a pool of threads picking the next one
+ std::vector< Block * > children;
+ for( auto block : v_Block )
+  if( block )
+   children.push_back( block );
+
+ std::vector< char > child_feasible( children.size() , 1 );
+ std::atomic< std::size_t > next_child( 0 );
+ std::exception_ptr error;
+ std::mutex error_mutex;
+
+ // records the exception being handled (if it is the first one) and stops
+ // the checks of the sub-Block; the exception is rethrown after the pool
+ // has been joined, which must happen on every exit path
+ auto record_error = [ & ]() {
+  std::lock_guard< std::mutex > lock( error_mutex );
+  if( ! error )
+   error = std::current_exception();
+  next_child = children.size();
+ };
+
+ auto check_children = [ & ]() {
+  try {
+   while( go_on() ) {
+    const auto i = next_child++;
+    if( i >= children.size() )
+     break;
+    if( ! children[ i ]->is_feasible( useabstract , fsbc ) ) {
+     child_feasible[ i ] = 0;
+     feasible = false;
+    }
+   }
+  } catch( ... ) {
+   record_error();
+  }
+ };
+
+ if( ! threads )
+  threads = std::max( 1u , std::thread::hardware_concurrency() );
+ threads = std::min< std::size_t >( threads , children.size() );
+
+ std::vector< std::thread > pool;
+ try {
+  for( unsigned int i = 1 ; i < threads ; ++i )
+   pool.emplace_back( check_children );
+ } catch( ... ) {
+  record_error();
+ }
+
+ // meanwhile, the calling thread checks the linking constraints
+ auto check_rows = [ & ]( ViolationSummary & family , FRowConstraint * rows ,
+                          std::size_t n ) {
+  for( std::size_t i = 0 ; ( i < n ) && go_on() ; ++i ) {
+   rows[ i ].compute();
+   const double viol = rel_viol ? rows[ i ].rel_viol()
+                                : rows[ i ].abs_viol();
+   ++family.rows;
+   if( viol > tol ) {
+    ++family.violated;
+    family.max_violation = std::max( family.max_violation , viol );
+    feasible = false;
+   }
+  }
+ };
+
+ auto check_family = [ & ]( const std::string & name ,
+                            boost::multi_array< FRowConstraint , 2 > & rows ) {
+  ViolationSummary family;
+  family.family = name;
+  check_rows( family , rows.data() , rows.num_elements() );
+  if( summary && family.rows )
+   summary->push_back( family );
+ };
+
+ try {
+  check_family( "NodeInjection" , v_node_injection_Const );
+  check_family( "PrimaryDemand" , v_PrimaryDemand_Const );
+  check_family( "SecondaryDemand" , v_SecondaryDemand_Const );
+  check_family( "InertiaDemand" , v_InertiaDemand_Const );
+
+  ViolationSummary pollutants;
+  pollutants.family = "PollutantBudget";
+  for( auto & rows : v_PollutantBudget_Const )
+   check_rows( pollutants , rows.data() , rows.size() );
+  if( summary && pollutants.rows )
+   summary->push_back( pollutants );
+ } catch( ... ) {
+  record_error();
+ }
+
+ // then it joins the pool (which does nothing after an error)
+ check_children();
+ for( auto & thread : pool )
+  thread.join();
+
+ if( error )
+  std::rethrow_exception( error );
+
+ if( summary ) {
+  std::map< std::string , ViolationSummary > by_class;
+  for( std::size_t i = 0 ; i < children.size() ; ++i ) {
+   auto & family = by_class[ children[ i ]->classname() ];
+   ++family.rows;
+   if( ! child_feasible[ i ] )
+    ++family.violated;
+  }
+  for( auto & [ name , family ] : by_class ) {
+   family.family = name;
+   summary->push_back( family );
+  }
+ }
+
+ return( feasible );
+
+}  // end( UCBlock::check_feasibility )
+
+/*--------------------------------------------------------------------------*/
+/*------------------- METHODS FOR EVALUATING A SCHEDULE --------------------*/
+/*--------------------------------------------------------------------------*/
+
+double UCBlock::evaluate_cost( const Schedule & schedule ) const
+{
+ const auto T = f_time_horizon;
+
+ Index number_generators = 0;
+ for( Index i = 0 ; i < f_number_units ; ++i )
+  if( auto unit = dynamic_cast< const UnitBlock * >( v_Block[ i ] ) )
+   number_generators += unit->get_number_generators();
+
+ auto check_size = [ & ]( const std::vector< double > & v ,
+                          const std::string & name , bool optional ) {
+  if( ( optional && v.empty() ) ||
+      ( v.size() == std::size_t( number_generators ) * T ) )
+   return;
+  throw( std::invalid_argument( "UCBlock::evaluate_cost: " + name +
+                                " must have size " +
+                                std::to_string( number_generators * T ) ) );
+ };
+
+ check_size( schedule.commitment , "commitment" , false );
+ check_size( schedule.active_power , "active_power" , false );
+ check_size( schedule.start_up , "start_up" , true );
+ check_size( schedule.primary_reserve , "primary_reserve" , true );
+ check_size( schedule.secondary_reserve , "secondary_reserve" , true );
+ check_size( schedule.intake , "intake" , true );
+ check_size( schedule.outtake , "outtake" , true );
+ if( schedule.intake.empty() != schedule.outtake.empty() )
+  throw( std::invalid_argument( "UCBlock::evaluate_cost: intake and outtake "
+                                "must be either both given or both empty" ) );
+
+ // the terms that a Schedule does not describe
+ for( Index i = 0 ; i < f_number_units ; ++i )
+  if( auto hydro =
+       dynamic_cast< const HydroSystemUnitBlock * >( v_Block[ i ] ) )
+   if( hydro->get_number_nested_Blocks() > hydro->get_number_hydro_units() )
+    throw( std::logic_error( "UCBlock::evaluate_cost: the future value of "
+                             "water of HydroSystemUnitBlock " +
+                             std::to_string( i ) + " is not supported" ) );
+ for( auto nb : v_network_blocks )
+  if( dynamic_cast< const ECNetworkBlock * >( nb ) )
+   throw( std::logic_error( "UCBlock::evaluate_cost: ECNetworkBlock is not "
+                            "supported" ) );
+
+ // the value at time t of a data vector that is either empty (all 0) or
+ // has size 1 (the same for all t) or T
+ auto at = []( const std::vector< double > & v , Index t ) -> double {
+  return( v.empty() ? 0 : v[ v.size() == 1 ? 0 : t ] );
+ };
+
+ // the value of generator g at time t of an optional array of the schedule
+ auto value = [ T ]( const std::vector< double > & v , Index g , Index t )
+  -> double {
+  return( v.empty() ? 0 : v[ g * T + t ] );
+ };
+
+ double cost = 0;
+
+ // the UnitBlock - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ Index g = 0;
+ for( Index i = 0 ; i < f_number_units ; ++i ) {
+  auto unit = dynamic_cast< const UnitBlock * >( v_Block[ i ] );
+  if( ! unit )
+   continue;
+
+  double unit_cost = 0;
+
+  if( auto thermal = dynamic_cast< const ThermalUnitBlock * >( unit ) ) {
+   // the start-up before init_t are decided by the initial conditions
+   const int init = thermal->get_init_up_down_time();
+   const Index min_up = thermal->get_min_up_time();
+   const Index min_down = thermal->get_min_down_time();
+   Index init_t;
+   if( init > 0 )
+    init_t = ( Index( init ) >= min_up ? 0 : min_up - init );
+   else
+    init_t = ( Index( -init ) >= min_down ? 0 : min_down + init );
+
+   const auto & start_up_cost = thermal->get_start_up_cost();
+   const auto & linear_term = thermal->get_linear_term();
+   const auto & quad_term = thermal->get_quad_term();
+   const auto & const_term = thermal->get_const_term();
+   const auto & primary_cost =
+    thermal->get_primary_spinning_reserve_cost();
+   const auto & secondary_cost =
+    thermal->get_secondary_spinning_reserve_cost();
+
+   double previous = ( init > 0 ? 1 : 0 );
+   for( Index t = 0 ; t < T ; ++t ) {
+    const double u = schedule.commitment[ g * T + t ];
+    const double p = schedule.active_power[ g * T + t ];
+    if( t >= init_t ) {
+     const double v = schedule.start_up.empty() ?
+                      std::max( 0.0 , u - previous ) :
+                      schedule.start_up[ g * T + t ];
+     unit_cost += at( start_up_cost , t ) * v;
+    }
+    previous = u;
+    unit_cost += ( at( linear_term , t ) + at( quad_term , t ) * p ) * p +
+                 at( const_term , t ) * u +
+                 at( primary_cost , t ) *
+                 value( schedule.primary_reserve , g , t ) +
+                 at( secondary_cost , t ) *
+                 value( schedule.secondary_reserve , g , t );
+   }
+   unit_cost *= thermal->get_scale();
+  }
+  else if( auto battery = dynamic_cast< const BatteryUnitBlock * >( unit ) ) {
+   // the same coefficients of the intake and outtake power as in
+   // generate_objective(); if they are not given, they are the only split
+   // of the net active power p = intake - outtake using only one of them
+   const auto & battery_cost = battery->get_cost();
+   for( Index t = 0 ; t < T ; ++t ) {
+    const double p = schedule.active_power[ g * T + t ];
+    const double intake = schedule.intake.empty() ?
+                          std::max( 0.0 , p ) : schedule.intake[ g * T + t ];
+    const double outtake = schedule.outtake.empty() ?
+                           std::max( 0.0 , -p ) :
+                           schedule.outtake[ g * T + t ];
+    unit_cost += at( battery_cost , t ) * intake +
+                 at( battery_cost , t ) * outtake;
+   }
+   unit_cost *= battery->get_scale();
+  }
+  else if( auto slack = dynamic_cast< const SlackUnitBlock * >( unit ) ) {
+   const auto & power_cost = slack->get_active_power_cost();
+   const auto & primary_cost = slack->get_primary_cost();
+   const auto & secondary_cost = slack->get_secondary_cost();
+   const auto & inertia_cost = slack->get_inertia_cost();
+   const double * inertia = f_number_inertia_zones > 0 ?
+                            slack->get_inertia_commitment( 0 ) : nullptr;
+   for( Index t = 0 ; t < T ; ++t ) {
+    unit_cost += at( power_cost , t ) * schedule.active_power[ g * T + t ] +
+                 at( primary_cost , t ) *
+                 value( schedule.primary_reserve , g , t ) +
+                 at( secondary_cost , t ) *
+                 value( schedule.secondary_reserve , g , t );
+    if( inertia )
+     unit_cost += at( inertia_cost , t ) * inertia[ t ] *
+                  schedule.commitment[ g * T + t ];
+   }
+  }
+
+  cost += unit_cost;
+  g += unit->get_number_generators();
+ }
+
+ // the NetworkBlock- - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ if( ! schedule.power_flow.empty() ) {
+  std::size_t number_lines = 0;
+  for( auto nb : v_network_blocks )
+   if( auto dc = dynamic_cast< const DCNetworkBlock * >( nb ) )
+    number_lines += dc->get_number_lines();
+  if( schedule.power_flow.size() != number_lines )
+   throw( std::invalid_argument( "UCBlock::evaluate_cost: power_flow must "
+                                 "have size " +
+                                 std::to_string( number_lines ) ) );
+ }
+
+ std::size_t first_line = 0;
+ for( auto nb : v_network_blocks ) {
+  if( ! nb )
+   continue;
+  cost += nb->get_const_term();
+
+  auto dc = dynamic_cast< const DCNetworkBlock * >( nb );
+  if( ( ! dc ) || ( ! dc->get_number_lines() ) )
+   continue;
+  if( ! schedule.power_flow.empty() ) {
+   const auto & network_cost = static_cast< DCNetworkBlock::DCNetworkData * >(
+    dc->get_NetworkData() )->get_network_cost();
+   if( ! network_cost.empty() )
+    for( Index l = 0 ; l < dc->get_number_lines() ; ++l )
+     cost += network_cost[ l ] *
+             std::abs( schedule.power_flow[ first_line + l ] );
+  }
+  first_line += dc->get_number_lines();
+ }
+
+ return( cost );
+
+}  // end( UCBlock::evaluate_cost )
+
+/*--------------------------------------------------------------------------*/
+
+std::vector< double > UCBlock::evaluate_costs(
+ const std::vector< Schedule > & schedules , unsigned int threads ) const
+{
+ std::vector< double > costs( schedules.size() );
+
+ // a pool of threads picking the next schedule; evaluate_cost() only reads
+ // the data, so no synchronization is needed besides the index
+ std::atomic< std::size_t > next( 0 );
+ std::exception_ptr error;
+ std::mutex error_mutex;
+
+ auto evaluate = [ & ]() {
+  try {
+   while( true ) {
+    const auto i = next++;
+    if( i >= schedules.size() )
+     break;
+    costs[ i ] = evaluate_cost( schedules[ i ] );
+   }
+  } catch( ... ) {
+   std::lock_guard< std::mutex > lock( error_mutex );
+   if( ! error )
+    error = std::current_exception();
+   next = schedules.size();
+  }
+ };
+
+ if( ! threads )
+  threads = std::max( 1u , std::thread::hardware_concurrency() );
+ threads = std::min< std::size_t >( threads , schedules.size() );
+
+ std::vector< std::thread > pool;
+ for( unsigned int i = 1 ; i < threads ; ++i )
+  pool.emplace_back( evaluate );
+
+ evaluate();
+ for( auto & thread : pool )
+  thread.join();
+
+ if( error )
+  std::rethrow_exception( error );
+
+ return( costs );
+
+}  // end( UCBlock::evaluate_costs )
+
+/*--------------------------------------------------------------------------*/
+/*------------- METHODS FOR SAVING AND RESTORING A SOLUTION ----------------*/
+/*--------------------------------------------------------------------------*/
+
+void UCBlock::serialize_solution( netCDF::NcGroup & group , bool duals ,
+                                  int deflate_level ) const
+{
+ static const auto NaN = std::numeric_limits< double >::quiet_NaN();
+
+ group.putAtt( "type" , "UCBlockSolution" );
+ auto TimeHorizon = group.addDim( "TimeHorizon" , f_time_horizon );
+
+ // add a dimension, unless it has size 0 (it would be unlimited)
+ auto add_dim = [ & group ]( const std::string & name , Index size ) {
+  auto dim = group.getDim( name );
+  if( dim.isNull() ) {
+   if( size > 0 )
+    dim = group.addDim( name , size );
+  } else if( dim.getSize() != size )
+   throw( std::logic_error( "UCBlock::serialize_solution: inconsistent "
+                            "size of " + name ) );
+  return( dim );
+ };
+
+ // write a dense matrix, unless it is all NaN; the time profile of each row
+ // is a chunk
+ auto write = [ & ]( const std::string & name ,
+                     const std::vector< netCDF::NcDim > & dims ,
+                     const std::vector< double > & data ) {
+  if( std::all_of( data.begin() , data.end() ,
+                   []( double v ) { return( std::isnan( v ) ); } ) )
+   return;
+
+  auto var = group.addVar( name , netCDF::NcDouble() , dims );
+  std::vector< std::size_t > chunk;
+  for( const auto & d : dims )
+   chunk.push_back( d == TimeHorizon ? d.getSize() : 1 );
+  var.setChunking( netCDF::NcVar::nc_CHUNKED , chunk );
+  if( deflate_level > 0 )
+   var.setCompression( true , true , deflate_level );
+  var.putVar( data.data() );
+ };
+
+ // the generator and storage Variable of the UnitBlock
+ std::vector< std::vector< double > > gen_data(
+  solution_generator_vars.size() );
+ std::vector< double > storage_data;
+ Index number_generators = 0;
+ Index number_storages = 0;
+
+ for( Index u = 0 ; u < f_number_units ; ++u ) {
+  auto unit = get_unit_block( u );
+
+  for( Index g = 0 ; g < unit->get_number_generators() ; ++g ) {
+   for( Index k = 0 ; k < solution_generator_vars.size() ; ++k ) {
+    auto var = ( unit->*solution_generator_vars[ k ].second )( g );
+    for( Index t = 0 ; t < f_time_horizon ; ++t )
+     gen_data[ k ].push_back( var ? var[ t ].get_value() : NaN );
+   }
+   ++number_generators;
+  }
+
+  for( Index s = 0 ; s < unit->get_number_storages() ; ++s ) {
+   auto var = unit->get_storage( s );
+   for( Index t = 0 ; t < f_time_horizon ; ++t )
+    storage_data.push_back( var ? var[ t ].get_value() : NaN );
+   ++number_storages;
+  }
+ }
+
+ if( auto NumberGenerators = add_dim( "NumberElectricalGenerators" ,
+                                      number_generators ) ;
+     ! NumberGenerators.isNull() )
+  for( Index k = 0 ; k < solution_generator_vars.size() ; ++k )
+   write( solution_generator_vars[ k ].first ,
+          { NumberGenerators , TimeHorizon } , gen_data[ k ] );
+
+ if( auto NumberStorages = add_dim( "NumberStorages" , number_storages ) ;
+     ! NumberStorages.isNull() )
+  write( "Storage" , { NumberStorages , TimeHorizon } , storage_data );
+
+ // the node injection Variable of the NetworkBlock, if all are there
+ if( ( ! v_network_blocks.empty() ) &&
+     std::all_of( v_network_blocks.begin() , v_network_blocks.end() ,
+                  []( NetworkBlock * nb ) { return( nb != nullptr ); } ) ) {
+  const Index number_nodes = v_network_blocks.front()->get_number_nodes();
+  std::vector< double > data;
+  data.reserve( f_time_horizon * number_nodes );
+  for( auto nb : v_network_blocks )
+   for( Index i = 0 ; i < nb->get_number_intervals() ; ++i ) {
+    auto var = nb->get_node_injection( i );
+    for( Index n = 0 ; n < number_nodes ; ++n )
+     data.push_back( var ? var[ n ].get_value() : NaN );
+   }
+
+  if( data.size() != f_time_horizon * number_nodes )
+   throw( std::logic_error( "UCBlock::serialize_solution: the NetworkBlock "
+                            "do not span the time horizon" ) );
+
+  if( auto NumberNodes = add_dim( "NumberNodes" , number_nodes ) ;
+      ! NumberNodes.isNull() )
+   write( "NodeInjection" , { TimeHorizon , NumberNodes } , data );
+ }
+
+ if( ! duals )
+  return;
+
+ // the dual values of the linking constraints
+ auto write_duals = [ & ]( const std::string & name ,
+                           const std::string & dim_name ,
+                           const boost::multi_array< FRowConstraint , 2 > &
+                            rows ) {
+  if( ! rows.num_elements() )
+   return;
+  auto dim = add_dim( dim_name , rows.shape()[ 1 ] );
+  std::vector< double > data;
+  data.reserve( rows.num_elements() );
+  for( auto it = rows.data() ; it != rows.data() + rows.num_elements() ; )
+   data.push_back( ( it++ )->get_dual() );
+  write( name , { TimeHorizon , dim } , data );
+ };
+
+ write_duals( "NodeInjectionDual" , "NumberNodes" , v_node_injection_Const );
+ write_duals( "PrimaryDemandDual" , "NumberPrimaryZones" ,
+              v_PrimaryDemand_Const );
+ write_duals( "SecondaryDemandDual" , "NumberSecondaryZones" ,
+              v_SecondaryDemand_Const );
+ write_duals( "InertiaDemandDual" , "NumberInertiaZones" ,
+              v_InertiaDemand_Const );
+
+}  // end( UCBlock::serialize_solution )
+
+/*--------------------------------------------------------------------------*/
+
+void UCBlock::deserialize_solution( const netCDF::NcGroup & group ,
+                                    bool duals )
+{
+ // read a whole netCDF variable, if it is there, checking its size
+ auto read = [ & group ]( const std::string & name , std::size_t size ) {
+  std::vector< double > data;
+  auto var = group.getVar( name );
+  if( var.isNull() )
+   return( data );
+
+  std::size_t n = 1;
+  for( const auto & d : var.getDims() )
+   n *= d.getSize();
+  if( n != size )
+   throw( std::invalid_argument( "UCBlock::deserialize_solution: " + name +
+                                 " has wrong size" ) );
+  data.resize( n );
+  var.getVar( data.data() );
+  return( data );
+ };
+
+ // write n values into an array of ColVariable, skipping NaN
+ auto set = []( ColVariable * var , const double * values , Index n ) {
+  if( var )
+   for( Index i = 0 ; i < n ; ++i )
+    if( ! std::isnan( values[ i ] ) )
+     var[ i ].set_value( values[ i ] );
+ };
+
+ auto time_dim = group.getDim( "TimeHorizon" );
+ if( time_dim.isNull() || ( time_dim.getSize() != f_time_horizon ) )
+  throw( std::invalid_argument( "UCBlock::deserialize_solution: wrong "
+                                "TimeHorizon" ) );
+
+ // the generator and storage Variable of the UnitBlock
+ Index number_generators = 0;
+ Index number_storages = 0;
+ for( Index u = 0 ; u < f_number_units ; ++u ) {
+  number_generators += get_unit_block( u )->get_number_generators();
+  number_storages += get_unit_block( u )->get_number_storages();
+ }
+
+ for( const auto & [ name , getter ] : solution_generator_vars ) {
+  auto data = read( name , number_generators * f_time_horizon );
+  if( data.empty() )
+   continue;
+  auto values = data.data();
+  for( Index u = 0 ; u < f_number_units ; ++u ) {
+   auto unit = get_unit_block( u );
+   for( Index g = 0 ; g < unit->get_number_generators() ; ++g ) {
+    set( ( unit->*getter )( g ) , values , f_time_horizon );
+    values += f_time_horizon;
+   }
+  }
+ }
+
+ if( auto data = read( "Storage" , number_storages * f_time_horizon ) ;
+     ! data.empty() ) {
+  auto values = data.data();
+  for( Index u = 0 ; u < f_number_units ; ++u ) {
+   auto unit = get_unit_block( u );
+   for( Index s = 0 ; s < unit->get_number_storages() ; ++s ) {
+    set( unit->get_storage( s ) , values , f_time_horizon );
+    values += f_time_horizon;
+   }
+  }
+ }
+
+ // the node injection Variable of the NetworkBlock; the slice of a
+ // missing NetworkBlock is skipped, its extent being known from
+ // v_start_network_intervals
+ auto first_nb = std::find_if( v_network_blocks.begin() ,
+                               v_network_blocks.end() ,
+                               []( NetworkBlock * nb ) {
+                                return( nb != nullptr ); } );
+ if( first_nb != v_network_blocks.end() ) {
+  const Index number_nodes = ( *first_nb )->get_number_nodes();
+  if( auto data = read( "NodeInjection" , f_time_horizon * number_nodes ) ;
+      ! data.empty() ) {
+   auto values = data.data();
+   for( Index n = 0 ; n < v_network_blocks.size() ; ++n ) {
+    auto nb = v_network_blocks[ n ];
+    if( ! nb ) {
+     if( n + 1 >= v_start_network_intervals.size() )
+      throw( std::logic_error( "UCBlock::deserialize_solution: the extent "
+                               "of NetworkBlock " + std::to_string( n ) +
+                               " is unknown" ) );
+     values += ( v_start_network_intervals[ n + 1 ] -
+                 v_start_network_intervals[ n ] ) * number_nodes;
+     continue;
+    }
+    for( Index i = 0 ; i < nb->get_number_intervals() ; ++i ) {
+     set( nb->get_node_injection( i ) , values , number_nodes );
+     values += number_nodes;
+    }
+   }
+  }
+ }
+
+ if( ! duals )
+  return;
+
+ // the dual values of the linking constraints
+ auto set_duals = [ & read ]( const std::string & name ,
+                              boost::multi_array< FRowConstraint , 2 > &
+                               rows ) {
+  if( ! rows.num_elements() )
+   return;
+  auto data = read( name , rows.num_elements() );
+  for( Index i = 0 ; i < data.size() ; ++i )
+   if( ! std::isnan( data[ i ] ) )
+    rows.data()[ i ].set_dual( data[ i ] );
+ };
+
+ set_duals( "NodeInjectionDual" , v_node_injection_Const );
+ set_duals( "PrimaryDemandDual" , v_PrimaryDemand_Const );
+ set_duals( "SecondaryDemandDual" , v_SecondaryDemand_Const );
+ set_duals( "InertiaDemandDual" , v_InertiaDemand_Const );
+
+}  // end( UCBlock::deserialize_solution )
+
+/*--------------------------------------------------------------------------*/
+/*------------------- METHODS FOR HANDLING INSTANCE VARIANTS ---------------*/
+/*--------------------------------------------------------------------------*/
+
+void UCBlock::apply_delta( const netCDF::NcGroup & delta ,
+                           ModParam issuePMod , ModParam issueAMod )
+{
+ // the data are changed, hence they are no longer the validated ones
+ f_validated = false;
+
+ // read a delta variable, and its "Start" attribute
+ auto read = []( const netCDF::NcVar & var , Index & start ) {
+  if( var.getDimCount() != 1 )
+   throw( std::invalid_argument( "UCBlock::apply_delta: " + var.getName() +
+                                 " is not one-dimensional" ) );
+  std::vector< double > data( var.getDim( 0 ).getSize() );
+  var.getVar( data.data() );
+  // any integer type is read as a 64-bit one, so that also the deltas
+  // written with an int "Start" are read
+  long long s = 0;
+  if( var.getAtts().count( "Start" ) )
+   var.getAtt( "Start" ).getValues( & s );
+  if( s < 0 )
+   throw( std::invalid_argument( "UCBlock::apply_delta: " + var.getName() +
+                                 " has negative Start" ) );
+  if( ( unsigned long long )( s ) > std::numeric_limits< Index >::max() )
+   throw( std::invalid_argument( "UCBlock::apply_delta: " + var.getName() +
+                                 " has too large Start" ) );
+  start = Index( s );
+  return( data );
+ };
+
+ // check that [ start , start + n ) is within an array of the given size
+ auto check = []( const std::string & name , Index start , Index n ,
+                  Index size ) {
+  if( ( start > size ) || ( n > size - start ) )  // no overflow
+   throw( std::invalid_argument( "UCBlock::apply_delta: " + name +
+                                 " does not fit the base array" ) );
+ };
+
+ for( const auto & [ name , var ] : delta.getVars() ) {
+  if( name != "ActivePowerDemand" )
+   throw( std::invalid_argument( "UCBlock::apply_delta: unsupported "
+                                 "variable " + name ) );
+  Index start;
+  const auto data = read( var , start );
+  check( name , start , data.size() , get_number_nodes() * f_time_horizon );
+  set_active_power_demand( data.cbegin() ,
+                           Range( start , start + data.size() ) ,
+                           issuePMod , issueAMod );
+ }
+
+ // the set_*() methods called by the delta variables of each UnitBlock
+ using ThermalSet = void ( ThermalUnitBlock::* )( MF_dbl_it , Range ,
+                                                  ModParam , ModParam );
+ using IntermittentSet = void ( IntermittentUnitBlock::* )( MF_dbl_it ,
+                                                            Range ,
+                                                            ModParam ,
+                                                            ModParam );
+ using HydroSet = void ( HydroUnitBlock::* )( MF_dbl_it , Range ,
+                                              ModParam , ModParam );
+ using BatterySet = void ( BatteryUnitBlock::* )( MF_dbl_it , Range ,
+                                                  ModParam , ModParam );
+
+ static const std::map< std::string , ThermalSet > thermal_set = {
+  { "MaxPower" , & ThermalUnitBlock::set_maximum_power } ,
+  { "Availability" , & ThermalUnitBlock::set_availability } ,
+  { "LinearTerm" , & ThermalUnitBlock::set_linear_term } ,
+  { "QuadTerm" , & ThermalUnitBlock::set_quad_term } ,
+  { "ConstTerm" , & ThermalUnitBlock::set_const_term } ,
+  { "StartUpCost" , & ThermalUnitBlock::set_startup_costs } ,
+  { "InitialPower" , & ThermalUnitBlock::set_initial_power } };
+
+ static const std::map< std::string , IntermittentSet > intermittent_set = {
+  { "MaxPower" , & IntermittentUnitBlock::set_maximum_power } ,
+  { "Kappa" , & IntermittentUnitBlock::set_kappa } };
+
+ static const std::map< std::string , HydroSet > hydro_set = {
+  { "Inflows" , & HydroUnitBlock::set_inflow } };
+
+ static const std::map< std::string , BatterySet > battery_set = {
+  { "InitialStorage" , & BatteryUnitBlock::set_initial_storage } ,
+  { "InitialPower" , & BatteryUnitBlock::set_initial_power } ,
+  { "Kappa" , & BatteryUnitBlock::set_kappa } };
+
+ // call the set_*() method of unit corresponding to the delta variable
+ // name, if any, after checking it against the extent of its base array,
+ // the unit having the given number of reservoirs
+ auto set = [ & ]( auto * unit , const auto & setters ,
+                   const std::string & name , const DeltaVars & vars ,
+                   const std::vector< double > & data , Index start ,
+                   Index reservoirs ) {
+  auto it = setters.find( name );
+  if( ( ! unit ) || ( it == setters.end() ) )
+   return( false );
+  Index extent = 1;
+  for( const auto & var : vars )
+   if( var.first == name ) {
+    if( var.second == eDeltaProfile )
+     extent = f_time_horizon;
+    else if( var.second == eDeltaReservoirs )
+     extent = f_time_horizon * reservoirs;
+   }
+  check( name , start , data.size() , extent );
+  ( unit->*( it->second ) )( data.cbegin() ,
+                             Range( start , start + data.size() ) ,
+                             issuePMod , issueAMod );
+  return( true );
+ };
+
+ const std::string prefix = "UnitBlock_";
+ for( const auto & [ group_name , group ] : delta.getGroups() ) {
+  if( group_name.compare( 0 , prefix.size() , prefix ) != 0 )
+   throw( std::invalid_argument( "UCBlock::apply_delta: unsupported "
+                                 "group " + group_name ) );
+  const auto u = std::strtoul( group_name.c_str() + prefix.size() ,
+                               nullptr , 10 );
+  if( u >= f_number_units )
+   throw( std::invalid_argument( "UCBlock::apply_delta: no " +
+                                 group_name + " in the UCBlock" ) );
+
+  auto unit = get_unit_block( u );
+  auto vars_it = delta_unit_vars.find( unit->classname() );
+  const DeltaVars no_vars;
+  const auto & vars = vars_it == delta_unit_vars.end() ? no_vars
+                                                        : vars_it->second;
+  const auto hydro = dynamic_cast< HydroUnitBlock * >( unit );
+  const Index R = hydro ? hydro->get_number_reservoirs() : 0;
+
+  for( const auto & [ name , var ] : group.getVars() ) {
+   Index start;
+   const auto data = read( var , start );
+   if( ! ( set( dynamic_cast< ThermalUnitBlock * >( unit ) , thermal_set ,
+                name , vars , data , start , R ) ||
+           set( dynamic_cast< IntermittentUnitBlock * >( unit ) ,
+                intermittent_set , name , vars , data , start , R ) ||
+           set( hydro , hydro_set , name , vars , data , start , R ) ||
+           set( dynamic_cast< BatteryUnitBlock * >( unit ) , battery_set ,
+                name , vars , data , start , R ) ) )
+    throw( std::invalid_argument( "UCBlock::apply_delta: " + name +
+                                  " not supported for " + group_name ) );
+  }
+ }
+}  // end( UCBlock::apply_delta )
+
+/*--------------------------------------------------------------------------*/
+
+void UCBlock::serialize_delta( const netCDF::NcGroup & base ,
+                               const netCDF::NcGroup & variant ,
+                               netCDF::NcGroup & delta )
+{
+ Index time_horizon = 1;
+ if( auto dim = variant.getDim( "TimeHorizon" ) ; ! dim.isNull() )
+  time_horizon = dim.getSize();
+
+ // read a whole variable, with a time profile given as a single value
+ // expanded to the whole TimeHorizon
+ auto read = [ time_horizon ]( const netCDF::NcVar & var , bool profile ) {
+  std::size_t n = 1;
+  for( const auto & d : var.getDims() )
+   n *= d.getSize();
+  std::vector< double > data( n );
+  var.getVar( data.data() );
+  if( profile && ( n == 1 ) )
+   data.resize( time_horizon , data.front() );
+  return( data );
+ };
+
+ // put into data the smallest slice of the variable name of to that
+ // differs from that of from, and return its start
+ auto slice = [ & read ]( const netCDF::NcGroup & from ,
+                          const netCDF::NcGroup & to ,
+                          const std::string & name , bool profile ,
+                          std::vector< double > & data ) -> Index {
+  data.clear();
+  auto to_var = to.getVar( name );
+  auto from_var = from.getVar( name );
+  if( to_var.isNull() ) {
+   if( ! from_var.isNull() )
+    throw( std::invalid_argument( "UCBlock::serialize_delta: " + name +
+                                  " is in the base but not in the variant,"
+                                  " which a delta cannot express" ) );
+   return( 0 );
+  }
+  data = read( to_var , profile );
+  if( from_var.isNull() )
+   return( 0 );
+  const auto old = read( from_var , profile );
+  if( old.size() != data.size() )
+   throw( std::invalid_argument( "UCBlock::serialize_delta: " + name +
+                                 " has a different size in the base" ) );
+  Index first = 0;
+  Index last = data.size();
+  while( ( first < last ) && ( data[ first ] == old[ first ] ) )
+   ++first;
+  while( ( last > first ) && ( data[ last - 1 ] == old[ last - 1 ] ) )
+   --last;
+  data.erase( data.begin() + last , data.end() );
+  data.erase( data.begin() , data.begin() + first );
+  return( first );
+ };
+
+ // write a slice as a delta variable
+ auto write = []( netCDF::NcGroup & group , const std::string & name ,
+                  const std::vector< double > & data , Index start ) {
+  auto dim = group.addDim( name + "Size" , data.size() );
+  auto var = group.addVar( name , netCDF::NcDouble() , dim );
+  if( start )
+   var.putAtt( "Start" , netCDF::NcUint64() ,
+               ( unsigned long long )( start ) );
+  var.putVar( data.data() );
+ };
+
+ std::vector< double > data;
+
+ if( auto start = slice( base , variant , "ActivePowerDemand" , false ,
+                         data ) ; ! data.empty() )
+  write( delta , "ActivePowerDemand" , data , start );
+
+ const std::string prefix = "UnitBlock_";
+ auto count_units = [ & prefix ]( const netCDF::NcGroup & group ) {
+  Index n = 0;
+  for( const auto & sub : group.getGroups() )
+   if( sub.first.compare( 0 , prefix.size() , prefix ) == 0 )
+    ++n;
+  return( n );
+ };
+
+ if( count_units( base ) != count_units( variant ) )
+  throw( std::invalid_argument( "UCBlock::serialize_delta: different "
+                                "UnitBlock in the base" ) );
+
+ for( const auto & [ group_name , group ] : variant.getGroups() ) {
+  if( group_name.compare( 0 , prefix.size() , prefix ) != 0 )
+   continue;
+
+  const auto base_group = base.getGroup( group_name );
+  if( base_group.isNull() )
+   throw( std::invalid_argument( "UCBlock::serialize_delta: no " +
+                                 group_name + " in the base" ) );
+
+  std::string type;
+  if( auto att = group.getAtt( "type" ) ; ! att.isNull() )
+   att.getValues( type );
+  auto vars = delta_unit_vars.find( type );
+  if( vars == delta_unit_vars.end() )
+   continue;
+
+  netCDF::NcGroup unit_delta;
+  for( const auto & [ name , size ] : vars->second ) {
+   const auto start = slice( base_group , group , name ,
+                             size == eDeltaProfile , data );
+   if( data.empty() )
+    continue;
+   if( unit_delta.isNull() )
+    unit_delta = delta.addGroup( group_name );
+   write( unit_delta , name , data , start );
+  }
+ }
+}  // end( UCBlock::serialize_delta )
+
+/*--------------------------------------------------------------------------*/
+
+UCBlock * UCBlock::new_from_delta( const std::string & filename )
+{
+ netCDF::NcFile delta( filename , netCDF::NcFile::read );
+
+ auto string_att = [ & delta ]( const std::string & name ,
+                                std::string value ) {
+  if( auto att = delta.getAtt( name ) ; ! att.isNull() )
+   att.getValues( value );
+  return( value );
+ };
+
+ auto base_name = string_att( "BaseFile" , "" );
+ if( base_name.empty() )
+  throw( std::invalid_argument( "UCBlock::new_from_delta: no BaseFile in "
+                                + filename ) );
+ if( base_name.front() != '/' ) {
+  const auto pos = filename.find_last_of( '/' );
+  if( pos != std::string::npos )
+   base_name = filename.substr( 0 , pos + 1 ) + base_name;
+ }
+ const auto group_name = string_att( "BaseGroup" , "Block_0" );
+
+ std::unique_ptr< UCBlock > block;
+ {
+  netCDF::NcFile base( base_name , netCDF::NcFile::read );
+  auto group = base.getGroup( group_name );
+  if( group.isNull() )
+   throw( std::invalid_argument( "UCBlock::new_from_delta: no " +
+                                 group_name + " in " + base_name ) );
+  auto b = Block::new_Block( group );
+  block.reset( dynamic_cast< UCBlock * >( b ) );
+  if( ! block ) {
+   delete( b );
+   throw( std::invalid_argument( "UCBlock::new_from_delta: " + group_name +
+                                 " in " + base_name + " is not a UCBlock" ) );
+  }
+ }
+
+ block->apply_delta( delta );
+ return( block.release() );
+
+}  // end( UCBlock::new_from_delta )
+
+/*--------------------------------------------------------------------------*/
+/*--------------------- METHODS FOR CLONING THE UCBlock --------------------*/
+/*--------------------------------------------------------------------------*/
+
+UCBlock * UCBlock::clone( Block * father ) const
+{
+ // the destructor of UCBlock takes care of whatever has already been
+ // copied, should anything throw
+ auto block = std::make_unique< UCBlock >( father );
+
+ if( f_BlockConfig )
+  block->f_BlockConfig = static_cast< BlockConfig * >(
+   f_BlockConfig->clone() );
+
+ block->f_time_horizon = f_time_horizon;
+ block->network_block_classname = network_block_classname;
+ block->network_data_classname = network_data_classname;
+ block->f_number_networks = f_number_networks;
+ block->f_number_units = f_number_units;
+ block->f_validated = f_validated;
+ block->f_number_elc_generators = f_number_elc_generators;
+ block->f_number_heat_generators = f_number_heat_generators;
+ block->f_total_number_pollutant_zones = f_total_number_pollutant_zones;
+ block->f_number_heat_blocks = f_number_heat_blocks;
+ block->f_number_primary_zones = f_number_primary_zones;
+ block->f_number_secondary_zones = f_number_secondary_zones;
+ block->f_number_inertia_zones = f_number_inertia_zones;
+ block->f_number_pollutants = f_number_pollutants;
+
+ block->v_start_network_intervals = v_start_network_intervals;
+ block->v_network_constant_terms = v_network_constant_terms;
+ block->v_number_pollutant_zones = v_number_pollutant_zones;
+ copy_multi_array( block->v_pollutant_zones , v_pollutant_zones );
+ copy_multi_array( block->v_active_power_demand , v_active_power_demand );
+ block->v_primary_zones = v_primary_zones;
+ copy_multi_array( block->v_primary_demand , v_primary_demand );
+ block->v_secondary_zones = v_secondary_zones;
+ copy_multi_array( block->v_secondary_demand , v_secondary_demand );
+ block->v_inertia_zones = v_inertia_zones;
+ copy_multi_array( block->v_inertia_demand , v_inertia_demand );
+ block->v_pollutant_budget = v_pollutant_budget;
+ copy_multi_array( block->v_pollutant_rho , v_pollutant_rho );
+ copy_multi_array( block->v_pollutant_heat_rho , v_pollutant_heat_rho );
+ block->v_generator_node = v_generator_node;
+ block->v_heat_node = v_heat_node;
+ block->v_heat_set = v_heat_set;
+ block->v_power_heat_rho = v_power_heat_rho;
+
+ if( f_NetworkData )
+  block->f_NetworkData = f_NetworkData->clone();
+
+ // the sub-Block: the UnitBlock first, then the NetworkBlock, if any
+ block->v_Block.assign( v_Block.size() , nullptr );
+ for( Index i = 0 ; ( i < f_number_units ) && ( i < v_Block.size() ) ; ++i )
+  if( auto unit = get_unit_block( i ) )
+   block->v_Block[ i ] = unit->clone( block.get() );
+
+ block->v_network_blocks.assign( v_network_blocks.size() , nullptr );
+ for( Index n = 0 ; n < v_network_blocks.size() ; ++n ) {
+  auto network = v_network_blocks[ n ];
+  if( ! network )
+   continue;
+  auto copy = network->clone( block.get() );
+  if( f_number_units + n < v_Block.size() )
+   block->v_Block[ f_number_units + n ] = copy;
+  block->v_network_blocks[ n ] = copy;
+  // the NetworkData shared with the UCBlock is replaced by the copy
+  if( f_NetworkData && ( network->get_NetworkData() == f_NetworkData ) )
+   copy->set_NetworkData( block->f_NetworkData );
+ }
+
+ return( block.release() );
+
+}  // end( UCBlock::clone )
+
+/*--------------------------------------------------------------------------*/
+/*------------------------ METHODS FOR CHANGING DATA -----------------------*/
+/*--------------------------------------------------------------------------*/
+
+void UCBlock::add_Modification( sp_Mod mod , ChnlName chnl )
+{
+ if( auto epoch = f_staging_epoch.load( std::memory_order_acquire ) ) {
+  stage_Modification( std::move( mod ) , chnl , epoch );
+  return;
+ }
+
+ UCBLOCK_TRACE_SPAN( "UCBlock::add_Modification" );
+
+ std::vector< Index > modified_units;
+
+ // TODO Handle GroupModification in order to deal with multiple UnitBlockMod
+ // at the same time.
+
+ if( const auto tmod = dynamic_cast< UnitBlockMod * >( mod.get() ) ) {
+  if( tmod->type() == UnitBlockMod::eScale ) {
+   auto unit_id = inspection::get_block_index( tmod->get_Block() );
+   modified_units.push_back( unit_id );
+  }
+ }
+
+ if( ! modified_units.empty() ) {
+  // Sort the IDs of the modified units
+  std::sort( modified_units.begin() , modified_units.end() );
+
+  update_node_injection_constraints( modified_units );
+  update_primary_demand_constraints( modified_units );
+  update_secondary_demand_constraints( modified_units );
+  update_inertia_demand_constraints( modified_units );
+
+  // TODO Implement the following methods when their constraints have been
+  // properly implemented.
+
+  // update_pollutant_budget_constraints( modified_units );
+  // update_heat_constraints( modified_units );
+ }
+
+ Block::add_Modification( mod , chnl );
+}
+
+/*--------------------------------------------------------------------------*/
+
+void UCBlock::begin_concurrent_updates( void )
+{
+ // the ids of the sessions are unique among all the UCBlock, so that the
+ // buffer cached by a thread can never be mistaken for one of another
+ // session, even of another UCBlock at the same address
+ static std::atomic< std::uint64_t > last_epoch( 0 );
+
+ std::lock_guard< std::mutex > lock( f_staging_mutex );
+ if( ! f_staging_epoch.load( std::memory_order_relaxed ) )
+  f_staging_epoch.store( ++last_epoch , std::memory_order_release );
+}
+
+/*--------------------------------------------------------------------------*/
+
+void UCBlock::end_concurrent_updates( void )
+{
+ UCBLOCK_TRACE_SPAN( "UCBlock::end_concurrent_updates" );
+
+ decltype( v_staging ) staging;
+ {
+  std::lock_guard< std::mutex > lock( f_staging_mutex );
+  f_staging_epoch.store( 0 , std::memory_order_release );
+  staging.swap( v_staging );
+ }
+
+ for( auto & buffer : staging )
+  for( auto & [ mod , chnl ] : *buffer )
+   add_Modification( std::move( mod ) , chnl );
+}
+
+/*--------------------------------------------------------------------------*/
+
+void UCBlock::stage_Modification( sp_Mod mod , ChnlName chnl ,
+                                  std::uint64_t epoch )
+{
+ // the buffer of the calling thread for the session epoch, if any
+ thread_local std::uint64_t cached_epoch = 0;
+ thread_local std::vector< StagedMod > * cached_buffer = nullptr;
+
+ if( cached_epoch != epoch ) {
+  std::lock_guard< std::mutex > lock( f_staging_mutex );
+  v_staging.push_back( std::make_unique< std::vector< StagedMod > >() );
+  cached_buffer = v_staging.back().get();
+  cached_epoch = epoch;
+ }
+
+ cached_buffer->emplace_back( std::move( mod ) , chnl );
+}
+
+/*--------------------------------------------------------------------------*/
+
+void UCBlock::update_node_injection_constraints(
+ const std::vector< Index > & modified_units )
+{
+ if( ( ! constraints_generated() ) ||
+     ( v_node_injection_Const.empty() ) || modified_units.empty() )
   return;
 
  // Lambda for determining if some unit has been modified
@@ -1879,133 +4242,52 @@ void UCBlock::update_inertia_demand_constraints(
      modified_units.empty() )
   return;  // there is nothing to be updated
 
- // Indices of the zones that are affected by the modified units.
- std::set< Index > affected_zones;
+ std::vector< bool > is_modified( f_number_units , false );
+ for( const auto unit_id : modified_units )
+  is_modified[ unit_id ] = true;
 
- // Number of modified generators in each zone.
- std::vector< Index > num_generators_per_zone( f_number_inertia_zones , 0 );
+ // For each zone, collect from the descriptor table the terms of the
+ // modified units: their position in the LinearFunction, the base of the
+ // vector of coefficients and the scale factor of the UnitBlock.
 
- // Collect the affected zones and count the number of affected generators in
- // each zone.
+ for( Index zone_id = 0 ; zone_id < f_number_inertia_zones ; ++zone_id ) {
 
- Index elc_generator = 0;
- Index overall_unit_id = 0;
- for( const auto unit_id : modified_units ) {
+  const auto first = v_inertia_zone_start[ zone_id ];
+  const auto last = v_inertia_zone_start[ zone_id + 1 ];
 
-  // Skip the units that have not been modified.
-  while( overall_unit_id < unit_id ) {
-   elc_generator += get_unit_block( overall_unit_id )->get_number_generators();
-   ++overall_unit_id;
-  }
+  Subset position;
+  std::vector< const double * > coeff;
+  std::vector< double > scale;
 
-  const auto unit_block = get_unit_block( unit_id );
-  const auto num_generators = unit_block->get_number_generators();
+  for( Index i = first ; i < last ; ++i ) {
+   const auto & term = v_inertia_terms[ i ];
+   if( ! is_modified[ term.unit ] )
+    continue;
 
-  for( Index g = 0 ; g < num_generators ; ++g , ++elc_generator ) {
-   const auto zone = get_inertia_zone( elc_generator );
-   affected_zones.insert( zone );
-   ++num_generators_per_zone[ zone ];
+   const auto unit_block = get_unit_block( term.unit );
+   position.push_back( i - first );
+   scale.push_back( unit_block->get_scale() );
+   coeff.push_back( term.power ?
+                    unit_block->get_inertia_power( term.generator ) :
+                    unit_block->get_inertia_commitment( term.generator ) );
   }
 
-  ++overall_unit_id;
- }
-
- const auto number_nodes = get_number_nodes();
-
- // Now loop over all affected constraints
-
- for( Index t = 0 ; t < f_time_horizon ; ++t ) {
-  for( const auto zone_id : affected_zones ) {
+  if( position.empty() )
+   continue;  // no modified unit in this zone
 
+  for( Index t = 0 ; t < f_time_horizon ; ++t ) {
    auto & constraint = v_InertiaDemand_Const[ t ][ zone_id ];
 
-   // This will store the coefficients that must be updated, i.e., those of
-   // the active Variables that belong to the units that have been modified.
-   LinearFunction::Vec_FunctionValue coefficients;
-   coefficients.reserve( num_generators_per_zone[ zone_id ] );
-
-   // Subset that will store the indices of the active Variables whose
-   // coefficients have changed.
-   Subset subset;
-   subset.reserve( num_generators_per_zone[ zone_id ] );
-
-   for( Index node_id = 0 ; node_id < number_nodes ; ++node_id ) {
-
-    if( ! node_belongs_to_inertia_zone( node_id , zone_id ) )
-     continue;
-
-    Index elc_generator = 0;
-    Index overall_unit_id = 0;
-    for( const auto unit_id : modified_units ) {
-
-     // Skip the units that have not been modified.
-     while( overall_unit_id < unit_id ) {
-      elc_generator += get_unit_block(
-       overall_unit_id )->get_number_generators();
-      ++overall_unit_id;
-     }
-
-     const auto unit_block = get_unit_block( unit_id );
-
-     if( inertia_var_index[ unit_id ][ zone_id ] == Inf< Index >() ) {
-      // This unit has no active Variable in the inertia demand constraints
-      // associated with zone "zone_id".
-      elc_generator += unit_block->get_number_generators();
-      ++overall_unit_id;
-      continue;
-     }
+   LinearFunction::Vec_FunctionValue coefficients( position.size() );
+   for( Index j = 0 ; j < position.size() ; ++j )
+    coefficients[ j ] = scale[ j ] * coeff[ j ][ t ];
 
-     const auto scale = unit_block->get_scale();
-     const auto num_generators = unit_block->get_number_generators();
-     auto next_var_index = inertia_var_index[ unit_id ][ zone_id ];
-
-     for( Index generator = 0 ;
-          generator < num_generators ; ++generator , ++elc_generator ) {
-
-      if( ! generator_belongs_to_node( elc_generator , node_id ) )
-       continue;
-
-      const auto commitment = unit_block->get_commitment( generator );
-      auto inertia_commitment = unit_block->get_inertia_commitment( generator );
-
-      if( commitment && inertia_commitment ) {
-
-       assert( next_var_index < constraint.get_num_active_var() );
-       assert( constraint.get_active_var( next_var_index )->get_Block()
-               == unit_block );
-
-       const auto coefficient = scale * inertia_commitment[ t ];
-       coefficients.push_back( coefficient );
-       subset.push_back( next_var_index++ );
-      }
-
-      const auto active_power = unit_block->get_active_power( generator );
-      const auto inertia_power = unit_block->get_inertia_power( generator );
-
-      if( active_power && inertia_power ) {
-       assert( next_var_index < constraint.get_num_active_var() );
-       assert( constraint.get_active_var( next_var_index )->get_Block()
-               == unit_block );
-
-       const auto coefficient = scale * inertia_power[ t ];
-       coefficients.push_back( coefficient );
-       subset.push_back( next_var_index++ );
-      }
-
-     }  // end( for( generator ) )
-
-     ++overall_unit_id;
-
-    }  // end( for( unit_id ) )
-
-    // Update the coefficients of the active variables
-    static_cast< LinearFunction * >( constraint.get_function() )->
-     modify_coefficients( std::move( coefficients ) , std::move( subset ) ,
-                          true , eNoBlck );
-
-   }  // end( for( node_id ) )
-  }  // end( for( zone_id ) )
- }  // end( for( t ) )
+   // Update the coefficients of the active variables
+   static_cast< LinearFunction * >( constraint.get_function() )->
+    modify_coefficients( std::move( coefficients ) , Subset( position ) ,
+                         true , eNoBlck );
+  }
+ }  // end( for( zone_id ) )
 
 }  // end( UCBlock::update_inertia_demand_constraints )
 
@@ -0,0 +1,113 @@
+/*--------------------------------------------------------------------------*/
+/*-------------------------- File UCTrace.cpp ------------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ * Implementation of the UCTrace class.
+ *
+ * \author The UCBlock contributors
+ *
+ * \copyright &copy; by the UCBlock contributors
+ */
+/*--------------------------------------------------------------------------*/
+/*---------------------------- IMPLEMENTATION ------------------------------*/
+/*--------------------------------------------------------------------------*/
+/*------------------------------ INCLUDES ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+#include <algorithm>
+
+#include "UCTrace.h"
+
+/*--------------------------------------------------------------------------*/
+/*------------------------- NAMESPACE AND USING ----------------------------*/
+/*--------------------------------------------------------------------------*/
+
+using namespace SMSpp_di_unipi_it;
+
+/*--------------------------------------------------------------------------*/
+/*----------------------------- STATIC MEMBERS -----------------------------*/
+/*--------------------------------------------------------------------------*/
+
+std::atomic< bool > UCTrace::f_enabled{ true };
+
+std::atomic< std::uint64_t > UCTrace::f_next{ 0 };
+
+std::vector< UCTrace::Event > UCTrace::f_buffer( 65536 );
+
+const std::chrono::steady_clock::time_point UCTrace::f_origin =
+ std::chrono::steady_clock::now();
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------- METHODS OF UCTrace ---------------------------*/
+/*--------------------------------------------------------------------------*/
+
+void UCTrace::set_capacity( std::size_t capacity )
+{
+ f_buffer.assign( std::max( capacity , std::size_t( 1 ) ) , Event{} );
+ clear();
+ }
+
+/*--------------------------------------------------------------------------*/
+
+std::uint64_t UCTrace::dropped( void )
+{
+ auto next = f_next.load();
+ return( next > f_buffer.size() ? next - f_buffer.size() : 0 );
+ }
+
+/*--------------------------------------------------------------------------*/
+
+void UCTrace::record( const char * name , std::uint64_t begin ,
+                      std::uint64_t end )
+{
+ static std::atomic< std::uint32_t > threads{ 0 };
+ thread_local const std::uint32_t tid = threads++;
+
+ auto i = f_next.fetch_add( 1 , std::memory_order_relaxed );
+ f_buffer[ i % f_buffer.size() ] = { name , begin , end - begin , tid };
+ }
+
+/*--------------------------------------------------------------------------*/
+
+std::vector< UCTrace::Event > UCTrace::events( void )
+{
+ auto next = f_next.load();
+ auto size = f_buffer.size();
+ if( next <= size )
+  return( std::vector< Event >( f_buffer.begin() ,
+                                f_buffer.begin() + next ) );
+
+ // the buffer has wrapped around: the oldest span is at next % size
+ std::vector< Event > evts;
+ evts.reserve( size );
+ auto first = f_buffer.begin() + next % size;
+ evts.insert( evts.end() , first , f_buffer.end() );
+ evts.insert( evts.end() , f_buffer.begin() , first );
+ return( evts );
+ }
+
+/*--------------------------------------------------------------------------*/
+
+void UCTrace::write_json( std::ostream & out )
+{
+ const auto evts = events();
+
+ auto flags = out.flags();
+ out << std::fixed;
+ auto precision = out.precision( 3 );
+
+ out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+ for( std::size_t i = 0 ; i < evts.size() ; ++i )
+  out << ( i ? ",\n" : "\n" ) << " {\"name\": \"" << evts[ i ].name
+      << "\", \"cat\": \"UCBlock\", \"ph\": \"X\", \"pid\": 1, \"tid\": "
+      << evts[ i ].tid << ", \"ts\": " << evts[ i ].ts / 1e3
+      << ", \"dur\": " << evts[ i ].dur / 1e3 << "}";
+ out << "\n]}\n";
+
+ out.precision( precision );
+ out.flags( flags );
+ }
+
+/*--------------------------------------------------------------------------*/
+/*------------------------ End File UCTrace.cpp ----------------------------*/
+/*--------------------------------------------------------------------------*/
@@ -39,6 +39,8 @@
 
 #include "ColVariableSolution.h"
 
+#include <typeinfo>
+
 /*--------------------------------------------------------------------------*/
 /*------------------------- NAMESPACE AND USING ----------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -127,6 +129,39 @@ void UnitBlock::deserialize_change_intervals( const netCDF::NcGroup & group )
 
 /*--------------------------------------------------------------------------*/
 
+bool UnitBlock::validated_data( void ) const
+{
+ for( auto f_B = get_f_Block() ; f_B ; f_B = f_B->get_f_Block() )
+  if( auto uc = dynamic_cast< const UCBlock * >( f_B ) )
+   return( uc->is_validated() );
+ return( false );
+}
+
+/*--------------------------------------------------------------------------*/
+
+UnitBlock::ChnlName UnitBlock::open_packing_channel( ModParam issueAMod )
+{
+ for( auto f_B = get_f_Block() ; f_B ; f_B = f_B->get_f_Block() )
+  if( auto uc = dynamic_cast< const UCBlock * >( f_B ) ) {
+   if( uc->concurrent_updates_open() )
+    return( par2chnl( issueAMod ) );
+   break;
+   }
+
+ return( open_channel( par2chnl( issueAMod ) ) );
+}
+
+/*--------------------------------------------------------------------------*/
+
+void UnitBlock::close_packing_channel( ChnlName chnl , ModParam issueAMod )
+{
+ // no channel has been opened if the one of the caller has been returned
+ if( chnl != par2chnl( issueAMod ) )
+  close_channel( chnl );
+}
+
+/*--------------------------------------------------------------------------*/
+
 void UnitBlock::deserialize( const netCDF::NcGroup & group )
 {
  Block::deserialize( group );
@@ -135,6 +170,30 @@ void UnitBlock::deserialize( const netCDF::NcGroup & group )
  deserialize_change_intervals( group );
 }
 
+/*--------------------------------------------------------------------------*/
+
+UnitBlock * UnitBlock::clone( Block * father ) const
+{
+ if( typeid( *this ) != typeid( UnitBlock ) )
+  throw( std::logic_error( classname() + "::clone: not implemented" ) );
+
+ auto unit = std::make_unique< UnitBlock >( father );
+ unit->clone_data( *this );
+ return( unit.release() );
+}
+
+/*--------------------------------------------------------------------------*/
+
+void UnitBlock::clone_data( const UnitBlock & from )
+{
+ if( from.f_BlockConfig )
+  f_BlockConfig = static_cast< BlockConfig * >( from.f_BlockConfig->clone() );
+ f_time_horizon = from.f_time_horizon;
+ f_number_intervals = from.f_number_intervals;
+ v_change_intervals = from.v_change_intervals;
+ reserve_vars = from.reserve_vars;
+}
+
 /*--------------------------------------------------------------------------*/
 /*------------------ METHODS FOR MODIFYING THE UnitBlock -------------------*/
 /*--------------------------------------------------------------------------*/
@@ -227,6 +286,23 @@ void UnitBlock::serialize( netCDF::NcGroup & group ) const
  }
 }
 
+/*--------------------------------------------------------------------------*/
+
+MemoryUsage UnitBlock::get_memory_usage( void ) const
+{
+ MemoryUsage usage;
+ usage.add_abstract( this );
+ usage.add_data( v_change_intervals );
+
+ for( auto sub : get_nested_Blocks() )
+  if( auto unit = dynamic_cast< const UnitBlock * >( sub ) )
+   usage += unit->get_memory_usage();
+  else
+   usage += MemoryUsage::of_abstract( sub );
+
+ return( usage );
+}
+
 /*--------------------------------------------------------------------------*/
 /*---------------------- End File UnitBlock.cpp ----------------------------*/
 /*--------------------------------------------------------------------------*/
@@ -4,6 +4,15 @@
 /** @file
  * Small main() for constructing UCBlock netCDF files out of dat and mod ones.
  *
+ * Any number of files, and of directories (all the dat and mod files of
+ * which are taken), can be given; they can be converted in parallel by a
+ * pool of threads. Since the netCDF library is not thread-safe, the threads
+ * only run the parsing (which dominates the conversion time) in parallel,
+ * while all the netCDF calls are serialized. In "stream" mode a mod file is
+ * converted one unit at a time, i.e., each unit is written as soon as it has
+ * been read, so that the memory footprint does not depend on the number of
+ * units. The throughput, in files and units per second, is reported.
+ *
  * \author Antonio Frangioni \n
  *         Dipartimento di Informatica \n
  *         Universita' di Pisa \n
@@ -15,7 +24,13 @@
  * \copyright &copy; by Antonio Frangioni, Niccolo' Iardella
  */
 
+#include <atomic>
+#include <chrono>
+#include <filesystem>
 #include <iomanip>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <getopt.h>
 
 #include <SMSTypedefs.h>
@@ -344,6 +359,36 @@ struct ModFile
  /// Loads the data from a MOD file
  void load( std::istream & in ) {
   std::string skip;
+
+  load_header( in );
+
+  // "ThermalSection"
+  in >> skip;
+  thermal_units.resize( NumThermal );
+  for( unsigned int i = 0 ; i < NumThermal ; ++i ) {
+   thermal_units[ i ].load( in );
+  }
+
+  // "HydroSection"
+  in >> skip;
+  hydro_units.resize( NumHydro );
+  for( unsigned int i = 0 ; i < NumHydro ; ++i ) {
+   hydro_units[ i ].inflows.resize( TimeHorizon );
+   hydro_units[ i ].load( in );
+  }
+
+  // "HydroCascadeSection"
+  in >> skip;
+  hydro_cascade_units.resize( NumCascade );
+  for( unsigned int i = 0 ; i < NumCascade ; ++i ) {}
+ }
+
+ /// Loads the part of a MOD file that comes before the units
+ /** This is the sizes and the load curve, i.e., everything that is needed
+  * to write the UCBlock proper. The stream is left at the "ThermalSection"
+  * keyword, so that the units can then be read one at a time. */
+ void load_header( std::istream & in ) {
+  std::string skip;
   int rows , columns , elements;
 
   in >> skip >> ProblemNum;
@@ -374,26 +419,6 @@ struct ModFile
   for( int e = 0 ; e < elements ; ++e ) {
    in >> load_curve.SpinningReserve[ e ];
   }
-
-  // "ThermalSection"
-  in >> skip;
-  thermal_units.resize( NumThermal );
-  for( unsigned int i = 0 ; i < NumThermal ; ++i ) {
-   thermal_units[ i ].load( in );
-  }
-
-  // "HydroSection"
-  in >> skip;
-  hydro_units.resize( NumHydro );
-  for( unsigned int i = 0 ; i < NumHydro ; ++i ) {
-   hydro_units[ i ].inflows.resize( TimeHorizon );
-   hydro_units[ i ].load( in );
-  }
-
-  // "HydroCascadeSection"
-  in >> skip;
-  hydro_cascade_units.resize( NumCascade );
-  for( unsigned int i = 0 ; i < NumCascade ; ++i ) {}
  }
 
  /// Prints the data
@@ -463,16 +488,26 @@ enum filetype
 
 using namespace SMSpp_di_unipi_it;
 
-DatFile dat_file;
-ModFile mod_file;
-filetype type;
+std::vector< std::string > input_paths;  ///< input file names
+bool stream = false;          ///< if MOD files are converted unit by unit
+unsigned int jobs = 1;        ///< number of conversion threads
+bool verbose = false;         ///< if the tool should be verbose
+std::string exe{};            ///< name of the executable file
+std::string docopt_desc{};    ///< tool description
+
+/// serializes all the netCDF calls, since the library is not thread-safe
+std::mutex nc_mutex;
 
-std::vector< double > b;
-std::vector< double > c;
+/// serializes the output on std::cout / std::cerr
+std::mutex io_mutex;
 
 /*--------------------------------------------------------------------------*/
 
-void serialize_thermalunit( netCDF::NcGroup & g , const ThermalUnit & unit ) {
+/// Writes a thermal unit; b and c are the cost coefficients of a DAT file,
+/// empty for a MOD file
+void serialize_thermalunit( netCDF::NcGroup & g , const ThermalUnit & unit ,
+                            const std::vector< double > & b = {} ,
+                            const std::vector< double > & c = {} ) {
  serialize( g , "MinPower" , netCDF::NcDouble() , unit.MinPower );
  serialize( g , "MaxPower" , netCDF::NcDouble() , unit.MaxPower );
  serialize( g , "DeltaRampUp" , netCDF::NcDouble() , unit.DeltaRampUp );
@@ -480,7 +515,7 @@ void serialize_thermalunit( netCDF::NcGroup & g , const ThermalUnit & unit ) {
  serialize( g , "QuadTerm" , netCDF::NcDouble() , unit.QuadTerm );
  serialize( g , "StartUpCost" , netCDF::NcDouble() , unit.StartUpCost );
 
- if( type == ftDat ) {
+ if( ! b.empty() ) {  // DAT file
   auto NumberIntervals = g.getDim( "NumberIntervals" );
 
   if( b.size() == 1 ) {
@@ -495,7 +530,7 @@ void serialize_thermalunit( netCDF::NcGroup & g , const ThermalUnit & unit ) {
    serialize( g , "ConstTerm" , netCDF::NcDouble() , NumberIntervals , c );
   }
 
- } else {  // type == ftMod
+ } else {  // MOD file
   serialize( g , "LinearTerm" , netCDF::NcDouble() , unit.LinearTerm );
   serialize( g , "ConstTerm" , netCDF::NcDouble() , unit.ConstTerm );
  }
@@ -523,12 +558,184 @@ void serialize_hydrounit( netCDF::NcGroup & g , const HydroUnit & unit ) {
 
 /*--------------------------------------------------------------------------*/
 
+/// Writes the UCBlock proper of a MOD file, i.e., all but the units
+netCDF::NcGroup serialize_modheader( netCDF::NcFile & f ,
+                                     const ModFile & mod_file ) {
+ auto bg = f.addGroup( "Block_0" );
+ bg.putAtt( "type" , "UCBlock" );
+ bg.addDim( "TimeHorizon" , mod_file.TimeHorizon );
+ auto time_h = bg.getDim( "TimeHorizon" );
+ bg.addDim( "NumberUnits" , mod_file.NumThermal +
+                            mod_file.NumHydro +
+                            mod_file.NumCascade );
+ bg.addDim( "NumberIntervals" , 1 );
+
+ auto ng = bg.addGroup( "NetworkData" );
+ ng.addDim( "NumberNodes" , 1 );
+
+ serialize( bg ,
+            "ActivePowerDemand" ,
+            netCDF::NcDouble() ,
+            time_h ,
+            mod_file.load_curve.Loads[ 0 ] );
+
+ return( bg );
+}
 
-std::string input_path{};     ///< input file name
-std::string output_path{};    ///< input file name
-bool verbose = false;         ///< if the tool should be verbose
-std::string exe{};            ///< name of the executable file
-std::string docopt_desc{};    ///< tool description
+/*--------------------------------------------------------------------------*/
+
+/// Converts a DAT or MOD file into a .nc4 one, returns the number of units
+/** In stream mode a MOD file is read one unit at a time, and each unit is
+ * written as soon as it has been read, so that the memory footprint does
+ * not depend on the number of units. Otherwise, the whole file is read
+ * before anything is written. The parsing of different files can proceed
+ * in parallel, while the netCDF calls are serialized by nc_mutex. */
+unsigned int convert( const std::string & input_path ) {
+
+ // Check if input file can be opened
+ std::ifstream input_file( input_path );
+ if( ! input_file.is_open() ) {
+  throw( std::invalid_argument( "cannot open file " + input_path ) );
+ }
+
+ if( input_path.size() < 4 ) {
+  throw( std::invalid_argument( input_path + ": unsupported file format" ) );
+ }
+ std::string ext = input_path.substr( input_path.size() - 4 , 4 );
+ std::string dat( ".dat" );
+ std::string mod( ".mod" );
+ auto same = []( auto a , auto b ) {
+  return( std::tolower( a ) == std::tolower( b ) );
+ };
+
+ // Check input file type
+ filetype type;
+ if( std::equal( ext.begin() , ext.end() , dat.begin() , same ) ) {
+  type = ftDat;
+ } else if( std::equal( ext.begin() , ext.end() , mod.begin() , same ) ) {
+  type = ftMod;
+ } else {
+  throw( std::invalid_argument( input_path + ": supported file formats "
+                                "are: dat, mod" ) );
+ }
+
+ std::string output_path = input_path;
+ output_path.erase( output_path.size() - 4 , 4 );
+ output_path.append( ".nc4" );
+
+ // the file is created, and closed, under nc_mutex; open() must be called
+ // with nc_mutex locked, while closing (by f.reset() or by f going out of
+ // scope, possibly because of an exception) locks it
+ auto close = []( netCDF::NcFile * file ) {
+  std::lock_guard< std::mutex > lock( nc_mutex );
+  delete( file );
+ };
+ std::unique_ptr< netCDF::NcFile , decltype( close ) > f( nullptr , close );
+ auto open = [ & ]( void ) {
+  f.reset( new netCDF::NcFile( output_path , netCDF::NcFile::replace ) );
+  f->putAtt( "SMS++_file_type" , netCDF::NcInt() , eBlockFile );
+ };
+
+ unsigned int num_units = 0;
+
+ if( type == ftDat ) {
+  // Read DAT file
+  DatFile dat_file;
+  std::vector< double > b;
+  std::vector< double > c;
+  input_file >> dat_file;
+  dat_file.generate_bc( b , c );
+
+  if( verbose ) {
+   std::lock_guard< std::mutex > lock( io_mutex );
+   std::cout << dat_file;
+  }
+
+  {
+   std::lock_guard< std::mutex > lock( nc_mutex );
+   open();
+   auto bg = f->addGroup( "Block_0" );
+   bg.putAtt( "type" , "ThermalUnitBlock" );
+   bg.addDim( "TimeHorizon" , dat_file.TimeHorizon );
+   bg.addDim( "NumberIntervals" , dat_file.TimeHorizon );
+   serialize_thermalunit( bg , dat_file.thermal_unit , b , c );
+  }
+  num_units = 1;
+
+ } else if( ! stream ) {
+  // Read MOD file
+  ModFile mod_file;
+  input_file >> mod_file;
+
+  if( verbose ) {
+   std::lock_guard< std::mutex > lock( io_mutex );
+   std::cout << mod_file;
+  }
+
+  std::lock_guard< std::mutex > lock( nc_mutex );
+  open();
+  auto bg = serialize_modheader( *f , mod_file );
+
+  for( unsigned int i = 0 ; i < mod_file.NumThermal ; ++i , ++num_units ) {
+   auto ug = bg.addGroup( "UnitBlock_" + std::to_string( num_units ) );
+   ug.putAtt( "type" , "ThermalUnitBlock" );
+   mod_file.thermal_units[ i ].generate_startup_cost();
+   serialize_thermalunit( ug , mod_file.thermal_units[ i ] );
+  }
+
+  for( unsigned int i = 0 ; i < mod_file.NumHydro ; ++i , ++num_units ) {
+   auto ug = bg.addGroup( "UnitBlock_" + std::to_string( num_units ) );
+   ug.putAtt( "type" , "HydroUnitBlock" );
+   serialize_hydrounit( ug , mod_file.hydro_units[ i ] );
+  }
+
+ } else {
+  // Read and write the MOD file one unit at a time
+  ModFile mod_file;
+  std::string skip;
+  mod_file.load_header( input_file );
+
+  netCDF::NcGroup bg;
+  {
+   std::lock_guard< std::mutex > lock( nc_mutex );
+   open();
+   bg = serialize_modheader( *f , mod_file );
+  }
+
+  // "ThermalSection"
+  input_file >> skip;
+  ThermalUnit thermal_unit;
+  for( unsigned int i = 0 ; i < mod_file.NumThermal ; ++i , ++num_units ) {
+   thermal_unit.load( input_file );
+   thermal_unit.generate_startup_cost();
+   std::lock_guard< std::mutex > lock( nc_mutex );
+   auto ug = bg.addGroup( "UnitBlock_" + std::to_string( num_units ) );
+   ug.putAtt( "type" , "ThermalUnitBlock" );
+   serialize_thermalunit( ug , thermal_unit );
+  }
+
+  // "HydroSection"
+  input_file >> skip;
+  HydroUnit hydro_unit;
+  hydro_unit.inflows.resize( mod_file.TimeHorizon );
+  for( unsigned int i = 0 ; i < mod_file.NumHydro ; ++i , ++num_units ) {
+   hydro_unit.load( input_file );
+   std::lock_guard< std::mutex > lock( nc_mutex );
+   auto ug = bg.addGroup( "UnitBlock_" + std::to_string( num_units ) );
+   ug.putAtt( "type" , "HydroUnitBlock" );
+   serialize_hydrounit( ug , hydro_unit );
+  }
+ }
+
+ f.reset();  // close the file
+
+ if( verbose && ( input_paths.size() > 1 ) ) {
+  std::lock_guard< std::mutex > lock( io_mutex );
+  std::cout << "Output written on " << output_path << std::endl;
+ }
+
+ return( num_units );
+}
 
 /*--------------------------------------------------------------------------*/
 
@@ -545,12 +752,17 @@ void docopt( void ) {
  // http://docopt.org
  std::cout << docopt_desc << std::endl;
  std::cout << "Usage:\n"
-           << "  " << exe << " [-v] <input>\n"
+           << "  " << exe << " [-s] [-j <n>] [-v] <input>...\n"
            << "  " << exe << " -h | --help\n"
            << std::endl
+           << "Each input is a DAT or MOD file, or a directory whose DAT and\n"
+           << "MOD files are all converted.\n"
+           << std::endl
            << "Options:\n"
-           << "  -v, --verbose  Make the tool verbose.\n"
-           << "  -h, --help     Print this help.\n";
+           << "  -s, --stream    Convert MOD files one unit at a time.\n"
+           << "  -j, --jobs <n>  Files converted in parallel [default: 1].\n"
+           << "  -v, --verbose   Make the tool verbose.\n"
+           << "  -h, --help      Print this help.\n";
 }
 
 /*--------------------------------------------------------------------------*/
@@ -558,11 +770,13 @@ void docopt( void ) {
 /// Processes command line arguments
 void process_args( int argc , char ** argv ) {
 
- const char * const short_opts = "vh";
+ const char * const short_opts = "sj:vh";
  const option long_opts[] = {
-  { "verbose" , no_argument , nullptr , 'v' } ,
-  { "help" ,    no_argument , nullptr , 'h' } ,
-  { nullptr ,   no_argument , nullptr , 0 }
+  { "stream" ,  no_argument ,       nullptr , 's' } ,
+  { "jobs" ,    required_argument , nullptr , 'j' } ,
+  { "verbose" , no_argument ,       nullptr , 'v' } ,
+  { "help" ,    no_argument ,       nullptr , 'h' } ,
+  { nullptr ,   no_argument ,       nullptr , 0 }
  };
 
  // Options
@@ -574,6 +788,12 @@ void process_args( int argc , char ** argv ) {
    break;
   }
   switch( opt ) {
+   case 's':
+    stream = true;
+    break;
+   case 'j':
+    jobs = std::max( 1ul , std::stoul( optarg ) );
+    break;
    case 'v':
     verbose = true;
     break;
@@ -587,10 +807,30 @@ void process_args( int argc , char ** argv ) {
   }
  }
 
- // Last argument
- if( optind < argc ) {
-  input_path = std::string( argv[ optind ] );
- } else {
+ // Remaining arguments: files, or directories whose DAT and MOD files are
+ // all taken (in alphabetical order)
+ for( ; optind < argc ; ++optind ) {
+  std::filesystem::path path( argv[ optind ] );
+  if( ! std::filesystem::is_directory( path ) ) {
+   input_paths.push_back( path.string() );
+   continue;
+  }
+
+  std::vector< std::string > files;
+  for( const auto & entry : std::filesystem::directory_iterator( path ) ) {
+   auto ext = entry.path().extension().string();
+   std::transform( ext.begin() , ext.end() , ext.begin() ,
+                   []( unsigned char ch ) { return( std::tolower( ch ) ); } );
+   if( entry.is_regular_file() &&
+       ( ( ext == ".dat" ) || ( ext == ".mod" ) ) ) {
+    files.push_back( entry.path().string() );
+   }
+  }
+  std::sort( files.begin() , files.end() );
+  input_paths.insert( input_paths.end() , files.begin() , files.end() );
+ }
+
+ if( input_paths.empty() ) {
   std::cout << exe << ": no input file\n"
             << "Try " << exe << "' --help' for more information.\n";
   exit( 1 );
@@ -608,113 +848,53 @@ int main( int argc , char ** argv ) {
  exe = get_filename( argv[ 0 ] );
  process_args( argc , argv );
 
- // // Check if input file exists
- // if( ! std::filesystem::exists( input_path ) ) {
- //  std::cerr << exe << ": cannot open file " << input_path << std::endl;
- //  exit( 1 );
- // }
+ const auto start = std::chrono::steady_clock::now();
+
+ // a simple thread pool: each thread takes the next file to be converted
+ std::atomic< std::size_t > next( 0 );
+ std::atomic< std::size_t > files( 0 );
+ std::atomic< std::size_t > units( 0 );
+ std::atomic< bool > failed( false );
+
+ auto work = [ & ]( void ) {
+  for( std::size_t i ; ( i = next++ ) < input_paths.size() ; ) {
+   try {
+    units += convert( input_paths[ i ] );
+    ++files;
+   } catch( std::exception & e ) {
+    std::lock_guard< std::mutex > lock( io_mutex );
+    std::cerr << exe << ": " << e.what() << std::endl;
+    failed = true;
+   }
+  }
+ };
 
- // Check if input file can be opened
- std::ifstream input_file( input_path );
- if( ! input_file.is_open() ) {
-  std::cerr << exe << ": cannot open file " << input_path << std::endl;
-  exit( 1 );
+ const auto n_threads = std::min( std::size_t( jobs ) , input_paths.size() );
+ std::vector< std::thread > pool;
+ for( std::size_t t = 1 ; t < n_threads ; ++t ) {
+  pool.emplace_back( work );
  }
-
- std::string ext = input_path.substr( input_path.size() - 4 , 4 );
- std::string dat( ".dat" );
- std::string mod( ".mod" );
-
- // Check input file type
- if( std::equal( ext.begin() , ext.end() , dat.begin() ,
-                 []( auto a , auto b ) {
-                  return( std::tolower( a ) == std::tolower( b ) );
-                 } ) ) {
-  type = ftDat;
- } else if( std::equal( ext.begin() , ext.end() , mod.begin() ,
-                        []( auto a , auto b ) {
-                         return( std::tolower( a ) == std::tolower( b ) );
-                        } ) ) {
-  type = ftMod;
- } else {
-  std::cerr << "Error: Supported file formats are: dat, mod." << std::endl;
-  input_file.close();
-  return( 1 );
+ work();
+ for( auto & thread : pool ) {
+  thread.join();
  }
 
- // Read input file
- if( type == ftDat ) {
-  // Read DAT file
-  input_file >> dat_file;
-  dat_file.generate_bc( b , c );
-
-  if( verbose ) {
-   std::cout << dat_file;
-  }
-
- } else {  // type == ftMod
-  // Read MOD file
-  input_file >> mod_file;
+ const std::chrono::duration< double > elapsed =
+  std::chrono::steady_clock::now() - start;
+ const double secs = std::max( elapsed.count() , 1e-9 );
 
-  if( verbose ) {
-   std::cout << mod_file;
-  }
+ if( ( input_paths.size() == 1 ) && files ) {
+  auto output_path = input_paths[ 0 ];
+  output_path.replace( output_path.size() - 4 , 4 , ".nc4" );
+  std::cout << "Output written on " << output_path << std::endl;
  }
 
- // Generate output
- input_file.close();
- output_path = input_path;
- output_path.erase( output_path.size() - 4 , 4 );
- output_path.append( ".nc4" );
-
- netCDF::NcFile f( output_path , netCDF::NcFile::replace );
- f.putAtt( "SMS++_file_type" , netCDF::NcInt() , eBlockFile );
-
- if( type == ftDat ) {
-
-  auto bg = f.addGroup( "Block_0" );
-  bg.putAtt( "type" , "ThermalUnitBlock" );
-  bg.addDim( "TimeHorizon" , dat_file.TimeHorizon );
-  bg.addDim( "NumberIntervals" , dat_file.TimeHorizon );
-  serialize_thermalunit( bg , dat_file.thermal_unit );
-
- } else {  // type == ftMod
-
-  auto bg = f.addGroup( "Block_0" );
-  bg.putAtt( "type" , "UCBlock" );
-  bg.addDim( "TimeHorizon" , mod_file.TimeHorizon );
-  auto time_h = bg.getDim( "TimeHorizon" );
-  bg.addDim( "NumberUnits" , mod_file.NumThermal +
-                             mod_file.NumHydro +
-                             mod_file.NumCascade );
-  bg.addDim( "NumberIntervals" , 1 );
-
-  auto ng = bg.addGroup( "NetworkData" );
-  ng.addDim( "NumberNodes" , 1 );
-
-  serialize( bg ,
-             "ActivePowerDemand" ,
-             netCDF::NcDouble() ,
-             time_h ,
-             mod_file.load_curve.Loads[ 0 ] );
-
-  unsigned int num_units = 0;
-  for( unsigned int i = 0 ; i < mod_file.NumThermal ; ++i , ++num_units ) {
-   auto ug = bg.addGroup( "UnitBlock_" + std::to_string( num_units ) );
-   ug.putAtt( "type" , "ThermalUnitBlock" );
-   mod_file.thermal_units[ i ].generate_startup_cost();
-   serialize_thermalunit( ug , mod_file.thermal_units[ i ] );
-  }
-
-  for( unsigned int i = 0 ; i < mod_file.NumHydro ; ++i , ++num_units ) {
-   auto ug = bg.addGroup( "UnitBlock_" + std::to_string( num_units ) );
-   ug.putAtt( "type" , "HydroUnitBlock" );
-   serialize_hydrounit( ug , mod_file.hydro_units[ i ] );
-  }
- }
+ std::cout << std::fixed << std::setprecision( 3 )
+           << "Converted " << files << " files (" << units << " units) in "
+           << secs << "s: " << files / secs << " files/s, "
+           << units / secs << " units/s" << std::endl;
 
- std::cout << "Output written on " << output_path << std::endl;
- return( 0 );
+ return( failed ? 1 : 0 );
 }
 
 /*--------------------------------------------------------------------------*/
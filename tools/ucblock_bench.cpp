@@ -0,0 +1,714 @@
+/*--------------------------------------------------------------------------*/
+/*------------------------- File ucblock_bench.cpp -------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ * Small main() for benchmarking the performance-relevant stages of the life
+ * of a UCBlock, namely:
+ *
+ * - "deserialize": reading the UCBlock out of a netCDF file;
+ *
+ * - "variables.<class>", "constraints.<class>", "objective.<class>": the
+ *   generate_abstract_variables(), generate_abstract_constraints() and
+ *   generate_objective() of all the sub-Block of the UCBlock, aggregated by
+ *   their classname();
+ *
+ * - "linking_constraints": the generation of the constraints of the UCBlock
+ *   proper (node injection, reserve, inertia, ...);
+ *
+ * - "mod.set_active_power_demand", "mod.set_linear_term", "mod.scale",
+ *   "mod.set_kappa": a fixed number of calls to the corresponding methods
+ *   (the latter of the BatteryUnitBlock), which change the data back and
+ *   forth and issue both the physical and the abstract Modification;
+ *
+ * - "mod.dispatch", "mod.dispatch_rtti": the identification of a fixed
+ *   number of Modification of different types (a mix of NBModification,
+ *   UnitBlockMod and ThermalUnitBlock[Rngd]Mod), by one dynamic_cast to
+ *   UnitBlockMod followed by a test on UnitBlockMod::family() (as done by
+ *   ThermalUnitDPSolver) and by a chain of dynamic_cast respectively, i.e.,
+ *   the Modification-dispatch throughput;
+ *
+ * - "ThermalUnitDPSolver", "ThermalUnitDPSolver.generic": compute() of a
+ *   ThermalUnitDPSolver attached to each ThermalUnitBlock, with the
+ *   fixed-horizon kernels enabled and disabled respectively (see
+ *   ThermalUnitDPSolver::set_fixed_horizon_kernels()); since these only
+ *   exist for time horizons of 24, 48, 96 and 168, the gain can be measured
+ *   by running the tool on one instance for each of them;
+ *
+ * - "serialize": writing the UCBlock to a (temporary) netCDF file;
+ *
+ * - "teardown": deleting the UCBlock, with all its abstract representation.
+ *
+ * Each instance is processed a given number of times and the minimum time
+ * (in seconds) for each stage is reported as a JSON file, together with the
+ * peak resident set size of the process (in KiB) after the instance, which
+ * since the instances are processed in order is only meaningful for the
+ * largest one. Instances of any size can be produced with ucgenerator, e.g.
+ *
+ *     ucgenerator -T 168 -t 1000 -n 100 big.nc4 && ucblock_bench big.nc4
+ *
+ * If a baseline JSON file (as produced by a previous run of ucblock_bench)
+ * is given, each stage is compared with the one of the same instance in the
+ * baseline and the tool exits with code 2 if any of them is slower than the
+ * baseline by more than the given tolerance.
+ *
+ * If the UCBlock library has been compiled with UCBLOCK_TRACE defined, the
+ * tracing spans of the last run (see UCTrace.h) can be written as a Chrome
+ * trace file with the --trace option.
+ *
+ * \author The UCBlock contributors
+ *
+ * \copyright &copy; by the UCBlock contributors
+ */
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <getopt.h>
+#include <sys/resource.h>
+
+#include "BatteryUnitBlock.h"
+#include "ThermalUnitBlock.h"
+#include "ThermalUnitDPSolver.h"
+#include "UCBlock.h"
+#include "UCTrace.h"
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ Other stuff -------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+using namespace SMSpp_di_unipi_it;
+
+/// the times of the stages of a benchmark, in seconds
+using StageTimes = std::map< std::string , double >;
+
+/// all that is known about an instance
+struct InstanceResult
+{
+ std::string file;             ///< the instance file
+ Block::Index units{};         ///< number of UnitBlock
+ Block::Index time_horizon{};  ///< time horizon
+ Block::Index nodes{};         ///< number of nodes
+ long max_rss{};               ///< peak resident set size, in KiB
+ StageTimes stages;            ///< time of each stage
+};
+
+std::vector< std::string > input_paths;  ///< the instance files
+std::string output_path{};    ///< JSON output file name (empty = stdout)
+std::string baseline_path{};  ///< baseline JSON file name (empty = none)
+std::string trace_path{};     ///< Chrome trace file name (empty = none)
+std::string tmp_path = "ucblock_bench_tmp.nc4";  ///< file for "serialize"
+unsigned int repetitions = 3; ///< times each instance is processed
+unsigned int mod_rounds = 10; ///< calls of each Modification method
+unsigned long dispatches = 1000000;  ///< Modification for "mod.dispatch"
+double tolerance = 0.1;       ///< allowed relative slowdown w.r.t. baseline
+double min_time = 1e-3;       ///< stages faster than this are not compared
+bool verbose = false;         ///< if the tool should be verbose
+std::string exe{};            ///< name of the executable file
+std::string docopt_desc{};    ///< tool description
+
+/*--------------------------------------------------------------------------*/
+
+/// a trivial stopwatch
+class Timer
+{
+ public:
+
+ Timer( void ) : start( std::chrono::steady_clock::now() ) {}
+
+ /// returns the time elapsed since construction or the last call, in s
+ double lap( void ) {
+  auto now = std::chrono::steady_clock::now();
+  std::chrono::duration< double > d = now - start;
+  start = now;
+  return( d.count() );
+ }
+
+ private:
+
+ std::chrono::steady_clock::time_point start;
+};
+
+/*--------------------------------------------------------------------------*/
+/*--------------------------- THE BENCHMARK --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+/// runs all the stages once on the given instance
+void run_once( InstanceResult & res , StageTimes & times ) {
+ Timer timer;
+
+ // deserialize - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ UCBlock * ucb = nullptr;
+ {
+  netCDF::NcFile f( res.file , netCDF::NcFile::read );
+  auto bg = f.getGroup( "Block_0" );
+  if( bg.isNull() )
+   throw( std::invalid_argument( res.file + ": Block_0 not found" ) );
+  auto b = Block::new_Block( bg );
+  if( ! ( ucb = dynamic_cast< UCBlock * >( b ) ) ) {
+   delete( b );
+   throw( std::invalid_argument( res.file + ": not a UCBlock" ) );
+  }
+ }
+ times[ "deserialize" ] = timer.lap();
+
+ res.units = ucb->get_number_units();
+ res.time_horizon = ucb->get_time_horizon();
+ res.nodes = ucb->get_NetworkData() ?
+             ucb->get_NetworkData()->get_number_nodes() : 1;
+
+ // abstract representation of the sub-Block, by type - - - - - - - - - - -
+ const auto & sub = ucb->get_nested_Blocks();
+ for( auto b : sub ) {
+  timer.lap();
+  b->generate_abstract_variables();
+  times[ "variables." + b->classname() ] += timer.lap();
+ }
+ for( auto b : sub ) {
+  timer.lap();
+  b->generate_abstract_constraints();
+  times[ "constraints." + b->classname() ] += timer.lap();
+ }
+ for( auto b : sub ) {
+  timer.lap();
+  b->generate_objective();
+  times[ "objective." + b->classname() ] += timer.lap();
+ }
+
+ // linking constraints - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ // the sub-Block have already generated their own stuff, hence this only
+ // measures what is specific of the UCBlock
+ timer.lap();
+ ucb->generate_abstract_variables();
+ ucb->generate_abstract_constraints();
+ ucb->generate_objective();
+ times[ "linking_constraints" ] = timer.lap();
+
+ // Modification throughput - - - - - - - - - - - - - - - - - - - - - - - -
+ // each method changes the data by 1% and then back, mod_rounds times
+
+ const Block::Index nt = res.nodes * res.time_horizon;
+ std::vector< double > demand( nt );
+ const auto & apd = ucb->get_active_power_demand();
+ if( apd.num_elements() == nt )
+  std::copy( apd.data() , apd.data() + nt , demand.begin() );
+ else
+  for( Block::Index t = 0 ; t < res.time_horizon ; ++t ) {
+   const auto & nbs = ucb->get_network_blocks();
+   auto ad = t < nbs.size() ? nbs[ t ]->get_active_demand( 0 ) : nullptr;
+   for( Block::Index n = 0 ; n < res.nodes ; ++n )
+    demand[ n * res.time_horizon + t ] = ad ? ad[ n ] : 0;
+  }
+
+ std::vector< double > changed( nt );
+ std::transform( demand.begin() , demand.end() , changed.begin() ,
+                 []( double d ) { return( 1.01 * d ); } );
+ timer.lap();
+ for( unsigned int r = 0 ; r < mod_rounds ; ++r ) {
+  ucb->set_active_power_demand( changed.cbegin() , Block::Range( 0 , nt ) ,
+                                eModBlck , eModBlck );
+  ucb->set_active_power_demand( demand.cbegin() , Block::Range( 0 , nt ) ,
+                                eModBlck , eModBlck );
+ }
+ times[ "mod.set_active_power_demand" ] = timer.lap();
+
+ std::vector< ThermalUnitBlock * > thermals;
+ for( auto b : sub )
+  if( typeid( *b ) == typeid( ThermalUnitBlock ) )
+   thermals.push_back( static_cast< ThermalUnitBlock * >( b ) );
+
+ std::vector< std::vector< double > > lt( thermals.size() );
+ std::vector< std::vector< double > > lt_changed( thermals.size() );
+ for( Block::Index i = 0 ; i < thermals.size() ; ++i ) {
+  lt[ i ] = thermals[ i ]->get_linear_term();
+  if( lt[ i ].size() < res.time_horizon )  // constant (or absent) term
+   lt[ i ].assign( res.time_horizon , lt[ i ].empty() ? 0 : lt[ i ][ 0 ] );
+  lt_changed[ i ].resize( lt[ i ].size() );
+  std::transform( lt[ i ].begin() , lt[ i ].end() , lt_changed[ i ].begin() ,
+                  []( double c ) { return( 1.01 * c ); } );
+ }
+ timer.lap();
+ for( unsigned int r = 0 ; r < mod_rounds ; ++r )
+  for( Block::Index i = 0 ; i < thermals.size() ; ++i ) {
+   Block::Range rng( 0 , lt[ i ].size() );
+   thermals[ i ]->set_linear_term( lt_changed[ i ].cbegin() , rng ,
+                                   eModBlck , eModBlck );
+   thermals[ i ]->set_linear_term( lt[ i ].cbegin() , rng ,
+                                   eModBlck , eModBlck );
+  }
+ times[ "mod.set_linear_term" ] = timer.lap();
+
+ for( unsigned int r = 0 ; r < mod_rounds ; ++r )
+  for( auto b : sub )
+   if( auto unit = dynamic_cast< UnitBlock * >( b ) ) {
+    double scale = unit->get_scale();
+    unit->scale( 1.01 * scale , eModBlck , eModBlck );
+    unit->scale( scale , eModBlck , eModBlck );
+   }
+ times[ "mod.scale" ] = timer.lap();
+
+ std::vector< BatteryUnitBlock * > batteries;
+ for( auto b : sub )
+  if( auto battery = dynamic_cast< BatteryUnitBlock * >( b ) )
+   batteries.push_back( battery );
+ timer.lap();
+ for( unsigned int r = 0 ; r < mod_rounds ; ++r )
+  for( auto battery : batteries ) {
+   double kappa = battery->get_kappa();
+   battery->set_kappa( 1.01 * kappa , eModBlck , eModBlck );
+   battery->set_kappa( kappa , eModBlck , eModBlck );
+  }
+ times[ "mod.set_kappa" ] = timer.lap();
+
+ // Modification dispatch - - - - - - - - - - - - - - - - - - - - - - - - - -
+ // the two loops must find the same kinds, else something is badly wrong
+
+ std::vector< std::shared_ptr< Modification > > mods;
+ mods.push_back( std::make_shared< NBModification >( ucb ) );
+ for( auto tub : thermals ) {
+  mods.push_back( std::make_shared< UnitBlockMod >(
+   tub , UnitBlockMod::eScale ) );
+  mods.push_back( std::make_shared< ThermalUnitBlockMod >(
+   tub , ThermalUnitBlockMod::eSetMaxP ) );
+  mods.push_back( std::make_shared< ThermalUnitBlockRngdMod >(
+   tub , ThermalUnitBlockMod::eSetLinT , Block::Range( 0 , 1 ) ) );
+  if( mods.size() >= 64 )
+   break;
+ }
+
+ std::array< unsigned long , 4 > kinds{} , kinds_rtti{};
+ timer.lap();
+ for( unsigned long i = 0 ; i < dispatches ; ++i ) {
+  const auto mod = mods[ i % mods.size() ].get();
+  if( const auto ubm = dynamic_cast< UnitBlockMod * >( mod ) )
+   ++kinds[ ubm->family() == UnitBlockMod::eThermalUnitBlockModFamily ?
+            2 : 3 ];
+  else if( dynamic_cast< NBModification * >( mod ) )
+   ++kinds[ 0 ];
+  else if( dynamic_cast< GroupModification * >( mod ) )
+   ++kinds[ 1 ];
+ }
+ times[ "mod.dispatch" ] = timer.lap();
+
+ for( unsigned long i = 0 ; i < dispatches ; ++i ) {
+  const auto mod = mods[ i % mods.size() ].get();
+  if( dynamic_cast< NBModification * >( mod ) )
+   ++kinds_rtti[ 0 ];
+  else if( dynamic_cast< GroupModification * >( mod ) )
+   ++kinds_rtti[ 1 ];
+  else if( dynamic_cast< ThermalUnitBlockMod * >( mod ) )
+   ++kinds_rtti[ 2 ];
+  else if( dynamic_cast< UnitBlockMod * >( mod ) )
+   ++kinds_rtti[ 3 ];
+ }
+ times[ "mod.dispatch_rtti" ] = timer.lap();
+
+ if( kinds != kinds_rtti )
+  throw( std::logic_error( "the family tags and dynamic_cast disagree" ) );
+
+ // ThermalUnitDPSolver - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ std::vector< double > values;
+ for( auto tub : thermals ) {
+  auto solver = new ThermalUnitDPSolver();
+  tub->register_Solver( solver );
+  timer.lap();
+  solver->compute();
+  times[ "ThermalUnitDPSolver" ] += timer.lap();
+  values.push_back( solver->get_var_value() );
+  tub->unregister_Solver( solver , true );
+ }
+
+ ThermalUnitDPSolver::set_fixed_horizon_kernels( false );
+ auto vit = values.begin();
+ for( auto tub : thermals ) {
+  auto solver = new ThermalUnitDPSolver();
+  tub->register_Solver( solver );
+  timer.lap();
+  solver->compute();
+  times[ "ThermalUnitDPSolver.generic" ] += timer.lap();
+  if( std::abs( solver->get_var_value() - *( vit++ ) ) >
+      1e-9 * std::max( 1.0 , std::abs( solver->get_var_value() ) ) )
+   throw( std::logic_error( "fixed-horizon and generic kernels disagree" ) );
+  tub->unregister_Solver( solver , true );
+ }
+ ThermalUnitDPSolver::set_fixed_horizon_kernels( true );
+
+ // serialize - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ timer.lap();
+ {
+  netCDF::NcFile f( tmp_path , netCDF::NcFile::replace );
+  f.putAtt( "SMS++_file_type" , netCDF::NcInt() , eBlockFile );
+  auto bg = f.addGroup( "Block_0" );
+  ucb->serialize( bg );
+ }
+ times[ "serialize" ] = timer.lap();
+ std::remove( tmp_path.c_str() );
+
+ // teardown- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ timer.lap();
+ delete( ucb );
+ times[ "teardown" ] = timer.lap();
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// runs the benchmark on the given instance, keeping the best times
+void run( InstanceResult & res ) {
+ for( unsigned int r = 0 ; r < repetitions ; ++r ) {
+  StageTimes times;
+  UCTrace::clear();
+  run_once( res , times );
+  struct rusage usage;
+  if( ! getrusage( RUSAGE_SELF , & usage ) )
+   res.max_rss = usage.ru_maxrss;
+  for( const auto & [ stage , t ] : times ) {
+   auto it = res.stages.find( stage );
+   if( ( it == res.stages.end() ) || ( t < it->second ) )
+    res.stages[ stage ] = t;
+  }
+  if( verbose )
+   std::cerr << res.file << ": repetition " << r + 1 << " done"
+             << std::endl;
+ }
+}
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------- JSON I/O ---------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+/// returns s as a JSON string, i.e., quoted and with the escapes
+std::string json_string( const std::string & s ) {
+ std::string js = "\"";
+ for( unsigned char c : s )
+  switch( c ) {
+   case '"':  js += "\\\""; break;
+   case '\\': js += "\\\\"; break;
+   case '\n': js += "\\n"; break;
+   case '\r': js += "\\r"; break;
+   case '\t': js += "\\t"; break;
+   default:
+    if( c < 0x20 ) {
+     char buf[ 8 ];
+     std::snprintf( buf , sizeof( buf ) , "\\u%04x" , c );
+     js += buf;
+    } else
+     js += char( c );
+  }
+ return( js + "\"" );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// reads the JSON string starting at l[ pos ], returns false if there is none
+/** On success, s is the unescaped string and pos is moved past its end. */
+bool read_json_string( const std::string & l , std::size_t & pos ,
+                       std::string & s ) {
+ pos = l.find( '"' , pos );
+ if( pos == std::string::npos )
+  return( false );
+ s.clear();
+ for( ++pos ; pos < l.size() ; ++pos ) {
+  char c = l[ pos ];
+  if( c == '"' ) {
+   ++pos;
+   return( true );
+  }
+  if( ( c == '\\' ) && ( ++pos < l.size() ) )
+   switch( c = l[ pos ] ) {
+    case 'n': c = '\n'; break;
+    case 'r': c = '\r'; break;
+    case 't': c = '\t'; break;
+    case 'u':
+     c = char( std::stoi( l.substr( pos + 1 , 4 ) , nullptr , 16 ) );
+     pos += 4;
+     break;
+    default: break;  // '"' and '\\'
+   }
+  s += c;
+ }
+ return( false );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// writes the results as JSON, one key per line
+/** The format is deliberately "one key per line" so that read_baseline()
+ * can read it back without the need of a full JSON parser. The numbers are
+ * formatted in a local buffer, so that the format of out is not changed. */
+
+void write_json( std::ostream & out , unsigned int reps ,
+                 const std::vector< InstanceResult > & results ) {
+ std::ostringstream buf;
+ buf << std::setprecision( 9 );
+ buf << "{\n"
+     << " \"repetitions\": " << reps << ",\n"
+     << " \"instances\": [\n";
+ for( std::size_t i = 0 ; i < results.size() ; ++i ) {
+  const auto & res = results[ i ];
+  buf << "  {\n"
+      << "   \"file\": " << json_string( res.file ) << ",\n"
+      << "   \"units\": " << res.units << ",\n"
+      << "   \"time_horizon\": " << res.time_horizon << ",\n"
+      << "   \"nodes\": " << res.nodes << ",\n"
+      << "   \"max_rss_kb\": " << res.max_rss << ",\n"
+      << "   \"stages\": {\n";
+  std::size_t k = 0;
+  for( const auto & [ stage , t ] : res.stages )
+   buf << "    " << json_string( stage ) << ": " << t
+       << ( ++k < res.stages.size() ? ",\n" : "\n" );
+  buf << "   }\n"
+      << "  }" << ( i + 1 < results.size() ? ",\n" : "\n" );
+ }
+ buf << " ]\n"
+     << "}\n";
+ out << buf.str();
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// reads a JSON file written by write_json(): file name -> stage times
+std::map< std::string , StageTimes > read_baseline( std::istream & in ) {
+ std::map< std::string , StageTimes > baseline;
+ std::string line , file;
+ bool in_stages = false;
+
+ // extracts the (unescaped) key and what follows the ':' in the line
+ auto split = []( const std::string & l , std::string & key ,
+                  std::string & value ) {
+  std::size_t pos = 0;
+  if( ! read_json_string( l , pos , key ) )
+   return( false );
+  auto colon = l.find( ':' , pos );
+  if( colon == std::string::npos )
+   return( false );
+  value = l.substr( colon + 1 );
+  return( true );
+ };
+
+ while( std::getline( in , line ) ) {
+  std::string key , value;
+  if( in_stages ) {
+   if( line.find( '}' ) != std::string::npos )
+    in_stages = false;
+   else if( split( line , key , value ) )
+    baseline[ file ][ key ] = std::stod( value );
+  } else if( split( line , key , value ) ) {
+   if( key == "file" ) {
+    std::size_t pos = 0;
+    read_json_string( value , pos , file );
+   } else if( key == "stages" )
+    in_stages = true;
+  }
+ }
+
+ return( baseline );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// compares the results with the baseline, returns true if no regression
+/** The report goes to std::cerr, since std::cout may carry the JSON; as in
+ * write_json(), it is formatted in a local buffer. */
+bool compare( const std::vector< InstanceResult > & results ,
+              const std::map< std::string , StageTimes > & baseline ) {
+ bool ok = true;
+ std::ostringstream report;
+ report << std::fixed << std::setprecision( 4 );
+ for( const auto & res : results ) {
+  auto bit = baseline.find( res.file );
+  if( bit == baseline.end() ) {
+   report << res.file << ": not in the baseline\n";
+   continue;
+  }
+  for( const auto & [ stage , t ] : res.stages ) {
+   auto sit = bit->second.find( stage );
+   if( ( sit == bit->second.end() ) || ( sit->second < min_time ) )
+    continue;
+   double ratio = t / sit->second;
+   bool slow = ratio > 1 + tolerance;
+   ok &= ! slow;
+   if( slow || verbose )
+    report << ( slow ? "REGRESSION " : "ok         " ) << res.file
+           << " " << stage << ": " << sit->second << "s -> " << t
+           << "s (x" << ratio << ")\n";
+  }
+ }
+ std::cerr << report.str();
+ return( ok );
+}
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- COMMAND LINE --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+/// Gets the name of the executable from its full path
+std::string get_filename( const std::string & fullpath ) {
+ std::size_t found = fullpath.find_last_of( "/\\" );
+ return( fullpath.substr( found + 1 ) );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// Prints the tool description and usage
+void docopt( void ) {
+ // http://docopt.org
+ std::cout << docopt_desc << std::endl;
+ std::cout << "Usage:\n"
+           << "  " << exe << " [options] <input>...\n"
+           << "  " << exe << " -h | --help\n"
+           << std::endl
+           << "Options:\n"
+           << "  -r, --repetitions <n>  Runs per instance [default: 3].\n"
+           << "  -m, --mods <n>         Calls per Modification method "
+              "[default: 10].\n"
+           << "  -d, --dispatch <n>     Modification dispatched "
+              "[default: 1000000].\n"
+           << "  -o, --output <file>    JSON output [default: stdout].\n"
+           << "  -b, --baseline <file>  JSON baseline to compare with.\n"
+           << "  -t, --tolerance <f>    Allowed slowdown [default: 0.1].\n"
+           << "  -w, --tmp <file>       Temporary file for serialize.\n"
+           << "  -x, --trace <file>     Chrome trace of the last run "
+              "(needs UCBLOCK_TRACE).\n"
+           << "  -v, --verbose          Make the tool verbose.\n"
+           << "  -h, --help             Print this help.\n";
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// Processes command line arguments
+void process_args( int argc , char ** argv ) {
+
+ const char * const short_opts = "r:m:d:o:b:t:w:x:vh";
+ const option long_opts[] = {
+  { "repetitions" , required_argument , nullptr , 'r' } ,
+  { "mods" ,        required_argument , nullptr , 'm' } ,
+  { "dispatch" ,    required_argument , nullptr , 'd' } ,
+  { "output" ,      required_argument , nullptr , 'o' } ,
+  { "baseline" ,    required_argument , nullptr , 'b' } ,
+  { "tolerance" ,   required_argument , nullptr , 't' } ,
+  { "tmp" ,         required_argument , nullptr , 'w' } ,
+  { "trace" ,       required_argument , nullptr , 'x' } ,
+  { "verbose" ,     no_argument ,       nullptr , 'v' } ,
+  { "help" ,        no_argument ,       nullptr , 'h' } ,
+  { nullptr ,       no_argument ,       nullptr , 0 }
+ };
+
+ // Options
+ while( true ) {
+  const auto opt = getopt_long( argc , argv , short_opts , long_opts ,
+                                nullptr );
+
+  if( -1 == opt ) {
+   break;
+  }
+  switch( opt ) {
+   case 'r':
+    repetitions = std::max( 1ul , std::stoul( optarg ) );
+    break;
+   case 'm':
+    mod_rounds = std::stoul( optarg );
+    break;
+   case 'd':
+    dispatches = std::stoul( optarg );
+    break;
+   case 'o':
+    output_path = std::string( optarg );
+    break;
+   case 'b':
+    baseline_path = std::string( optarg );
+    break;
+   case 't':
+    tolerance = std::stod( optarg );
+    break;
+   case 'w':
+    tmp_path = std::string( optarg );
+    break;
+   case 'x':
+    trace_path = std::string( optarg );
+    break;
+   case 'v':
+    verbose = true;
+    break;
+   case 'h':
+    docopt();
+    exit( 0 );
+   case '?':
+   default:
+    std::cout << "Try " << exe << "' --help' for more information.\n";
+    exit( 1 );
+  }
+ }
+
+ // Remaining arguments
+ for( ; optind < argc ; ++optind )
+  input_paths.emplace_back( argv[ optind ] );
+
+ if( input_paths.empty() ) {
+  std::cout << exe << ": no input file\n"
+            << "Try " << exe << "' --help' for more information.\n";
+  exit( 1 );
+ }
+}
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------------- MAIN ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+int main( int argc , char ** argv ) {
+
+ // Manage options and help
+ docopt_desc = "UCBlock benchmark.\n";
+ exe = get_filename( argv[ 0 ] );
+ process_args( argc , argv );
+
+ std::vector< InstanceResult > results( input_paths.size() );
+ try {
+  for( std::size_t i = 0 ; i < input_paths.size() ; ++i ) {
+   results[ i ].file = input_paths[ i ];
+   run( results[ i ] );
+  }
+ } catch( std::exception & e ) {
+  std::cerr << exe << ": " << e.what() << std::endl;
+  return( 1 );
+ }
+
+ if( output_path.empty() )
+  write_json( std::cout , repetitions , results );
+ else {
+  std::ofstream out( output_path );
+  if( ! out.is_open() ) {
+   std::cerr << exe << ": cannot open file " << output_path << std::endl;
+   return( 1 );
+  }
+  write_json( out , repetitions , results );
+ }
+
+ if( ! trace_path.empty() ) {
+  std::ofstream out( trace_path );
+  if( ! out.is_open() ) {
+   std::cerr << exe << ": cannot open file " << trace_path << std::endl;
+   return( 1 );
+  }
+  UCTrace::write_json( out );
+ }
+
+ if( ! baseline_path.empty() ) {
+  std::ifstream in( baseline_path );
+  if( ! in.is_open() ) {
+   std::cerr << exe << ": cannot open file " << baseline_path << std::endl;
+   return( 1 );
+  }
+  if( ! compare( results , read_baseline( in ) ) )
+   return( 2 );
+ }
+
+ return( 0 );
+}
+
+/*--------------------------------------------------------------------------*/
+/*----------------------- End File ucblock_bench.cpp -----------------------*/
+/*--------------------------------------------------------------------------*/
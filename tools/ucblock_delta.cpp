@@ -0,0 +1,181 @@
+/*--------------------------------------------------------------------------*/
+/*------------------------- File ucblock_delta.cpp -------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ * Small main() for writing a "delta" netCDF file, i.e., a variant of a base
+ * UCBlock instance stored as the arrays that differ from the base (see
+ * UCBlock::serialize_delta() for the format).
+ *
+ * Given the base and the variant netCDF files, the tool compares the
+ * UCBlock groups of the two, writes the differing slices with
+ * UCBlock::serialize_delta() into the delta file, and records in it the
+ * name of the base file, relative to the directory of the delta file. The
+ * variant can then be loaded with UCBlock::new_from_delta().
+ *
+ * \author The UCBlock contributors
+ *
+ * \copyright &copy; by the UCBlock contributors
+ */
+
+#include <filesystem>
+#include <getopt.h>
+
+#include "UCBlock.h"
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ Other stuff -------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+using namespace SMSpp_di_unipi_it;
+
+std::string base_path{};         ///< the base instance file
+std::string variant_path{};      ///< the variant instance file
+std::string delta_path{};        ///< the output delta file
+std::string group_name{ "Block_0" };  ///< the UCBlock group of both files
+bool verbose = false;            ///< if the tool should be verbose
+std::string exe{};               ///< name of the executable file
+std::string docopt_desc{};       ///< tool description
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ THE DELTA ---------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+/// writes the delta between the base and the variant files
+void run( void ) {
+ namespace fs = std::filesystem;
+
+ {
+  netCDF::NcFile base( base_path , netCDF::NcFile::read );
+  netCDF::NcFile variant( variant_path , netCDF::NcFile::read );
+  auto base_group = base.getGroup( group_name );
+  if( base_group.isNull() )
+   throw( std::invalid_argument( base_path + ": " + group_name +
+                                 " not found" ) );
+  auto variant_group = variant.getGroup( group_name );
+  if( variant_group.isNull() )
+   throw( std::invalid_argument( variant_path + ": " + group_name +
+                                 " not found" ) );
+
+  netCDF::NcFile delta( delta_path , netCDF::NcFile::replace ,
+                        netCDF::NcFile::nc4 );
+  auto relative = fs::relative( fs::absolute( base_path ) ,
+                                fs::absolute( delta_path ).parent_path() );
+  delta.putAtt( "BaseFile" , relative.string() );
+  if( group_name != "Block_0" )
+   delta.putAtt( "BaseGroup" , group_name );
+
+  UCBlock::serialize_delta( base_group , variant_group , delta );
+
+  if( verbose ) {
+   std::cout << "Changed variables:\n";
+   for( const auto & [ name , var ] : delta.getVars() )
+    std::cout << "  " << name << " [" << var.getDim( 0 ).getSize() << "]\n";
+   for( const auto & [ unit , group ] : delta.getGroups() )
+    for( const auto & [ name , var ] : group.getVars() )
+     std::cout << "  " << unit << "/" << name << " ["
+               << var.getDim( 0 ).getSize() << "]\n";
+  }
+ }
+
+ std::cout << "Delta written on " << delta_path << " ("
+           << fs::file_size( delta_path ) << " bytes, variant "
+           << fs::file_size( variant_path ) << " bytes)" << std::endl;
+}
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- COMMAND LINE --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+/// Gets the name of the executable from its full path
+std::string get_filename( const std::string & fullpath ) {
+ std::size_t found = fullpath.find_last_of( "/\\" );
+ return( fullpath.substr( found + 1 ) );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// Prints the tool description and usage
+void docopt( void ) {
+ // http://docopt.org
+ std::cout << docopt_desc << std::endl;
+ std::cout << "Usage:\n"
+           << "  " << exe << " [options] <base> <variant> <delta>\n"
+           << "  " << exe << " -h | --help\n"
+           << std::endl
+           << "Options:\n"
+           << "  -g, --group <name>     UCBlock group [default: Block_0].\n"
+           << "  -v, --verbose          Make the tool verbose.\n"
+           << "  -h, --help             Print this help.\n";
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// Processes command line arguments
+void process_args( int argc , char ** argv ) {
+
+ const char * const short_opts = "g:vh";
+ const option long_opts[] = {
+  { "group" ,   required_argument , nullptr , 'g' } ,
+  { "verbose" , no_argument ,       nullptr , 'v' } ,
+  { "help" ,    no_argument ,       nullptr , 'h' } ,
+  { nullptr ,   no_argument ,       nullptr , 0 }
+ };
+
+ // Options
+ while( true ) {
+  const auto opt = getopt_long( argc , argv , short_opts , long_opts ,
+                                nullptr );
+
+  if( -1 == opt ) {
+   break;
+  }
+  switch( opt ) {
+   case 'g':
+    group_name = std::string( optarg );
+    break;
+   case 'v':
+    verbose = true;
+    break;
+   case 'h':
+    docopt();
+    exit( 0 );
+   case '?':
+   default:
+    std::cout << "Try " << exe << "' --help' for more information.\n";
+    exit( 1 );
+  }
+ }
+
+ // Last arguments
+ if( optind == argc - 3 ) {
+  base_path = std::string( argv[ optind ] );
+  variant_path = std::string( argv[ optind + 1 ] );
+  delta_path = std::string( argv[ optind + 2 ] );
+ }
+ else {
+  std::cout << exe << ": base, variant and delta files are needed\n"
+            << "Try " << exe << "' --help' for more information.\n";
+  exit( 1 );
+ }
+}
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------------- MAIN ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+int main( int argc , char ** argv ) {
+
+ // Manage options and help
+ docopt_desc = "UCBlock delta file writer.\n";
+ exe = get_filename( argv[ 0 ] );
+ process_args( argc , argv );
+
+ try {
+  run();
+ } catch( std::exception & e ) {
+  std::cerr << exe << ": " << e.what() << std::endl;
+  return( 1 );
+ }
+
+ return( 0 );
+}
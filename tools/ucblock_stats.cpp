@@ -0,0 +1,471 @@
+/*--------------------------------------------------------------------------*/
+/*------------------------- File ucblock_stats.cpp -------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ * Small main() for reporting the size of the model corresponding to a
+ * UCBlock netCDF file, before any Solver is attached to it.
+ *
+ * The UCBlock is read out of the file, the given BlockConfig (if any) is
+ * applied to it, and its abstract representation is generated. Then, for
+ * each family of static Constraint (identified by the classname of the
+ * Block it belongs to and by the name with which it has been added, e.g.
+ * "ThermalUnitBlock/StartUp_Const" or "UCBlock/node_injection_c"), the
+ * tool reports the number of rows, of bound rows (OneVarConstraint), of
+ * nonzeros (a bound row counting as one) and an estimate of the memory
+ * used. The same is done for the static ColVariable and, for each classname
+ * of the sub-Block of the UCBlock, the time needed to generate its
+ * variables, constraints and objective is reported as well. The families
+ * are sorted by decreasing number of nonzeros, so that the ones that blow
+ * up the model (possibly because of a data error) come first. Finally, the
+ * memory held by the sub-Block of each classname is broken down by family
+ * as reported by their get_memory_usage() (see MemoryUsage).
+ *
+ * The memory is an estimate: sizeof() the Constraint / Variable plus, for
+ * an FRowConstraint with a LinearFunction, one coefficient and one pointer
+ * per nonzero; the memory allocator overhead is not accounted for.
+ *
+ * \author The UCBlock contributors
+ *
+ * \copyright &copy; by the UCBlock contributors
+ */
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <getopt.h>
+
+#include "BlockConfig.h"
+#include "FRowConstraint.h"
+#include "LinearFunction.h"
+#include "OneVarConstraint.h"
+#include "UCBlock.h"
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ Other stuff -------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+using namespace SMSpp_di_unipi_it;
+
+/// the size of a family of Constraint or Variable
+struct FamilySize
+{
+ std::size_t rows{};      ///< number of (non-bound) rows, or of columns
+ std::size_t bounds{};    ///< number of bound rows
+ std::size_t nonzeros{};  ///< number of nonzeros
+ std::size_t memory{};    ///< estimate of the memory, in bytes
+};
+
+/// the generation time of a classname of sub-Block, in seconds
+struct ClassTime
+{
+ std::size_t blocks{};    ///< number of sub-Block of this classname
+ double variables{};      ///< time of generate_abstract_variables()
+ double constraints{};    ///< time of generate_abstract_constraints()
+ double objective{};      ///< time of generate_objective()
+};
+
+std::string input_path{};     ///< the instance file
+std::string config_path{};    ///< BlockConfig file (empty = none)
+bool verbose = false;         ///< if the tool should be verbose
+std::string exe{};            ///< name of the executable file
+std::string docopt_desc{};    ///< tool description
+
+/*--------------------------------------------------------------------------*/
+
+/// a trivial stopwatch
+class Timer
+{
+ public:
+
+ Timer( void ) : start( std::chrono::steady_clock::now() ) {}
+
+ /// returns the time elapsed since construction or the last call, in s
+ double lap( void ) {
+  auto now = std::chrono::steady_clock::now();
+  std::chrono::duration< double > d = now - start;
+  start = now;
+  return( d.count() );
+ }
+
+ private:
+
+ std::chrono::steady_clock::time_point start;
+};
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- THE COUNTING --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+/// calls f on each element of a group of static Constraint / Variable
+/** A group, as stored in a boost::any by Block::add_static_constraint()
+ * and Block::add_static_variable(), is a pointer to either a single T, a
+ * std::vector of T, a std::vector of std::vector of T or a
+ * boost::multi_array of T with up to three dimensions. Returns false if the
+ * group has none of these forms. */
+
+template< class T >
+bool for_each_in( const boost::any & group ,
+                  const std::function< void( const T & ) > & f ) {
+ if( auto p = boost::any_cast< T * >( & group ) ) {
+  f( **p );
+  return( true );
+ }
+ if( auto p = boost::any_cast< std::vector< T > * >( & group ) ) {
+  for( const auto & e : **p )
+   f( e );
+  return( true );
+ }
+ if( auto p = boost::any_cast< std::vector< std::vector< T > > * >(
+      & group ) ) {
+  for( const auto & v : **p )
+   for( const auto & e : v )
+    f( e );
+  return( true );
+ }
+
+ auto each = [ & f ]( const auto * a ) {
+  std::for_each( a->data() , a->data() + a->num_elements() , f );
+ };
+ if( auto p = boost::any_cast< boost::multi_array< T , 1 > * >( & group ) ) {
+  each( *p );
+  return( true );
+ }
+ if( auto p = boost::any_cast< boost::multi_array< T , 2 > * >( & group ) ) {
+  each( *p );
+  return( true );
+ }
+ if( auto p = boost::any_cast< boost::multi_array< T , 3 > * >( & group ) ) {
+  each( *p );
+  return( true );
+ }
+ return( false );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// adds the static Constraint and Variable of b, and of all its nested
+/// Block, to the families
+void count( const Block * b , std::map< std::string , FamilySize > & cons ,
+            std::map< std::string , FamilySize > & vars ) {
+ const auto & c_groups = b->get_static_constraints();
+ const auto & c_names = b->get_s_const_name();
+ for( std::size_t i = 0 ; i < c_groups.size() ; ++i ) {
+  auto name = b->classname() + "/" +
+              ( ( i < c_names.size() ) && ( ! c_names[ i ].empty() ) ?
+                c_names[ i ] : "#" + std::to_string( i ) );
+  auto & size = cons[ name ];
+
+  auto row = [ & size ]( const FRowConstraint & c ) {
+   ++size.rows;
+   size.memory += sizeof( FRowConstraint );
+   if( auto f = c.get_function() ) {
+    size.nonzeros += f->get_num_active_var();
+    if( dynamic_cast< const LinearFunction * >( f ) )
+     size.memory += sizeof( LinearFunction ) + f->get_num_active_var() *
+                    ( sizeof( double ) + sizeof( ColVariable * ) );
+   }
+  };
+  auto bound = [ & size ]( const auto & c ) {
+   ++size.bounds;
+   ++size.nonzeros;
+   size.memory += sizeof( c );
+  };
+
+  if( ( ! for_each_in< FRowConstraint >( c_groups[ i ] , row ) ) &&
+      ( ! for_each_in< BoxConstraint >( c_groups[ i ] , bound ) ) &&
+      ( ! for_each_in< LB0Constraint >( c_groups[ i ] , bound ) ) &&
+      ( ! for_each_in< ZOConstraint >( c_groups[ i ] , bound ) ) && verbose )
+   std::cerr << name << ": unknown kind of Constraint, skipped"
+             << std::endl;
+ }
+
+ const auto & v_groups = b->get_static_variables();
+ const auto & v_names = b->get_s_var_name();
+ for( std::size_t i = 0 ; i < v_groups.size() ; ++i ) {
+  auto name = b->classname() + "/" +
+              ( ( i < v_names.size() ) && ( ! v_names[ i ].empty() ) ?
+                v_names[ i ] : "#" + std::to_string( i ) );
+  auto & size = vars[ name ];
+
+  auto column = [ & size ]( const ColVariable & v ) {
+   ++size.rows;
+   size.memory += sizeof( ColVariable );
+  };
+
+  if( ( ! for_each_in< ColVariable >( v_groups[ i ] , column ) ) && verbose )
+   std::cerr << name << ": unknown kind of Variable, skipped" << std::endl;
+ }
+
+ for( auto sub : b->get_nested_Blocks() )
+  count( sub , cons , vars );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// prints the families, sorted by decreasing nonzeros (then rows)
+void print( const std::string & title ,
+            const std::map< std::string , FamilySize > & families ,
+            bool columns ) {
+ std::vector< std::pair< std::string , FamilySize > > sorted(
+  families.begin() , families.end() );
+ std::stable_sort( sorted.begin() , sorted.end() ,
+                   []( const auto & a , const auto & b ) {
+                    return( ( a.second.nonzeros > b.second.nonzeros ) ||
+                            ( ( a.second.nonzeros == b.second.nonzeros ) &&
+                              ( a.second.rows > b.second.rows ) ) );
+                   } );
+
+ FamilySize total;
+ std::size_t width = title.size();
+ for( const auto & [ name , size ] : sorted ) {
+  width = std::max( width , name.size() );
+  total.rows += size.rows;
+  total.bounds += size.bounds;
+  total.nonzeros += size.nonzeros;
+  total.memory += size.memory;
+ }
+
+ auto line = [ & ]( const std::string & name , const FamilySize & size ) {
+  std::cout << std::left << std::setw( width ) << name << std::right
+            << std::setw( 12 ) << size.rows;
+  if( ! columns )
+   std::cout << std::setw( 12 ) << size.bounds
+             << std::setw( 14 ) << size.nonzeros;
+  std::cout << std::setw( 12 ) << std::fixed << std::setprecision( 2 )
+            << size.memory / 1048576.0 << "\n";
+ };
+
+ std::cout << std::left << std::setw( width ) << title << std::right
+           << std::setw( 12 ) << ( columns ? "columns" : "rows" );
+ if( ! columns )
+  std::cout << std::setw( 12 ) << "bounds" << std::setw( 14 ) << "nonzeros";
+ std::cout << std::setw( 12 ) << "MB" << "\n";
+ for( const auto & [ name , size ] : sorted )
+  line( name , size );
+ line( "total" , total );
+ std::cout << std::endl;
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// loads the instance, generates its abstract representation and reports
+void run( void ) {
+ Timer timer;
+
+ UCBlock * ucb = nullptr;
+ {
+  netCDF::NcFile f( input_path , netCDF::NcFile::read );
+  auto bg = f.getGroup( "Block_0" );
+  if( bg.isNull() )
+   throw( std::invalid_argument( input_path + ": Block_0 not found" ) );
+  auto b = Block::new_Block( bg );
+  if( ! ( ucb = dynamic_cast< UCBlock * >( b ) ) ) {
+   delete( b );
+   throw( std::invalid_argument( input_path + ": not a UCBlock" ) );
+  }
+ }
+ const double load_time = timer.lap();
+
+ if( ! config_path.empty() ) {
+  auto c = Configuration::deserialize( config_path );
+  auto bc = dynamic_cast< BlockConfig * >( c );
+  if( ! bc ) {
+   delete( c );
+   delete( ucb );
+   throw( std::invalid_argument( config_path + ": not a BlockConfig" ) );
+  }
+  bc->apply( ucb );
+  bc->clear();
+  delete( bc );
+ }
+
+ // generate the sub-Block first, by classname, and then the UCBlock proper
+ std::map< std::string , ClassTime > times;
+ const auto & sub = ucb->get_nested_Blocks();
+ for( auto b : sub ) {
+  auto & t = times[ b->classname() ];
+  ++t.blocks;
+  timer.lap();
+  b->generate_abstract_variables();
+  t.variables += timer.lap();
+ }
+ for( auto b : sub ) {
+  timer.lap();
+  b->generate_abstract_constraints();
+  times[ b->classname() ].constraints += timer.lap();
+ }
+ for( auto b : sub ) {
+  timer.lap();
+  b->generate_objective();
+  times[ b->classname() ].objective += timer.lap();
+ }
+
+ auto & t = times[ ucb->classname() ];
+ t.blocks = 1;
+ timer.lap();
+ ucb->generate_abstract_variables();
+ t.variables = timer.lap();
+ ucb->generate_abstract_constraints();
+ t.constraints = timer.lap();
+ ucb->generate_objective();
+ t.objective = timer.lap();
+
+ std::map< std::string , FamilySize > cons;
+ std::map< std::string , FamilySize > vars;
+ count( ucb , cons , vars );
+
+ std::cout << input_path << ": " << ucb->get_number_units() << " units, "
+           << ucb->get_time_horizon() << " time instants, "
+           << ( ucb->get_NetworkData() ?
+                ucb->get_NetworkData()->get_number_nodes() : 1 )
+           << " nodes, loaded in " << std::fixed << std::setprecision( 3 )
+           << load_time << "s\n" << std::endl;
+
+ print( "Constraint family" , cons , false );
+ print( "Variable family" , vars , true );
+
+ std::size_t width = 20;
+ for( const auto & [ name , time ] : times )
+  width = std::max( width , name.size() );
+ std::cout << std::left << std::setw( width ) << "Generation time (s)"
+           << std::right << std::setw( 8 ) << "blocks" << std::setw( 12 )
+           << "variables" << std::setw( 12 ) << "constraints"
+           << std::setw( 12 ) << "objective" << "\n";
+ for( const auto & [ name , time ] : times )
+  std::cout << std::left << std::setw( width ) << name << std::right
+            << std::setw( 8 ) << time.blocks << std::fixed
+            << std::setprecision( 4 ) << std::setw( 12 ) << time.variables
+            << std::setw( 12 ) << time.constraints << std::setw( 12 )
+            << time.objective << "\n";
+ std::cout << std::endl;
+
+ // the memory by classname of sub-Block, as reported by get_memory_usage()
+ std::map< std::string , MemoryUsage > memory;
+ for( auto b : sub )
+  if( auto unit = dynamic_cast< const UnitBlock * >( b ) )
+   memory[ b->classname() ] += unit->get_memory_usage();
+  else
+   if( auto network = dynamic_cast< const NetworkBlock * >( b ) )
+    memory[ b->classname() ] += network->get_memory_usage();
+   else
+    memory[ b->classname() ] += MemoryUsage::of_abstract( b );
+ auto & own = memory[ ucb->classname() ];
+ own = ucb->get_memory_usage();
+ for( const auto & [ name , usage ] : memory )
+  if( name != ucb->classname() )
+   own -= usage;
+
+ auto mb = []( std::size_t bytes ) { return( bytes / 1048576.0 ); };
+ std::cout << std::left << std::setw( width ) << "Memory (MB)" << std::right
+           << std::setw( 10 ) << "data" << std::setw( 10 ) << "variables"
+           << std::setw( 12 ) << "constraints" << std::setw( 13 )
+           << "coefficients" << std::setw( 10 ) << "solver"
+           << std::setw( 10 ) << "total" << "\n";
+ for( const auto & [ name , usage ] : memory )
+  std::cout << std::left << std::setw( width ) << name << std::right
+            << std::fixed << std::setprecision( 2 ) << std::setw( 10 )
+            << mb( usage.data ) << std::setw( 10 ) << mb( usage.variables )
+            << std::setw( 12 ) << mb( usage.constraints ) << std::setw( 13 )
+            << mb( usage.coefficients ) << std::setw( 10 )
+            << mb( usage.solver ) << std::setw( 10 ) << mb( usage.total() )
+            << "\n";
+ std::cout << std::endl;
+
+ delete( ucb );
+}
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- COMMAND LINE --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+/// Gets the name of the executable from its full path
+std::string get_filename( const std::string & fullpath ) {
+ std::size_t found = fullpath.find_last_of( "/\\" );
+ return( fullpath.substr( found + 1 ) );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// Prints the tool description and usage
+void docopt( void ) {
+ // http://docopt.org
+ std::cout << docopt_desc << std::endl;
+ std::cout << "Usage:\n"
+           << "  " << exe << " [options] <input>\n"
+           << "  " << exe << " -h | --help\n"
+           << std::endl
+           << "Options:\n"
+           << "  -c, --config <file>    BlockConfig to apply to the UCBlock.\n"
+           << "  -v, --verbose          Make the tool verbose.\n"
+           << "  -h, --help             Print this help.\n";
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// Processes command line arguments
+void process_args( int argc , char ** argv ) {
+
+ const char * const short_opts = "c:vh";
+ const option long_opts[] = {
+  { "config" ,  required_argument , nullptr , 'c' } ,
+  { "verbose" , no_argument ,       nullptr , 'v' } ,
+  { "help" ,    no_argument ,       nullptr , 'h' } ,
+  { nullptr ,   no_argument ,       nullptr , 0 }
+ };
+
+ // Options
+ while( true ) {
+  const auto opt = getopt_long( argc , argv , short_opts , long_opts ,
+                                nullptr );
+
+  if( -1 == opt ) {
+   break;
+  }
+  switch( opt ) {
+   case 'c':
+    config_path = std::string( optarg );
+    break;
+   case 'v':
+    verbose = true;
+    break;
+   case 'h':
+    docopt();
+    exit( 0 );
+   case '?':
+   default:
+    std::cout << "Try " << exe << "' --help' for more information.\n";
+    exit( 1 );
+  }
+ }
+
+ // Last argument
+ if( optind == argc - 1 )
+  input_path = std::string( argv[ optind ] );
+ else {
+  std::cout << exe << ": exactly one input file is needed\n"
+            << "Try " << exe << "' --help' for more information.\n";
+  exit( 1 );
+ }
+}
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------------- MAIN ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+int main( int argc , char ** argv ) {
+
+ // Manage options and help
+ docopt_desc = "UCBlock model-size profiler.\n";
+ exe = get_filename( argv[ 0 ] );
+ process_args( argc , argv );
+
+ try {
+  run();
+ } catch( std::exception & e ) {
+  std::cerr << exe << ": " << e.what() << std::endl;
+  return( 1 );
+ }
+
+ return( 0 );
+}
@@ -0,0 +1,606 @@
+/*--------------------------------------------------------------------------*/
+/*----------------------- File ucblock_validate.cpp ------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ * Small main() for validating UCBlock netCDF files offline.
+ *
+ * Each file is loaded with all the checks on its data enabled (see
+ * UCBlock::set_trust_validated()), i.e., those on the netCDF dimensions and
+ * variables (if the UCBlock library has been compiled without NDEBUG) and
+ * the data consistency checks of the UnitBlock. If the UCBlock is
+ * successfully loaded and the --mark option is given, the "Validated"
+ * attribute is written into its group with the checksum of its structure
+ * (see UCBlock::data_checksum()), so that the later loads of the file skip
+ * these checks as long as the structure is not changed (see
+ * UCBlock::deserialize()), together with the "ValidatedContent" one with
+ * the checksum of all its data. Since the loads do not check the latter,
+ * the --verify option checks that both still match the data of marked
+ * files, which catches the changes to the values of the variables.
+ *
+ * With the --self-check option, the methods of the UCBlock that have no
+ * other test are also exercised on each loaded file, and any mismatch makes
+ * the file fail:
+ *
+ * - "clone": clone() gives a UCBlock that serializes to the same data;
+ *
+ * - "delta": the linear term of a ThermalUnitBlock (if any) of a clone is
+ *   changed, serialize_delta() writes the delta between the two, and
+ *   apply_delta() of it on another clone gives the changed data;
+ *
+ * - "staging": the UnitBlock of two clones, each with its abstract
+ *   representation and a Solver counting the Modification, are scaled
+ *   concurrently (between begin_concurrent_updates() and
+ *   end_concurrent_updates()) and one after the other, respectively; the
+ *   two must then have the same data, the same number of Modification and
+ *   the same ViolationSummary for the same solution;
+ *
+ * - "solution": serialize_solution() of a made-up solution, followed by
+ *   deserialize_solution() after the Variable are zeroed, gives it back;
+ *
+ * - "feasibility": is_feasible() and check_feasibility(), with and without
+ *   the summary and with one or more threads, agree on that solution.
+ *
+ * Since neither the netCDF library nor the HDF5 one is thread-safe, the
+ * files are validated in parallel by running up to --jobs child processes,
+ * each taking care of one file.
+ *
+ * \author The UCBlock contributors
+ *
+ * \copyright &copy; by the UCBlock contributors
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <thread>
+#include <getopt.h>
+#include <netcdf.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Solver.h"
+#include "ThermalUnitBlock.h"
+#include "UCBlock.h"
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ Other stuff -------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+using namespace SMSpp_di_unipi_it;
+
+std::vector< std::string > input_paths{};  ///< the files to validate
+std::string group_name{ "Block_0" };  ///< the UCBlock group of the files
+bool mark = false;            ///< if the valid files are marked as such
+bool verify = false;          ///< if the marks of the files are verified
+bool self_check = false;      ///< if the UCBlock methods are self-checked
+unsigned int jobs = 1;        ///< maximum number of concurrent processes
+std::string exe{};            ///< name of the executable file
+std::string docopt_desc{};    ///< tool description
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- THE SELF-CHECK ------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+/// a scratch in-memory netCDF-4 file, discarded when destroyed
+class Scratch
+{
+ public:
+
+ Scratch( void ) {
+  static unsigned long counter = 0;
+  const auto name = "ucblock_validate_" + std::to_string( counter++ ) +
+                    ".nc4";
+  if( nc_create( name.c_str() , NC_NETCDF4 | NC_DISKLESS , & ncid ) !=
+      NC_NOERR )
+   throw( std::runtime_error( "cannot create a scratch netCDF file" ) );
+ }
+
+ ~Scratch() { nc_close( ncid ); }
+
+ /// returns the root group of the file
+ netCDF::NcGroup group( void ) const { return( netCDF::NcGroup( ncid ) ); }
+
+ private:
+
+ int ncid;
+};
+
+/*--------------------------------------------------------------------------*/
+
+/// a Solver that solves nothing, but keeps the Modification it receives
+class CountingSolver : public Solver
+{
+ public:
+
+ int compute( bool = true ) override { return( kError ); }
+
+ bool has_var_solution( void ) override { return( false ); }
+
+ void get_var_solution( Configuration * = nullptr ) override {}
+
+ OFValue get_lb( void ) override { return( -Inf< OFValue >() ); }
+
+ OFValue get_ub( void ) override { return( Inf< OFValue >() ); }
+
+ OFValue get_var_value( void ) override { return( 0 ); }
+
+ /// returns the number of Modification received so far
+ std::size_t count( void ) {
+  while( f_mod_lock.test_and_set( std::memory_order_acquire ) )
+   ;
+  const auto n = v_mod.size();
+  f_mod_lock.clear( std::memory_order_release );
+  return( n );
+ }
+};
+
+/*--------------------------------------------------------------------------*/
+
+/// throws if cond is false, naming the check that failed
+void expect( bool cond , const std::string & check ,
+             const std::string & what ) {
+ if( ! cond )
+  throw( std::logic_error( "self-check \"" + check + "\" failed: " +
+                           what ) );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// returns the checksum of all the data of the serialized UCBlock
+std::uint64_t content_checksum( const UCBlock & ucb ) {
+ Scratch scratch;
+ auto group = scratch.group();
+ ucb.serialize( group );
+ return( UCBlock::data_checksum( group , true ) );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// calls f( var ) on each Variable saved by UCBlock::serialize_solution()
+template< class F >
+void for_each_solution_variable( UCBlock & ucb , F f ) {
+ using VarGetter = ColVariable * ( UnitBlock::* )( Block::Index );
+ static const VarGetter getters[] = {
+  & UnitBlock::get_commitment , & UnitBlock::get_active_power ,
+  & UnitBlock::get_primary_spinning_reserve ,
+  & UnitBlock::get_secondary_spinning_reserve };
+
+ const auto T = ucb.get_time_horizon();
+ for( Block::Index u = 0 ; u < ucb.get_number_units() ; ++u ) {
+  auto unit = ucb.get_unit_block( u );
+  for( Block::Index g = 0 ; g < unit->get_number_generators() ; ++g )
+   for( auto getter : getters )
+    if( auto var = ( unit->*getter )( g ) )
+     for( Block::Index t = 0 ; t < T ; ++t )
+      f( var[ t ] );
+  for( Block::Index s = 0 ; s < unit->get_number_storages() ; ++s )
+   if( auto var = unit->get_storage( s ) )
+    for( Block::Index t = 0 ; t < T ; ++t )
+     f( var[ t ] );
+ }
+
+ const auto & nbs = ucb.get_network_blocks();
+ if( nbs.empty() ||
+     std::any_of( nbs.begin() , nbs.end() ,
+                  []( NetworkBlock * nb ) { return( nb == nullptr ); } ) )
+  return;
+ for( auto nb : nbs )
+  for( Block::Index i = 0 ; i < nb->get_number_intervals() ; ++i )
+   if( auto var = nb->get_node_injection( i ) )
+    for( Block::Index n = 0 ; n < nb->get_number_nodes() ; ++n )
+     f( var[ n ] );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// the made-up value of the i-th Variable of a solution
+double made_up_value( std::size_t i ) {
+ return( double( ( i * 7919 ) % 101 ) / 10 );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// writes the made-up solution into the Variable of ucb
+void set_made_up_solution( UCBlock & ucb ) {
+ std::size_t i = 0;
+ for_each_solution_variable( ucb , [ & i ]( ColVariable & var ) {
+  var.set_value( made_up_value( i++ ) );
+ } );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// returns true if the two summaries are exactly the same
+bool same_summary( const std::vector< UCBlock::ViolationSummary > & a ,
+                   const std::vector< UCBlock::ViolationSummary > & b ) {
+ return( std::equal( a.begin() , a.end() , b.begin() , b.end() ,
+                     []( const auto & x , const auto & y ) {
+                      return( ( x.family == y.family ) &&
+                              ( x.rows == y.rows ) &&
+                              ( x.violated == y.violated ) &&
+                              ( x.max_violation == y.max_violation ) );
+                     } ) );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// checks clone(), see the file comment
+void check_clone( const UCBlock & ucb ) {
+ std::unique_ptr< UCBlock > copy( ucb.clone() );
+ expect( content_checksum( * copy ) == content_checksum( ucb ) , "clone" ,
+         "the clone has different data" );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// checks serialize_delta() and apply_delta(), see the file comment
+void check_delta( const UCBlock & ucb ) {
+ std::unique_ptr< UCBlock > variant( ucb.clone() );
+ ThermalUnitBlock * thermal = nullptr;
+ for( Block::Index u = 0 ; ( ! thermal ) && ( u < ucb.get_number_units() ) ;
+      ++u )
+  thermal = dynamic_cast< ThermalUnitBlock * >( variant->get_unit_block( u ) );
+ if( ! thermal )
+  return;  // nothing that a delta can change for sure
+
+ const auto T = variant->get_time_horizon();
+ std::vector< double > lt( T );
+ for( Block::Index t = 0 ; t < T ; ++t )
+  lt[ t ] = 1.01 * thermal->get_linear_term( t ) + 1;
+ thermal->set_linear_term( lt.cbegin() , Block::Range( 0 , T ) );
+
+ Scratch base , changed , delta;
+ auto base_group = base.group();
+ auto changed_group = changed.group();
+ auto delta_group = delta.group();
+ ucb.serialize( base_group );
+ variant->serialize( changed_group );
+ UCBlock::serialize_delta( base_group , changed_group , delta_group );
+
+ std::unique_ptr< UCBlock > applied( ucb.clone() );
+ applied->apply_delta( delta_group );
+ expect( content_checksum( * applied ) ==
+         UCBlock::data_checksum( changed_group , true ) , "delta" ,
+         "the applied delta does not give the changed data" );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// checks the concurrent update sessions, see the file comment
+void check_staging( const UCBlock & ucb ) {
+ std::unique_ptr< UCBlock > copies[ 2 ] = { std::unique_ptr< UCBlock >(
+  ucb.clone() ) , std::unique_ptr< UCBlock >( ucb.clone() ) };
+ CountingSolver * solvers[ 2 ];
+ for( int k = 0 ; k < 2 ; ++k ) {
+  copies[ k ]->generate_abstract_variables();
+  copies[ k ]->generate_abstract_constraints();
+  solvers[ k ] = new CountingSolver();
+  copies[ k ]->register_Solver( solvers[ k ] );
+ }
+
+ const auto units = ucb.get_number_units();
+ auto scale = []( UnitBlock * unit , Block::Index u ) {
+  unit->scale( ( 1 + 0.01 * ( u % 7 + 1 ) ) * unit->get_scale() ,
+               eModBlck , eModBlck );
+ };
+
+ // copies[ 0 ]: concurrently, by up to 4 threads taking turns over the units
+ copies[ 0 ]->begin_concurrent_updates();
+ {
+  std::vector< std::thread > threads;
+  const Block::Index number = std::min( Block::Index( 4 ) , units );
+  for( Block::Index k = 0 ; k < number ; ++k )
+   threads.emplace_back( [ & , k ]() {
+    for( Block::Index u = k ; u < units ; u += number )
+     scale( copies[ 0 ]->get_unit_block( u ) , u );
+   } );
+  for( auto & thread : threads )
+   thread.join();
+ }
+ copies[ 0 ]->end_concurrent_updates();
+
+ // copies[ 1 ]: one unit after the other
+ for( Block::Index u = 0 ; u < units ; ++u )
+  scale( copies[ 1 ]->get_unit_block( u ) , u );
+
+ std::vector< UCBlock::ViolationSummary > summary[ 2 ];
+ for( int k = 0 ; k < 2 ; ++k ) {
+  set_made_up_solution( * copies[ k ] );
+  copies[ k ]->check_feasibility( & summary[ k ] );
+ }
+ const bool same = ( solvers[ 0 ]->count() == solvers[ 1 ]->count() ) &&
+                   same_summary( summary[ 0 ] , summary[ 1 ] ) &&
+                   ( content_checksum( * copies[ 0 ] ) ==
+                     content_checksum( * copies[ 1 ] ) );
+
+ for( int k = 0 ; k < 2 ; ++k )
+  copies[ k ]->unregister_Solver( solvers[ k ] , true );
+ expect( same , "staging" , "the concurrent and the serial updates differ" );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// checks serialize_solution() and deserialize_solution(), see the file
+/// comment; leaves the made-up solution in the Variable of ucb
+void check_solution( UCBlock & ucb ) {
+ ucb.generate_abstract_variables();
+ set_made_up_solution( ucb );
+
+ Scratch scratch;
+ auto group = scratch.group();
+ ucb.serialize_solution( group , false , 0 );
+
+ for_each_solution_variable( ucb , []( ColVariable & var ) {
+  var.set_value( 0 );
+ } );
+ ucb.deserialize_solution( group , false );
+
+ std::size_t i = 0;
+ bool same = true;
+ for_each_solution_variable( ucb , [ & ]( ColVariable & var ) {
+  same &= ( var.get_value() == made_up_value( i++ ) );
+ } );
+ expect( same , "solution" , "the restored solution differs" );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// checks is_feasible() and check_feasibility(), see the file comment
+void check_feasibility_results( UCBlock & ucb ) {
+ ucb.generate_abstract_constraints();
+
+ const bool feasible = ucb.is_feasible();
+ std::vector< UCBlock::ViolationSummary > summary[ 2 ];
+ const bool results[] = { ucb.check_feasibility( nullptr , nullptr , 4 ) ,
+                          ucb.check_feasibility( & summary[ 0 ] ) ,
+                          ucb.check_feasibility( & summary[ 1 ] , nullptr ,
+                                                 4 ) };
+ const bool violated =
+  std::any_of( summary[ 0 ].begin() , summary[ 0 ].end() ,
+               []( const auto & s ) { return( s.violated > 0 ); } );
+
+ expect( std::all_of( std::begin( results ) , std::end( results ) ,
+                      [ feasible ]( bool r ) { return( r == feasible ); } ) ,
+         "feasibility" , "is_feasible() and check_feasibility() disagree" );
+ expect( violated != feasible , "feasibility" ,
+         "the summary does not match the result" );
+ expect( same_summary( summary[ 0 ] , summary[ 1 ] ) , "feasibility" ,
+         "the summary depends on the number of threads" );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// runs all the self-checks on ucb, see the file comment
+void run_self_check( UCBlock & ucb ) {
+ check_clone( ucb );
+ check_delta( ucb );
+ check_staging( ucb );
+ check_solution( ucb );
+ check_feasibility_results( ucb );
+}
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- THE VALIDATION ------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+/// verifies the marks of one file, returns the exit status of its process
+int verify_marks( const std::string & path ) {
+ try {
+  netCDF::NcFile f( path , netCDF::NcFile::read );
+  auto bg = f.getGroup( group_name );
+  if( bg.isNull() )
+   throw( std::invalid_argument( group_name + " not found" ) );
+
+  auto read = [ & bg ]( const std::string & name ) {
+   auto att = bg.getAtt( name );
+   if( att.isNull() ||
+       ( att.getType().getTypeClass() != netCDF::NcType::nc_UINT64 ) )
+    throw( std::invalid_argument( "not marked as validated" ) );
+   unsigned long long checksum = 0;
+   att.getValues( & checksum );
+   return( checksum );
+  };
+
+  if( ( read( "Validated" ) != UCBlock::data_checksum( bg ) ) ||
+      ( read( "ValidatedContent" ) != UCBlock::data_checksum( bg , true ) ) )
+   throw( std::invalid_argument( "changed since it has been validated" ) );
+ } catch( std::exception & e ) {
+  std::cerr << path + ": " + e.what() + "\n";
+  return( 1 );
+ }
+
+ std::cout << path + ": OK (verified)\n";
+ return( 0 );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// validates one file, returns the exit status of its process
+int validate( const std::string & path ) {
+ if( verify )
+  return( verify_marks( path ) );
+
+ try {
+  {
+   netCDF::NcFile f( path , netCDF::NcFile::read );
+   auto bg = f.getGroup( group_name );
+   if( bg.isNull() )
+    throw( std::invalid_argument( group_name + " not found" ) );
+   std::unique_ptr< Block > b( Block::new_Block( bg ) );
+   auto ucb = dynamic_cast< UCBlock * >( b.get() );
+   if( ! ucb )
+    throw( std::invalid_argument( "not a UCBlock" ) );
+   if( self_check )
+    run_self_check( * ucb );
+  }
+
+  if( mark ) {
+   netCDF::NcFile f( path , netCDF::NcFile::write );
+   auto bg = f.getGroup( group_name );
+   unsigned long long checksum = UCBlock::data_checksum( bg );
+   unsigned long long content = UCBlock::data_checksum( bg , true );
+   bg.putAtt( "Validated" , netCDF::NcUint64() , 1 , & checksum );
+   bg.putAtt( "ValidatedContent" , netCDF::NcUint64() , 1 , & content );
+  }
+ } catch( std::exception & e ) {
+  std::cerr << path + ": " + e.what() + "\n";
+  return( 1 );
+ }
+
+ std::cout << path + ": OK" + ( self_check ? " (self-checked)" : "" ) +
+              ( mark ? " (marked)\n" : "\n" );
+ return( 0 );
+}
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- COMMAND LINE --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+/// Gets the name of the executable from its full path
+std::string get_filename( const std::string & fullpath ) {
+ std::size_t found = fullpath.find_last_of( "/\\" );
+ return( fullpath.substr( found + 1 ) );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// Prints the tool description and usage
+void docopt( void ) {
+ // http://docopt.org
+ std::cout << docopt_desc << std::endl;
+ std::cout << "Usage:\n"
+           << "  " << exe << " [options] <file>...\n"
+           << "  " << exe << " -h | --help\n"
+           << std::endl
+           << "Options:\n"
+           << "  -g, --group <name>     UCBlock group [default: Block_0].\n"
+           << "  -j, --jobs <n>         Number of parallel processes "
+              "[default: 1].\n"
+           << "  -m, --mark             Mark the valid files as validated.\n"
+           << "  -v, --verify           Only verify the marks of the files.\n"
+           << "  -s, --self-check       Also self-check the UCBlock methods.\n"
+           << "  -h, --help             Print this help.\n";
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// Processes command line arguments
+void process_args( int argc , char ** argv ) {
+
+ const char * const short_opts = "g:j:mvsh";
+ const option long_opts[] = {
+  { "group" , required_argument , nullptr , 'g' } ,
+  { "jobs" ,  required_argument , nullptr , 'j' } ,
+  { "mark" ,  no_argument ,       nullptr , 'm' } ,
+  { "verify" , no_argument ,      nullptr , 'v' } ,
+  { "self-check" , no_argument ,  nullptr , 's' } ,
+  { "help" ,  no_argument ,       nullptr , 'h' } ,
+  { nullptr , no_argument ,       nullptr , 0 }
+ };
+
+ // Options
+ while( true ) {
+  const auto opt = getopt_long( argc , argv , short_opts , long_opts ,
+                                nullptr );
+
+  if( -1 == opt ) {
+   break;
+  }
+  switch( opt ) {
+   case 'g':
+    group_name = std::string( optarg );
+    break;
+   case 'j':
+    jobs = std::max( 1 , std::atoi( optarg ) );
+    break;
+   case 'm':
+    mark = true;
+    break;
+   case 'v':
+    verify = true;
+    break;
+   case 's':
+    self_check = true;
+    break;
+   case 'h':
+    docopt();
+    exit( 0 );
+   case '?':
+   default:
+    std::cout << "Try " << exe << "' --help' for more information.\n";
+    exit( 1 );
+  }
+ }
+
+ // Last arguments
+ for( ; optind < argc ; ++optind )
+  input_paths.push_back( std::string( argv[ optind ] ) );
+
+ if( input_paths.empty() ) {
+  std::cout << exe << ": at least one input file is needed\n"
+            << "Try " << exe << "' --help' for more information.\n";
+  exit( 1 );
+ }
+}
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------------- MAIN ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+int main( int argc , char ** argv ) {
+
+ // Manage options and help
+ docopt_desc = "UCBlock netCDF file validator.\n";
+ exe = get_filename( argv[ 0 ] );
+ process_args( argc , argv );
+
+ UCBlock::set_trust_validated( false );
+
+ std::map< pid_t , std::string > running;
+ unsigned int failed = 0;
+
+ // wait for one child process, and record its outcome
+ auto wait_one = [ & running , & failed ]() {
+  int status = 0;
+  const auto pid = wait( & status );
+  auto it = running.find( pid );
+  if( it == running.end() ) {
+   failed += running.size();
+   running.clear();
+   return;
+  }
+  if( ! WIFEXITED( status ) )
+   std::cerr << it->second + ": terminated abnormally\n";
+  if( ( ! WIFEXITED( status ) ) || WEXITSTATUS( status ) )
+   ++failed;
+  running.erase( it );
+ };
+
+ std::cout.flush();
+ for( const auto & path : input_paths ) {
+  if( running.size() == jobs )
+   wait_one();
+
+  const auto pid = fork();
+  if( pid < 0 ) {
+   std::cerr << exe << ": cannot fork, validating " << path
+             << " in place\n";
+   failed += validate( path );
+   continue;
+  }
+  if( pid == 0 ) {
+   const int status = validate( path );
+   std::cout.flush();
+   _exit( status );
+  }
+  running[ pid ] = path;
+ }
+ while( ! running.empty() )
+  wait_one();
+
+ std::cout << input_paths.size() - failed << " of " << input_paths.size()
+           << " files valid" << std::endl;
+
+ return( failed ? 1 : 0 );
+}
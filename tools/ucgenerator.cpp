@@ -0,0 +1,583 @@
+/*--------------------------------------------------------------------------*/
+/*-------------------------- File ucgenerator.cpp --------------------------*/
+/*--------------------------------------------------------------------------*/
+/** @file
+ * Small main() for constructing synthetic UCBlock netCDF files of arbitrary
+ * size, mainly meant for benchmarking and stress-testing purposes.
+ *
+ * The generated UCBlock has a controllable mix of ThermalUnitBlock,
+ * HydroUnitBlock (one reservoir and one turbine each), BatteryUnitBlock and
+ * IntermittentUnitBlock, a DC network with a given number of nodes and lines
+ * (a random spanning tree plus random extra lines), and a given number of
+ * primary / secondary / inertia reserve zones. All the data is drawn from a
+ * std::mt19937_64 (whose output is fixed by the standard) with "hand-made"
+ * distributions, so that the same seed produces the same instance on every
+ * platform. The data is "plausible", and the demand is scaled so as to be a
+ * given fraction of the dispatchable capacity, but there is no guarantee
+ * that the instance is feasible, especially with tight networks.
+ *
+ * The file is written one group (or row of a time series) at a time, so
+ * that the memory footprint is O( NumberUnits + NumberNodes + TimeHorizon )
+ * irrespectively of the size of the instance.
+ *
+ * \author The UCBlock contributors
+ *
+ * \copyright &copy; by the UCBlock contributors
+ */
+
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <getopt.h>
+
+#include <SMSTypedefs.h>
+
+/*--------------------------------------------------------------------------*/
+/*------------------------------ Other stuff -------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+using namespace SMSpp_di_unipi_it;
+
+unsigned int n_thermal = 10;         ///< number of ThermalUnitBlock
+unsigned int n_hydro = 0;            ///< number of HydroUnitBlock
+unsigned int n_battery = 0;          ///< number of BatteryUnitBlock
+unsigned int n_intermittent = 0;     ///< number of IntermittentUnitBlock
+unsigned int n_nodes = 1;            ///< number of nodes of the network
+unsigned int n_lines = 0;            ///< number of lines (0 = nodes + nodes/2)
+unsigned int n_primary = 0;          ///< number of primary reserve zones
+unsigned int n_secondary = 0;        ///< number of secondary reserve zones
+unsigned int n_inertia = 0;          ///< number of inertia zones
+unsigned int time_horizon = 24;      ///< the time horizon
+unsigned long seed = 0;              ///< the random seed
+double load_factor = 0.7;            ///< peak demand / dispatchable capacity
+double line_factor = 1;              ///< scaling of the line capacities
+int deflate_level = 0;               ///< deflate level of the time series
+bool shuffle = false;                ///< shuffle filter on the time series
+
+std::string output_path{};    ///< output file name
+bool verbose = false;         ///< if the tool should be verbose
+std::string exe{};            ///< name of the executable file
+std::string docopt_desc{};    ///< tool description
+
+std::mt19937_64 rng;          ///< the random number generator
+
+/*--------------------------------------------------------------------------*/
+
+/// returns a uniformly distributed double in [ a , b ]
+/** std::uniform_real_distribution is implementation-defined, hence it would
+ * make the instances depend on the standard library: the 53 high-order bits
+ * of the (standard) std::mt19937_64 output are used directly instead. */
+
+double uniform( double a , double b ) {
+ return( a + ( b - a ) * double( rng() >> 11 ) * 0x1.0p-53 );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// returns a uniformly distributed integer in { lo , ... , hi }
+
+unsigned int uniform_int( unsigned int lo , unsigned int hi ) {
+ return( lo + static_cast< unsigned int >( rng() % ( hi - lo + 1 ) ) );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// writes a scalar double variable indexed over two dimensions of size 1
+
+void serialize_11( netCDF::NcGroup & g , const std::string & name ,
+                   const netCDF::NcDim & d1 , const netCDF::NcDim & d2 ,
+                   double value ) {
+ auto var = g.addVar( name , netCDF::NcDouble() , { d1 , d2 } );
+ var.putVar( & value );
+}
+
+/// adds a double time series variable, with the last dimension being time
+/** The variable is chunked "time-major", one time profile per chunk, and
+ * compressed according to deflate_level and shuffle; cf. UCBlock::NcStorage,
+ * of which this is the default behaviour. */
+
+netCDF::NcVar add_series( netCDF::NcGroup & g , const std::string & name ,
+                          const std::vector< netCDF::NcDim > & dims ) {
+ auto var = g.addVar( name , netCDF::NcDouble() , dims );
+ std::vector< std::size_t > chunk( dims.size() , 1 );
+ chunk.back() = std::max( dims.back().getSize() , std::size_t( 1 ) );
+ var.setChunking( netCDF::NcVar::nc_CHUNKED , chunk );
+ if( deflate_level || shuffle )
+  var.setCompression( shuffle , deflate_level > 0 , deflate_level );
+ return( var );
+}
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- UNIT GENERATORS -----------------------------*/
+/*--------------------------------------------------------------------------*/
+
+/// generates a ThermalUnitBlock, returns its maximum power
+
+double generate_thermal( netCDF::NcGroup & g ) {
+ g.putAtt( "type" , "ThermalUnitBlock" );
+
+ double MaxPower = uniform( 50 , 500 );
+ double MinPower = uniform( 0.2 , 0.5 ) * MaxPower;
+ double ramp = uniform( 0.3 , 1 ) * MaxPower;
+ unsigned int hmax = std::min( time_horizon , 8u );
+ int MinUpTime = uniform_int( 1 , hmax );
+ int MinDownTime = uniform_int( 1 , hmax );
+ bool on = rng() & 1;
+ int InitUpDownTime = on ? int( uniform_int( 1 , 2 * hmax ) )
+                         : - int( uniform_int( 1 , 2 * hmax ) );
+
+ serialize( g , "MinPower" , netCDF::NcDouble() , MinPower );
+ serialize( g , "MaxPower" , netCDF::NcDouble() , MaxPower );
+ serialize( g , "DeltaRampUp" , netCDF::NcDouble() , ramp );
+ serialize( g , "DeltaRampDown" , netCDF::NcDouble() , ramp );
+ serialize( g , "QuadTerm" , netCDF::NcDouble() , uniform( 0 , 0.002 ) );
+ // larger units are cheaper per MWh
+ serialize( g , "LinearTerm" , netCDF::NcDouble() ,
+            70 - 0.08 * MaxPower + uniform( -5 , 5 ) );
+ serialize( g , "ConstTerm" , netCDF::NcDouble() , uniform( 100 , 1000 ) );
+ serialize( g , "StartUpCost" , netCDF::NcDouble() ,
+            uniform( 5 , 15 ) * MaxPower );
+ serialize( g , "InitialPower" , netCDF::NcDouble() , on ? MinPower : 0.0 );
+ serialize( g , "InitUpDownTime" , netCDF::NcInt64() , InitUpDownTime );
+ serialize( g , "MinUpTime" , netCDF::NcUint64() , MinUpTime );
+ serialize( g , "MinDownTime" , netCDF::NcUint64() , MinDownTime );
+
+ if( n_primary )
+  serialize( g , "PrimaryRho" , netCDF::NcDouble() , uniform( 0 , 0.1 ) );
+ if( n_secondary )
+  serialize( g , "SecondaryRho" , netCDF::NcDouble() , uniform( 0 , 0.2 ) );
+ if( n_inertia )
+  serialize( g , "InertiaCommitment" , netCDF::NcDouble() ,
+             uniform( 2 , 6 ) * MaxPower );
+
+ return( MaxPower );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// generates a single-reservoir HydroUnitBlock, returns its maximum power
+
+double generate_hydro( netCDF::NcGroup & g , std::vector< double > & buf ) {
+ g.putAtt( "type" , "HydroUnitBlock" );
+
+ auto TimeHorizon = g.getParentGroup().getDim( "TimeHorizon" );
+ auto NumberReservoirs = g.addDim( "NumberReservoirs" , 1 );
+ auto NumberArcs = g.addDim( "NumberArcs" , 1 );
+ auto NumberIntervals = g.addDim( "NumberIntervals" , 1 );
+
+ double MaxPower = uniform( 50 , 300 );
+ double rho = uniform( 0.5 , 1.5 );  // power per unit of flow
+ double MaxFlow = MaxPower / rho;
+ double MaxVol = MaxFlow * time_horizon * uniform( 0.5 , 2 );
+
+ serialize( g , "StartArc" , netCDF::NcUint() , NumberArcs ,
+            std::vector< unsigned int >( 1 , 0 ) );
+ serialize( g , "EndArc" , netCDF::NcUint() , NumberArcs ,
+            std::vector< unsigned int >( 1 , 1 ) );
+ serialize( g , "LinearTerm" , netCDF::NcDouble() , NumberArcs ,
+            std::vector< double >( 1 , rho ) );
+ serialize( g , "ConstantTerm" , netCDF::NcDouble() , NumberArcs ,
+            std::vector< double >( 1 , 0.0 ) );
+ serialize( g , "InitialFlowRate" , netCDF::NcDouble() , NumberArcs ,
+            std::vector< double >( 1 , 0.0 ) );
+ serialize( g , "InitialVolumetric" , netCDF::NcDouble() , NumberReservoirs ,
+            std::vector< double >( 1 , uniform( 0.3 , 0.7 ) * MaxVol ) );
+
+ serialize_11( g , "MaxFlow" , NumberIntervals , NumberArcs , MaxFlow );
+ serialize_11( g , "MaxPower" , NumberIntervals , NumberArcs , MaxPower );
+ serialize_11( g , "MaxVolumetric" , NumberReservoirs , NumberIntervals ,
+               MaxVol );
+ if( n_primary )
+  serialize_11( g , "PrimaryRho" , NumberIntervals , NumberArcs ,
+                uniform( 0 , 0.1 ) );
+ if( n_secondary )
+  serialize_11( g , "SecondaryRho" , NumberIntervals , NumberArcs ,
+                uniform( 0 , 0.2 ) );
+
+ // inflows: a yearly sinusoid plus some noise, on average 40% of MaxFlow
+ double phase = uniform( 0 , 2 * M_PI );
+ for( unsigned int t = 0 ; t < time_horizon ; ++t )
+  buf[ t ] = MaxFlow * ( 0.4 + 0.2 * std::sin( phase + 2 * M_PI * t / 8760 )
+                         + uniform( -0.05 , 0.05 ) );
+
+ auto Inflows = add_series( g , "Inflows" ,
+                            { NumberReservoirs , TimeHorizon } );
+ Inflows.putVar( buf.data() );
+
+ return( MaxPower );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// generates a BatteryUnitBlock, returns its maximum (discharging) power
+
+double generate_battery( netCDF::NcGroup & g ) {
+ g.putAtt( "type" , "BatteryUnitBlock" );
+
+ double MaxPower = uniform( 10 , 100 );
+ double MaxStorage = uniform( 2 , 6 ) * MaxPower;
+
+ serialize( g , "MaxPower" , netCDF::NcDouble() , MaxPower );
+ serialize( g , "MinPower" , netCDF::NcDouble() , - MaxPower );
+ serialize( g , "MinStorage" , netCDF::NcDouble() , 0.0 );
+ serialize( g , "MaxStorage" , netCDF::NcDouble() , MaxStorage );
+ serialize( g , "InitialStorage" , netCDF::NcDouble() , 0.5 * MaxStorage );
+ serialize( g , "StoringBatteryRho" , netCDF::NcDouble() ,
+            uniform( 0.85 , 0.95 ) );
+ serialize( g , "ExtractingBatteryRho" , netCDF::NcDouble() ,
+            uniform( 0.85 , 0.95 ) );
+ if( n_primary )
+  serialize( g , "MaxPrimaryPower" , netCDF::NcDouble() , 0.1 * MaxPower );
+ if( n_secondary )
+  serialize( g , "MaxSecondaryPower" , netCDF::NcDouble() , 0.2 * MaxPower );
+
+ return( MaxPower );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// generates an IntermittentUnitBlock with either a solar or a wind profile
+
+void generate_intermittent( netCDF::NcGroup & g ,
+                            std::vector< double > & buf ) {
+ g.putAtt( "type" , "IntermittentUnitBlock" );
+
+ auto TimeHorizon = g.getParentGroup().getDim( "TimeHorizon" );
+ double capacity = uniform( 20 , 200 );
+
+ if( rng() & 1 ) {  // solar: a bell during daytime hours
+  for( unsigned int t = 0 ; t < time_horizon ; ++t ) {
+   double s = std::sin( M_PI * ( double( t % 24 ) - 6 ) / 12 );
+   buf[ t ] = s > 0 ? capacity * s * uniform( 0.6 , 1 ) : 0;
+  }
+ } else {             // wind: a bounded random walk
+  double w = uniform( 0 , 1 );
+  for( unsigned int t = 0 ; t < time_horizon ; ++t ) {
+   w = std::min( 1.0 , std::max( 0.0 , w + uniform( -0.1 , 0.1 ) ) );
+   buf[ t ] = capacity * w;
+  }
+ }
+
+ add_series( g , "MaxPower" , { TimeHorizon } ).putVar( buf.data() );
+ serialize( g , "MinPower" , netCDF::NcDouble() , 0.0 );
+}
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------- COMMAND LINE --------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+/// Gets the name of the executable from its full path
+std::string get_filename( const std::string & fullpath ) {
+ std::size_t found = fullpath.find_last_of( "/\\" );
+ return( fullpath.substr( found + 1 ) );
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// Prints the tool description and usage
+void docopt( void ) {
+ // http://docopt.org
+ std::cout << docopt_desc << std::endl;
+ std::cout << "Usage:\n"
+           << "  " << exe << " [options] <output>\n"
+           << "  " << exe << " -h | --help\n"
+           << std::endl
+           << "Options:\n"
+           << "  -T, --horizon <T>       Time horizon [default: 24].\n"
+           << "  -t, --thermal <n>       Thermal units [default: 10].\n"
+           << "  -y, --hydro <n>         Hydro units [default: 0].\n"
+           << "  -b, --battery <n>       Battery units [default: 0].\n"
+           << "  -i, --intermittent <n>  Intermittent units [default: 0].\n"
+           << "  -n, --nodes <n>         Network nodes [default: 1].\n"
+           << "  -l, --lines <n>         Network lines [default: 3n/2].\n"
+           << "  -p, --primary <n>       Primary zones [default: 0].\n"
+           << "  -q, --secondary <n>     Secondary zones [default: 0].\n"
+           << "  -e, --inertia <n>       Inertia zones [default: 0].\n"
+           << "  -L, --load <f>          Peak load/capacity [default: 0.7].\n"
+           << "  -c, --capacity <f>      Line capacity scale [default: 1].\n"
+           << "  -s, --seed <s>          Random seed [default: 0].\n"
+           << "  -z, --deflate <l>       Deflate level 0-9 of the time "
+              "series [default: 0].\n"
+           << "  -S, --shuffle           Shuffle filter on the time series.\n"
+           << "  -v, --verbose           Make the tool verbose.\n"
+           << "  -h, --help              Print this help.\n";
+}
+
+/*--------------------------------------------------------------------------*/
+
+/// Processes command line arguments
+void process_args( int argc , char ** argv ) {
+
+ const char * const short_opts = "T:t:y:b:i:n:l:p:q:e:L:c:s:z:Svh";
+ const option long_opts[] = {
+  { "horizon" ,      required_argument , nullptr , 'T' } ,
+  { "thermal" ,      required_argument , nullptr , 't' } ,
+  { "hydro" ,        required_argument , nullptr , 'y' } ,
+  { "battery" ,      required_argument , nullptr , 'b' } ,
+  { "intermittent" , required_argument , nullptr , 'i' } ,
+  { "nodes" ,        required_argument , nullptr , 'n' } ,
+  { "lines" ,        required_argument , nullptr , 'l' } ,
+  { "primary" ,      required_argument , nullptr , 'p' } ,
+  { "secondary" ,    required_argument , nullptr , 'q' } ,
+  { "inertia" ,      required_argument , nullptr , 'e' } ,
+  { "load" ,         required_argument , nullptr , 'L' } ,
+  { "capacity" ,     required_argument , nullptr , 'c' } ,
+  { "seed" ,         required_argument , nullptr , 's' } ,
+  { "deflate" ,      required_argument , nullptr , 'z' } ,
+  { "shuffle" ,      no_argument ,       nullptr , 'S' } ,
+  { "verbose" ,      no_argument ,       nullptr , 'v' } ,
+  { "help" ,         no_argument ,       nullptr , 'h' } ,
+  { nullptr ,        no_argument ,       nullptr , 0 }
+ };
+
+ // Options
+ while( true ) {
+  const auto opt = getopt_long( argc , argv , short_opts , long_opts ,
+                                nullptr );
+
+  if( -1 == opt ) {
+   break;
+  }
+  switch( opt ) {
+   case 'T':
+    time_horizon = std::stoul( optarg );
+    break;
+   case 't':
+    n_thermal = std::stoul( optarg );
+    break;
+   case 'y':
+    n_hydro = std::stoul( optarg );
+    break;
+   case 'b':
+    n_battery = std::stoul( optarg );
+    break;
+   case 'i':
+    n_intermittent = std::stoul( optarg );
+    break;
+   case 'n':
+    n_nodes = std::stoul( optarg );
+    break;
+   case 'l':
+    n_lines = std::stoul( optarg );
+    break;
+   case 'p':
+    n_primary = std::stoul( optarg );
+    break;
+   case 'q':
+    n_secondary = std::stoul( optarg );
+    break;
+   case 'e':
+    n_inertia = std::stoul( optarg );
+    break;
+   case 'L':
+    load_factor = std::stod( optarg );
+    break;
+   case 'c':
+    line_factor = std::stod( optarg );
+    break;
+   case 's':
+    seed = std::stoul( optarg );
+    break;
+   case 'z':
+    deflate_level = std::min( std::max( std::stoi( optarg ) , 0 ) , 9 );
+    break;
+   case 'S':
+    shuffle = true;
+    break;
+   case 'v':
+    verbose = true;
+    break;
+   case 'h':
+    docopt();
+    exit( 0 );
+   case '?':
+   default:
+    std::cout << "Try " << exe << "' --help' for more information.\n";
+    exit( 1 );
+  }
+ }
+
+ // Last argument
+ if( optind < argc ) {
+  output_path = std::string( argv[ optind ] );
+ } else {
+  std::cout << exe << ": no output file\n"
+            << "Try " << exe << "' --help' for more information.\n";
+  exit( 1 );
+ }
+
+ // Check consistency
+ if( ( ! time_horizon ) || ( ! n_nodes ) ||
+     ( n_thermal + n_hydro + n_battery + n_intermittent == 0 ) ) {
+  std::cerr << exe << ": empty instance requested" << std::endl;
+  exit( 1 );
+ }
+ if( ( n_primary > n_nodes ) || ( n_secondary > n_nodes ) ||
+     ( n_inertia > n_nodes ) ) {
+  std::cerr << exe << ": more reserve zones than nodes" << std::endl;
+  exit( 1 );
+ }
+ if( n_nodes == 1 )
+  n_lines = 0;
+ else {
+  if( ! n_lines )
+   n_lines = n_nodes + n_nodes / 2;
+  if( n_lines < n_nodes - 1 ) {
+   std::cerr << exe << ": at least " << n_nodes - 1
+             << " lines are needed for a connected network" << std::endl;
+   exit( 1 );
+  }
+ }
+}
+
+/*--------------------------------------------------------------------------*/
+/*---------------------------------- MAIN ----------------------------------*/
+/*--------------------------------------------------------------------------*/
+
+int main( int argc , char ** argv ) {
+
+ // Manage options and help
+ docopt_desc = "NC4 synthetic UCBlock generator.\n";
+ exe = get_filename( argv[ 0 ] );
+ process_args( argc , argv );
+
+ rng.seed( seed );
+
+ unsigned int n_units = n_thermal + n_hydro + n_battery + n_intermittent;
+
+ netCDF::NcFile f( output_path , netCDF::NcFile::replace );
+ f.putAtt( "SMS++_file_type" , netCDF::NcInt() , eBlockFile );
+
+ auto bg = f.addGroup( "Block_0" );
+ bg.putAtt( "type" , "UCBlock" );
+ auto TimeHorizon = bg.addDim( "TimeHorizon" , time_horizon );
+ bg.addDim( "NumberUnits" , n_units );
+ auto NumberNodes = bg.addDim( "NumberNodes" , n_nodes );
+ auto NumberGenerators = bg.addDim( "NumberElectricalGenerators" , n_units );
+
+ // the one time series currently being written
+ std::vector< double > buf( time_horizon );
+
+ // units: each one is written (and forgotten) as soon as it is generated,
+ // only its node and its contribution to the dispatchable capacity are kept
+ std::vector< unsigned int > generator_node( n_units );
+ double capacity = 0;
+
+ for( unsigned int i = 0 ; i < n_units ; ++i ) {
+  auto ug = bg.addGroup( "UnitBlock_" + std::to_string( i ) );
+  generator_node[ i ] = uniform_int( 0 , n_nodes - 1 );
+  if( i < n_thermal )
+   capacity += generate_thermal( ug );
+  else if( i < n_thermal + n_hydro )
+   capacity += generate_hydro( ug , buf );
+  else if( i < n_thermal + n_hydro + n_battery )
+   capacity += generate_battery( ug );
+  else
+   generate_intermittent( ug , buf );
+ }
+
+ serialize( bg , "GeneratorNode" , netCDF::NcUint() , NumberGenerators ,
+            generator_node );
+
+ // system demand: a daily profile peaking at load_factor * capacity
+ std::vector< double > demand( time_horizon );
+ double peak = load_factor * capacity;
+ for( unsigned int t = 0 ; t < time_horizon ; ++t )
+  demand[ t ] = peak * ( 0.8 - 0.2 * std::cos( 2 * M_PI *
+                                              ( double( t % 24 ) - 4 ) / 24 ) )
+                     * uniform( 0.97 , 1.0 );
+
+ // node demand: a random share of the system one, written row by row
+ std::vector< double > share( n_nodes );
+ double tot_share = 0;
+ for( auto & s : share )
+  tot_share += ( s = uniform( 0.1 , 1 ) );
+ for( auto & s : share )
+  s /= tot_share;
+
+ auto ActivePowerDemand = add_series( bg , "ActivePowerDemand" ,
+                                     { NumberNodes , TimeHorizon } );
+ for( unsigned int n = 0 ; n < n_nodes ; ++n ) {
+  for( unsigned int t = 0 ; t < time_horizon ; ++t )
+   buf[ t ] = share[ n ] * demand[ t ];
+  ActivePowerDemand.putVar( { n , 0 } , { 1 , time_horizon } , buf.data() );
+ }
+
+ // network: a random spanning tree plus random extra lines
+ if( n_nodes > 1 ) {
+  auto NumberLines = bg.addDim( "NumberLines" , n_lines );
+  std::vector< unsigned int > start( n_lines );
+  std::vector< unsigned int > end( n_lines );
+  std::vector< double > cap( n_lines );
+  std::vector< double > susceptance( n_lines );
+  double base = line_factor * peak / std::sqrt( double( n_nodes ) );
+
+  for( unsigned int l = 0 ; l < n_lines ; ++l ) {
+   if( l < n_nodes - 1 ) {
+    start[ l ] = uniform_int( 0 , l );
+    end[ l ] = l + 1;
+   } else {
+    start[ l ] = uniform_int( 0 , n_nodes - 1 );
+    do
+     end[ l ] = uniform_int( 0 , n_nodes - 1 );
+    while( end[ l ] == start[ l ] );
+   }
+   cap[ l ] = base * uniform( 0.5 , 1.5 );
+   susceptance[ l ] = uniform( 5 , 50 );
+  }
+
+  serialize( bg , "StartLine" , netCDF::NcUint() , NumberLines , start );
+  serialize( bg , "EndLine" , netCDF::NcUint() , NumberLines , end );
+  serialize( bg , "MaxPowerFlow" , netCDF::NcDouble() , NumberLines , cap );
+  for( auto & c : cap )
+   c = -c;
+  serialize( bg , "MinPowerFlow" , netCDF::NcDouble() , NumberLines , cap );
+  serialize( bg , "Susceptance" , netCDF::NcDouble() , NumberLines ,
+             susceptance );
+ }
+
+ // reserve zones: node n belongs to zone n % NumberZones, the requirement
+ // is a fraction of the demand of the nodes in the zone
+ auto add_zones = [ & ]( unsigned int n_zones , const std::string & name ,
+                         double fraction ) {
+  if( ! n_zones )
+   return;
+  auto NumberZones = bg.addDim( "Number" + name + "Zones" , n_zones );
+  std::vector< unsigned int > zone( n_nodes );
+  std::vector< double > zone_share( n_zones , 0 );
+  for( unsigned int n = 0 ; n < n_nodes ; ++n )
+   zone_share[ zone[ n ] = n % n_zones ] += share[ n ];
+
+  serialize( bg , name + "Zones" , netCDF::NcUint() , NumberNodes , zone );
+  auto Demand = add_series( bg , name + "Demand" ,
+                            { NumberZones , TimeHorizon } );
+  for( unsigned int z = 0 ; z < n_zones ; ++z ) {
+   for( unsigned int t = 0 ; t < time_horizon ; ++t )
+    buf[ t ] = fraction * zone_share[ z ] * demand[ t ];
+   Demand.putVar( { z , 0 } , { 1 , time_horizon } , buf.data() );
+  }
+ };
+
+ add_zones( n_primary , "Primary" , 0.02 );
+ add_zones( n_secondary , "Secondary" , 0.05 );
+ add_zones( n_inertia , "Inertia" , 3 );
+
+ if( verbose )
+  std::cout << "TimeHorizon " << time_horizon << "\n"
+            << "Units " << n_units << " (" << n_thermal << " thermal, "
+            << n_hydro << " hydro, " << n_battery << " battery, "
+            << n_intermittent << " intermittent)\n"
+            << "Nodes " << n_nodes << ", lines " << n_lines << "\n"
+            << "Zones " << n_primary << " primary, " << n_secondary
+            << " secondary, " << n_inertia << " inertia\n"
+            << std::fixed << std::setprecision( 2 )
+            << "Dispatchable capacity " << capacity << ", peak demand "
+            << peak << "\n";
+
+ std::cout << "Output written on " << output_path << std::endl;
+ return( 0 );
+}
+
+/*--------------------------------------------------------------------------*/
+/*------------------------ End File ucgenerator.cpp ------------------------*/
+/*--------------------------------------------------------------------------*/